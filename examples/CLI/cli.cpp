@@ -2,24 +2,31 @@
 
 #include <MazeBuilder/args.h>
 #include <MazeBuilder/base64_helper.h>
-#include <MazeBuilder/binary_tree.h>
 #include <MazeBuilder/buildinfo.h>
 #include <MazeBuilder/configurator.h>
-#include <MazeBuilder/dfs.h>
 #include <MazeBuilder/distance_grid.h>
+#include <MazeBuilder/glb_writer.h>
 #include <MazeBuilder/grid_factory.h>
 #include <MazeBuilder/grid_interface.h>
 #include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/io_utils.h>
+#include <MazeBuilder/pixels.h>
+#include <MazeBuilder/ply_writer.h>
+#include <MazeBuilder/png_writer.h>
 #include <MazeBuilder/randomizer.h>
-#include <MazeBuilder/sidewinder.h>
+#include <MazeBuilder/seed_search.h>
 #include <MazeBuilder/stringify.h>
 #include <MazeBuilder/string_utils.h>
 #include <MazeBuilder/objectify.h>
-#include <MazeBuilder/wavefront_object_helper.h>
+#include <MazeBuilder/obj_writer.h>
 
+#include <cstdint>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <optional>
+#include <span>
+#include <sstream>
 #include <stdexcept>
 
 #include "parser.h"
@@ -41,9 +48,13 @@ static std::string get_cli_help_str() {
         "Generates mazes and converts to various formats\n\n" 
         "Example: ./cli -r 10 -c 10 -a binary_tree > maze.txt\n\n" 
         "Example: ./cli --rows=10 --columns=10 --algo=dfs -o maze.obj\n\n" 
+        "Example: ./cli -r 50 -c 50 -a sidewinder -o maze.png\n\n" 
+        "Example: ./cli -r 100 -c 100 -a dfs -o maze.glb\n\n" 
+        "Example: ./cli -r 30 -c 30 -a dfs --search=0:10000 --min-length=400 --matches=5\n\n" 
+        "Example: ./cli -r 1000 -c 1000 -a sidewinder --large --parallel=0 -o maze.png\n\n" 
         "Note: Commands are case-sensitive!\n\n"
         "\t-a, --algo         algorithm to generate maze links\n"
-        "\t                     [binary_tree, dfs, sidewinder]\n" 
+        "\t                     [binary_tree, dfs, ellers, sidewinder]\n" 
         "\t-c, --columns      columns\n" 
         "\t-d, --distances    show distances with optional [start, steps] inclusive\n"
         "\t                     example: '-d [0:10]'\n" 
@@ -52,10 +63,148 @@ static std::string get_cli_help_str() {
         "\t-s, --seed         seed for the number generator\n" 
         "\t-r, --rows         rows\n" 
         "\t-o, --output       output format\n"
-        "\t                     [txt, json, obj, stdout]\n" 
-        "\t-v, --version      display program version\n";
+        "\t                     [txt, json, obj, glb, ply, png, jpeg, stdout]\n" 
+        "\t-v, --version      display program version\n"
+        "\t--parallel=N       carve, render, and write rows on N threads, 0 uses every core\n"
+        "\t--large            lift the size limits, up to 2^31 - 1 cells\n"
+        "\n"
+        "Seed search, prints matching seeds as JSON ranked by score:\n"
+        "\t--search=F:L       search seeds F up to but not including L\n"
+        "\t--min-length=N     shortest solution from the first to the last cell\n"
+        "\t--max-length=N     longest solution\n"
+        "\t--min-dead-ends=R  fewest dead ends per cell, from 0 to 1\n"
+        "\t--max-dead-ends=R  most dead ends per cell\n"
+        "\t--matches=N        stop after N matches, default 10\n";
 }
 
+namespace {
+
+    struct search_request {
+
+        unsigned int first_seed{ 0 };
+
+        unsigned int last_seed{ 0 };
+
+        mazes::seed_search::targets goals{};
+
+        std::size_t matches{ 10 };
+    };
+
+    // Take the seed search options out of the arguments, the rest configure the mazes
+    std::optional<search_request> take_search_args(std::vector<std::string>& args) {
+
+        using namespace std;
+
+        static constexpr auto SEARCH_OPTION = "--search=";
+
+        const auto searching = any_of(args.cbegin(), args.cend(), [](const string& arg) {
+
+            return arg.rfind(SEARCH_OPTION, 0) == 0;
+        });
+
+        if (!searching) {
+
+            return nullopt;
+        }
+
+        search_request request;
+
+        vector<string> rest;
+
+        for (const auto& arg : args) {
+
+            const auto eq = arg.find('=');
+            const auto key = arg.substr(0, eq);
+            const auto value = (eq == string::npos) ? string{} : arg.substr(eq + 1);
+
+            if (key == "--search") {
+
+                const auto colon = value.find(':');
+
+                if (colon == string::npos) {
+
+                    throw invalid_argument("Seed search needs a range like --search=0:1000");
+                }
+
+                request.first_seed = static_cast<unsigned int>(stoul(value.substr(0, colon)));
+                request.last_seed = static_cast<unsigned int>(stoul(value.substr(colon + 1)));
+            } else if (key == "--min-length") {
+
+                request.goals.min_solution_length = stoi(value);
+            } else if (key == "--max-length") {
+
+                request.goals.max_solution_length = stoi(value);
+            } else if (key == "--min-dead-ends") {
+
+                request.goals.min_dead_end_ratio = stod(value);
+            } else if (key == "--max-dead-ends") {
+
+                request.goals.max_dead_end_ratio = stod(value);
+            } else if (key == "--matches") {
+
+                request.matches = static_cast<std::size_t>(stoul(value));
+            } else {
+
+                rest.push_back(arg);
+            }
+        }
+
+        args = std::move(rest);
+
+        return request;
+    }
+
+    // Take the thread and size options out of the arguments, then apply them to the parsed configuration
+    std::function<void(mazes::configurator&)> take_tuning_args(std::vector<std::string>& args) {
+
+        using namespace std;
+
+        optional<unsigned int> parallel_rows;
+
+        bool large_maze{ false };
+
+        vector<string> rest;
+
+        for (const auto& arg : args) {
+
+            const auto eq = arg.find('=');
+            const auto key = arg.substr(0, eq);
+            const auto value = (eq == string::npos) ? string{} : arg.substr(eq + 1);
+
+            if (key == "--parallel") {
+
+                if (value.empty()) {
+
+                    throw invalid_argument("Parallel rows need a thread count like --parallel=4");
+                }
+
+                parallel_rows = static_cast<unsigned int>(stoul(value));
+            } else if (arg == "--large") {
+
+                large_maze = true;
+            } else {
+
+                rest.push_back(arg);
+            }
+        }
+
+        args = std::move(rest);
+
+        return [parallel_rows, large_maze](mazes::configurator& config) {
+
+            if (parallel_rows.has_value()) {
+
+                config.parallel_rows(parallel_rows.value());
+            }
+
+            if (large_maze) {
+
+                config.large_maze(true);
+            }
+        };
+    }
+} // namespace
+
 std::string cli::debug_str = "";
 
 std::string cli::help_str = get_cli_help_str();
@@ -66,6 +215,48 @@ std::string cli::version_str = get_cli_version_str();
 
 std::string cli::convert(std::vector<std::string> const& args_vec) const noexcept {
 
+    std::ostringstream oss;
+
+    try {
+
+        if (write(args_vec, oss, false)) {
+
+            return std::move(oss).str();
+        }
+    } catch (const std::exception& ex) {
+
+#if defined(MAZE_DEBUG)
+
+        std::cerr << "CLI Error: " << ex.what() << std::endl;
+#endif
+    }
+
+    return "";
+} // convert
+
+bool cli::convert_to(std::vector<std::string> const& args_vec, std::ostream& os) const noexcept {
+
+    try {
+
+        return write(args_vec, os, true);
+    } catch (const std::exception& ex) {
+
+#if defined(MAZE_DEBUG)
+
+        std::cerr << "CLI Error: " << ex.what() << std::endl;
+#endif
+    }
+
+    return false;
+} // convert_to
+
+/// @brief Write the output of the arguments
+/// @param args_vec
+/// @param os
+/// @param to_file Write into the file the arguments name, os only takes output without a file name
+/// @return
+bool cli::write(std::vector<std::string> const& args_vec, std::ostream& os, bool to_file) const {
+
     using namespace std;
 
 #if defined(MAZE_DEBUG)
@@ -73,109 +264,209 @@ std::string cli::convert(std::vector<std::string> const& args_vec) const noexcep
     debug_str = version_str + " - DEBUG";
 #endif
 
+    // Text for the terminal ends with a newline, the contents of a file or string are written as they are
+    auto finish_on = [&os, to_file](ostream& out) {
+
+        if (to_file && &out == &os) {
+
+            out << '\n';
+        }
+
+        out.flush();
+
+        return out.good();
+    };
+
     if (args_vec.empty()) {
 
-        return help_str;
+        os << help_str;
+
+        return finish_on(os);
     }
 
-    try {
+    if (auto need_help = find_if(args_vec.cbegin(), args_vec.cend(), [](const std::string& arg) {
 
-        if (auto need_help = find_if(args_vec.cbegin(), args_vec.cend(), [](const std::string& arg) {
+            return arg == mazes::args::HELP_FLAG_STR || arg == mazes::args::HELP_OPTION_STR || arg == mazes::args::HELP_WORD_STR;
+        }); need_help != args_vec.cend()) {
 
-                return arg == mazes::args::HELP_FLAG_STR || arg == mazes::args::HELP_OPTION_STR || arg == mazes::args::HELP_WORD_STR;
-            }); need_help != args_vec.cend()) {
+        os << help_str;
 
-            return help_str;
-        } else if (auto need_version = find_if(args_vec.cbegin(), args_vec.cend(), [](const std::string& arg) {
+        return finish_on(os);
+    } else if (auto need_version = find_if(args_vec.cbegin(), args_vec.cend(), [](const std::string& arg) {
 
-                return arg == mazes::args::VERSION_FLAG_STR || arg == mazes::args::VERSION_OPTION_STR || arg == mazes::args::VERSION_WORD_STR;
-            }); need_version != args_vec.cend()) {
+            return arg == mazes::args::VERSION_FLAG_STR || arg == mazes::args::VERSION_OPTION_STR || arg == mazes::args::VERSION_WORD_STR;
+        }); need_version != args_vec.cend()) {
 
 #if defined(MAZE_DEBUG)
 
-            return debug_str;
+        os << debug_str;
 #else
 
-            return version_str;
+        os << version_str;
 #endif
-        }
 
-        parser my_parser;
+        return finish_on(os);
+    }
+
+    parser my_parser;
+
+    mazes::configurator temp_config;
 
-        mazes::configurator temp_config;
+    auto maze_args = args_vec;
+
+    const auto search = take_search_args(maze_args);
+
+    const auto apply_tuning = take_tuning_args(maze_args);
+
+    if (!my_parser.parse(cref(maze_args), ref(temp_config))) {
+
+        throw std::runtime_error("Failed to parse command line arguments.");
+    }
 
-        if (!my_parser.parse(cref(args_vec), ref(temp_config))) {
+    apply_tuning(temp_config);
 
-            throw std::runtime_error("Failed to parse command line arguments.");
+    // Store the configuration for later access
+    m_config = make_shared<mazes::configurator>(temp_config);
+
+    // Files are opened here and handed to the writers, so images and meshes go to disk as they are encoded
+    ofstream file;
+
+    ostream* out = &os;
+
+    if (to_file && !m_config->output_format_filename().empty() && m_config->output_format_id() != mazes::output_format::STDOUT) {
+
+        const auto format = m_config->output_format_id();
+
+        const bool binary = format == mazes::output_format::PNG || format == mazes::output_format::JPEG || format == mazes::output_format::GLB || format == mazes::output_format::PLY;
+
+        file.open(m_config->output_format_filename(), binary ? ios::out | ios::binary : ios::out);
+
+        if (!file.is_open()) {
+
+            throw std::runtime_error("Failed to open " + m_config->output_format_filename());
         }
 
-        // Store the configuration for later access
-        m_config = make_shared<mazes::configurator>(temp_config);
+        out = &file;
+    }
 
-        mazes::grid_factory factory;
+    // Seed search scores candidates from their links, no maze is rendered
+    if (search.has_value()) {
 
-        factory.register_creator(title_str, [](const mazes::configurator& config) -> std::unique_ptr<mazes::grid_interface> {
+        const mazes::seed_search searcher{ *m_config, 0 };
 
-            return std::make_unique<mazes::distance_grid>(config.rows(), config.columns(), config.levels());
-        });
+        *out << mazes::seed_search::to_json(searcher.run(search->first_seed, search->last_seed, search->goals, search->matches));
 
-        if (auto product = factory.create(title_str, *m_config.get()); product.has_value()) {
+        return finish_on(*out);
+    }
 
-            mazes::randomizer rng;
+    mazes::grid_factory factory;
 
-            apply(product.value(), rng, m_config->algo_id(), *m_config.get());
+    factory.register_creator(title_str, [](const mazes::configurator& config) -> std::unique_ptr<mazes::grid_interface> {
 
-            mazes::stringify maze_stringify;
+        return std::make_unique<mazes::distance_grid>(config.rows(), config.columns(), config.levels());
+    });
 
-            // Check if we need to generate Wavefront OBJ output
-            if (m_config->output_format_id() == mazes::output_format::WAVEFRONT_OBJECT_FILE) {
+    if (auto product = factory.create(title_str, *m_config.get()); product.has_value()) {
 
-                // Execute the stringify algorithm on the grid product
-                if (!maze_stringify.run(product.value().get(), rng)) {
+        // The same seed and settings always give the same bytes
+        mazes::randomizer rng;
 
-                    throw std::runtime_error("Failed to stringify maze for objectify processing.");
-                }
-                
-                // Generate 3D object data
-                mazes::objectify maze_objectify;
-                if (!maze_objectify.run(product.value().get(), rng)) {
+        rng.seed(m_config->seed());
 
-                    throw std::runtime_error("Failed to generate 3D object data.");
-                }
+        apply(product.value(), rng, m_config->algo_id(), *m_config.get());
+
+        // Images are rasterized from the links, then encoded into the output
+        if (m_config->output_format_id() == mazes::output_format::PNG || m_config->output_format_id() == mazes::output_format::JPEG) {
+
+            mazes::pixels maze_pixels;
 
-                // Convert to Wavefront OBJ format
-                mazes::wavefront_object_helper obj_helper;
-                auto vertices = product.value()->operations().get_vertices();
-                auto faces = product.value()->operations().get_faces();
+            const auto w = static_cast<unsigned int>(maze_pixels.width(m_config->columns()));
+            const auto h = static_cast<unsigned int>(maze_pixels.height(m_config->rows()));
 
-                if (!obj_helper.run(product.value().get(), std::ref(rng))) {
+            if (m_config->output_format_id() == mazes::output_format::PNG) {
 
-                    throw std::runtime_error("Failed to generate Wavefront OBJ data.");
+                // Scanlines are compressed as they are rasterized, and each batch of bands is written out before the next
+                mazes::png_writer writer{*out, w, h, mazes::pixels::CHANNELS, m_config->parallel_rows().value_or(1)};
+
+                if (!maze_pixels.run(product.value().get(), [&writer](std::span<const std::uint8_t> scanline) { return writer.write_row(scanline); }) || !writer.finish()) {
+
+                    throw std::runtime_error("Failed to encode maze image.");
                 }
             } else {
 
-                // Use the regular stringify process
-                mazes::stringify maze_stringify;
-                
-                if (!maze_stringify.run(product.value().get(), rng)) {
+                std::vector<std::uint8_t> rgba;
+
+                if (!maze_pixels.run(product.value().get(), rgba)) {
+
+                    throw std::runtime_error("Failed to rasterize maze.");
+                }
+
+                const auto encoded = mazes::io_utils{}.encode_jpeg(rgba, w, h, mazes::pixels::CHANNELS);
+
+                if (encoded.empty()) {
 
-                    throw std::runtime_error("Failed to stringify maze.");
+                    throw std::runtime_error("Failed to encode maze image.");
                 }
+
+                *out << encoded;
             }
 
-            return product.value()->operations().get_str();
+            return finish_on(*out);
         }
 
-    } catch (const std::exception& ex) {
+        // 3D formats are written from a mesh of the walls
+        const auto format = m_config->output_format_id();
 
-#if defined(MAZE_DEBUG)
+        if (format == mazes::output_format::WAVEFRONT_OBJECT_FILE || format == mazes::output_format::GLB || format == mazes::output_format::PLY) {
 
-        std::cerr << "CLI Error: " << ex.what() << std::endl;
-#endif
+            // Generate 3D object data straight from the links
+            mazes::objectify maze_objectify;
+            if (!maze_objectify.run(product.value().get(), rng)) {
+
+                throw std::runtime_error("Failed to generate 3D object data.");
+            }
+
+            const auto& maze_mesh = product.value()->operations().get_mesh();
+
+            // Write the mesh straight into the output, it never passes through the grid string
+            bool written{ false };
+
+            if (format == mazes::output_format::GLB) {
+
+                written = mazes::glb_writer{ *out }.write(maze_mesh);
+            } else if (format == mazes::output_format::PLY) {
+
+                written = mazes::ply_writer{ *out }.write(maze_mesh);
+            } else {
+
+                // Chunks of OBJ text go out to the file as soon as they are formatted
+                written = mazes::obj_writer{ *out, m_config->parallel_rows().value_or(1) }.write(maze_mesh);
+            }
+
+            if (!written) {
+
+                throw std::runtime_error("Failed to write 3D object data.");
+            }
+
+            return finish_on(*out);
+        } else {
+
+            // Use the regular stringify process
+            const auto maze_stringify = m_config->parallel_rows().has_value() ? mazes::stringify{ m_config->parallel_rows().value() } : mazes::stringify{};
+            
+            if (!maze_stringify.run(product.value().get(), rng)) {
+
+                throw std::runtime_error("Failed to stringify maze.");
+            }
+        }
+
+        *out << product.value()->operations().get_str();
+
+        return finish_on(*out);
     }
 
-    return "";
-} // convert
+    return false;
+} // write
 
 std::string cli::convert_as_base64(std::vector<std::string> const& args_vec) const noexcept {
 
@@ -210,38 +501,15 @@ void cli::apply(std::unique_ptr<mazes::grid_interface> const& g, mazes::randomiz
 
     try {
 
-        bool success = false;
-
-        switch (a) {
-
-        case mazes::algo::BINARY_TREE: {
-
-            static mazes::binary_tree bt;
+        // Algorithms are made the same way create and seed search make them, so a seed gives the same maze everywhere
+        auto algo_runner = mazes::configurator::make_algo_from_config(config);
 
-            success = bt.run(g.get(), ref(rng));
+        if (!algo_runner.has_value()) {
 
-            break;
-        }
-        case mazes::algo::SIDEWINDER: {
-
-            static mazes::sidewinder sw;
-
-            success = sw.run(g.get(), ref(rng));
-
-            break;
-        }
-        case mazes::algo::DFS: {
-
-            static mazes::dfs d;
-
-            success = d.run(g.get(), ref(rng));
-
-            break;
+            throw std::invalid_argument("Unsupported algorithm: " + std::string{mazes::to_sv_from_algo(a)});
         }
-        default:
 
-            throw std::invalid_argument("Unsupported algorithm: " + std::string{mazes::to_sv_from_algo(a)});
-        } // switch
+        const bool success = algo_runner.value()->run(g.get(), ref(rng));
 
         if (!success) {
 
@@ -268,6 +536,7 @@ void cli::apply(std::unique_ptr<mazes::grid_interface> const& g, mazes::randomiz
                 start_idx = std::max(0, std::min(start_idx, max_cell_index));
                 end_idx = std::max(0, std::min(end_idx, max_cell_index));
 
+                distance_grid_ptr->set_distance_threads(config.parallel_rows().value_or(1));
                 distance_grid_ptr->calculate_distances(start_idx, end_idx);
 
 #if defined(MAZE_DEBUG)
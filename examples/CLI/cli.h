@@ -7,6 +7,7 @@
 #define CLI_H
 
 #include <memory>
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -27,6 +28,13 @@ public:
 
     std::string convert(std::vector<std::string> const& args_vec) const noexcept;
 
+    /// @brief Convert and write the output into the file the arguments name, or into a stream when they name none
+    /// @details Images and meshes are encoded straight into the file, they are never held as a whole
+    /// @param args_vec
+    /// @param os Stream for output without a file name, such as std::cout
+    /// @return False when nothing could be written
+    bool convert_to(std::vector<std::string> const& args_vec, std::ostream& os) const noexcept;
+
     std::string convert_as_base64(std::vector<std::string> const& args_vec) const noexcept;
 
     std::string help() const noexcept;
@@ -39,6 +47,8 @@ public:
     
 private:
 
+    bool write(std::vector<std::string> const& args_vec, std::ostream& os, bool to_file) const;
+
     void apply(std::unique_ptr<mazes::grid_interface> const& g, mazes::randomizer& rng, mazes::algo a, const mazes::configurator& config) const noexcept;
 
     static std::string debug_str;
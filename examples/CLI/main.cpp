@@ -12,9 +12,6 @@
 #include <vector>
 
 #include <MazeBuilder/configurator.h>
-#include <MazeBuilder/enums.h>
-#include <MazeBuilder/io_utils.h>
-#include <MazeBuilder//string_utils.h>
 
 #include "cli.h"
 
@@ -57,40 +54,8 @@ int main(int argc, char* argv[]) {
 
         cli my_cli;
 
-        if (auto str = my_cli.convert(cref(args_vec)); !str.empty()) {
-
-            if (auto config = my_cli.get_config(); config != nullptr) {
-
-                mazes::io_utils writer{};
-
-                bool write_success{ false };
-
-                // Check if we have a specific output filename
-                if (auto filename = config->output_format_filename(); !filename.empty()) {
-
-                    if (mazes::to_output_format_from_sv(mazes::string_utils::get_file_extension(filename)) == mazes::output_format::STDOUT) {
-
-                        // Write to stdout
-                        write_success = writer.write(cout, str);
-                    } else {
-
-                        // Write to file
-                        write_success = writer.write_file(config->output_format_filename(), str);
-                    }
-                } else {
-
-                    write_success = writer.write(cout, str);
-                }
-
-                if (!write_success) {
-
-                    throw runtime_error("Failed to write output.");
-                }
-            } else {
-
-                throw logic_error(str);
-            }
-        } else {
+        // Files are written as they are encoded, everything else goes to the terminal
+        if (!my_cli.convert_to(cref(args_vec), cout)) {
 
             throw runtime_error(my_cli.help());
         }
@@ -0,0 +1,81 @@
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mazes
+{
+
+    class grid_operations;
+
+    /// @file analytics.h
+    /// @struct analytics
+    /// @brief Statistics of a generated maze, to score its difficulty
+    /// @details Degrees come from one pass over the link masks, popcounts of eight cells at a time
+    /// @details Corridors and straight runs come from a second pass, the diameter and path lengths from two breadth-first searches
+    /// @details Path statistics cover the cells connected to the first cell, and are exact on perfect mazes, where paths are unique
+    struct analytics final
+    {
+        /// @brief Number of cells in the grid
+        std::size_t cells{0};
+
+        /// @brief Number of open passages, each counted once
+        std::size_t passages{0};
+
+        /// @brief Number of cells by the number of their open passages
+        std::array<std::size_t, 7> degree_histogram{};
+
+        /// @brief Cells with one passage
+        std::size_t dead_ends{0};
+
+        /// @brief Cells with two passages
+        std::size_t corridors{0};
+
+        /// @brief Corridors that run straight through, the rest are turns
+        std::size_t straight_corridors{0};
+
+        /// @brief Cells with three or more passages
+        std::size_t junctions{0};
+
+        /// @brief Fraction of open cells that are corridors, high when the maze flows in long passages
+        double river_factor{0.0};
+
+        /// @brief Runs of passages along one axis without a turn
+        std::size_t straight_runs{0};
+
+        /// @brief Mean number of passages in a straight run
+        double mean_straight_run{0.0};
+
+        /// @brief Passages in the longest straight run
+        std::size_t longest_straight_run{0};
+
+        /// @brief Cells connected to the first cell
+        std::size_t reachable{0};
+
+        /// @brief Length of the longest shortest path
+        std::int32_t diameter{0};
+
+        /// @brief Ends of the longest shortest path
+        std::int32_t diameter_start{0};
+
+        std::int32_t diameter_end{0};
+
+        /// @brief Mean distance over every pair of connected cells
+        double mean_path_length{0.0};
+
+        /// @brief Compute the statistics of a maze
+        /// @param ops The grid, after a maze has been generated
+        /// @return
+        static analytics from(const grid_operations &ops);
+
+        /// @brief Get the statistics as a JSON object
+        /// @param pretty_print Number of spaces to use for indenting the JSON string
+        /// @return
+        std::string to_json(int pretty_print = 4) const;
+    };
+} // namespace mazes
+
+#endif // ANALYTICS_H
@@ -3,6 +3,8 @@
 
 #include <MazeBuilder/algo_interface.h>
 
+#include <optional>
+
 namespace mazes
 {
 
@@ -16,6 +18,15 @@ namespace mazes
     {
 
     public:
+        /// @brief Construct the serial algorithm, drawing every choice from the randomizer
+        binary_tree() noexcept = default;
+
+        /// @brief Construct the row-parallel algorithm
+        /// @details Each row draws from its own stream keyed by (seed, level, row), the seed being drawn once from the randomizer
+        /// @details The maze is the same for any thread count
+        /// @param threads Number of threads to split rows across, 0 uses the hardware concurrency
+        explicit binary_tree(unsigned int threads) noexcept;
+
         /// @brief Run the binary tree algorithm
         /// @param g
         /// @param rng
@@ -23,6 +34,8 @@ namespace mazes
         bool run(grid_interface *g, randomizer &rng) const noexcept override;
 
     private:
+        // Set when rows are carved in parallel
+        std::optional<unsigned int> m_threads;
     };
 }
 #endif // BINARY_TREE_H
@@ -3,18 +3,18 @@
 
 #include <cstdint>
 #include <memory>
-#include <shared_mutex>
-#include <unordered_map>
 #include <vector>
 
-#include <MazeBuilder/hash_funcs.h>
-
 namespace mazes
 {
 
+    class grid_operations;
+
     /// @file cell.h
     /// @class cell
     /// @brief Cell class with links to other cells
+    /// @details A cell attached to a grid keeps its links in the grid's link masks
+    /// @details Links that the masks cannot express, like those between detached cells, are kept by the cell
     class cell final
     {
     public:
@@ -22,6 +22,11 @@ namespace mazes
         /// @param index The index to initialize the cell with. Defaults to 0.
         explicit cell(std::int32_t index = 0);
 
+        /// @brief Constructs a cell attached to the grid that owns it
+        /// @param index The index of the cell in the grid
+        /// @param owner The grid holding the link masks for this cell
+        cell(std::int32_t index, grid_operations *owner);
+
         /// @brief Destroys the cell object and releases any associated resources.
         ~cell();
 
@@ -71,24 +76,24 @@ namespace mazes
         /// @brief Cleans up or removes links, typically as part of a resource management or shutdown process.
         void cleanup_links();
 
-    private:
-        /// @brief Equals function for weak pointers to cell objects.
-        struct weak_ptr_equal
-        {
-
-            template <typename T>
-            bool operator()(const std::weak_ptr<T> &lhs, const std::weak_ptr<T> &rhs) const
-            {
+        /// @brief Get the grid whose link masks hold this cell's links
+        /// @return The owner, or nullptr when the cell is detached
+        grid_operations *get_owner() const noexcept;
 
-                return !lhs.owner_before(rhs) && !rhs.owner_before(lhs);
-            }
-        };
+        /// @brief Attach the cell to a grid, or detach it with nullptr
+        /// @param owner
+        void set_owner(grid_operations *owner) noexcept;
 
-        bool has_key(const std::shared_ptr<cell> &c);
+    private:
+        /// @brief Find the direction of a cell within the same grid
+        /// @param other
+        /// @return The direction as an int, or -1 when the masks cannot hold the link
+        int direction_to(const std::shared_ptr<cell> &other) const noexcept;
 
-        std::unordered_map<std::weak_ptr<cell>, bool, weak_ptr_hash, weak_ptr_equal> m_links;
+        // Fallback for links that are not between adjacent cells of one grid
+        std::vector<std::weak_ptr<cell>> m_links;
 
-        mutable std::shared_mutex m_links_mutex;
+        grid_operations *m_owner;
 
         std::int32_t m_index;
     };
@@ -3,6 +3,9 @@
 
 #include <MazeBuilder/grid_interface.h>
 
+#include <cstdint>
+#include <vector>
+
 namespace mazes
 {
 
@@ -10,6 +13,10 @@ namespace mazes
     class distances;
     class grid_operations;
 
+    /// @file colored_grid.h
+    /// @class colored_grid
+    /// @brief A grid whose cells are colored by their distance from a root cell
+    /// @details Distances come from one breadth-first search, so coloring is linear in the number of cells
     class colored_grid : public grid_interface
     {
 
@@ -38,15 +45,42 @@ namespace mazes
         /// @return An 32-bit unsigned integer containing the background color
         virtual std::uint32_t background_color_for(const std::shared_ptr<cell> &c) const noexcept override;
 
+        /// @brief Get the distance of a cell from the root as text, without creating the cell
+        /// @param index
+        /// @return
+        virtual std::string contents_at(int index) const noexcept override;
+
+        /// @brief Cells show their distance once distances are calculated
+        /// @return
+        virtual bool has_contents() const noexcept override;
+
+        /// @brief Get the color of a cell on the distance ramp, without creating the cell
+        /// @param index
+        /// @return The color as 0xRRGGBB
+        virtual std::uint32_t background_color_at(int index) const noexcept override;
+
+        /// @brief Cells are colored once distances are calculated
+        /// @return
+        virtual bool has_background_colors() const noexcept override;
+
         // Delegate to embedded grid
         grid_operations &operations() noexcept override;
 
         const grid_operations &operations() const noexcept override;
 
+        /// @brief Compute the distance of every cell from the root, call again after the links change
+        /// @param root_index
+        void calculate_distances(int root_index = 0) noexcept;
+
+        /// @brief Get the distance of every cell from the root, -1 for cells that cannot be reached
+        /// @return Empty until distances are calculated
+        const std::vector<std::int32_t> &get_distances() const noexcept { return m_distances; }
+
     private:
-        std::shared_ptr<distances> m_distances;
+        std::vector<std::int32_t> m_distances;
+
+        int m_max_distance;
 
-        // Change from grid_interface to grid since we need grid's implementation of operations()
         std::unique_ptr<grid_interface> m_grid;
     };
 
@@ -1,6 +1,7 @@
 #ifndef CONFIGURATOR_H
 #define CONFIGURATOR_H
 
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -8,6 +9,7 @@
 
 #include <MazeBuilder/binary_tree.h>
 #include <MazeBuilder/dfs.h>
+#include <MazeBuilder/ellers.h>
 #include <MazeBuilder/enums.h>
 #include <MazeBuilder/sidewinder.h>
 
@@ -51,41 +53,61 @@ namespace mazes
 
         static constexpr auto MAX_LEVELS = 10u;
 
+        static constexpr auto DEFAULT_LARGE_MAZE = false;
+
+        /// @brief Upper bound on total cells in large-maze mode, cell indices are 32-bit
+        static constexpr auto MAX_LARGE_CELLS = static_cast<size_t>(std::numeric_limits<std::int32_t>::max());
+
         /// @brief Set the number of rows
         /// @param rows The number of rows (must be > 0, will be clamped to reasonable limits)
         /// @return A reference to this configurator
-        /// @warning Values be clamped to prevent memory issues
+        /// @warning Values are clamped to MAX_ROWS unless large-maze mode is enabled
         configurator &rows(unsigned int rows) noexcept
         {
-            // Clamp to reasonable limits to prevent infinite loops and memory issues
-            m_rows = (rows == 0) ? 1 : (rows > MAX_ROWS) ? MAX_ROWS
-                                                         : rows;
+            m_rows = (rows == 0) ? 1 : rows;
             return *this;
         }
 
         /// @brief Set the number of columns
         /// @param columns The number of columns (must be > 0, will be clamped to reasonable limits)
         /// @return A reference to this configurator
-        /// @warning Values will be clamped to prevent memory issues
+        /// @warning Values are clamped to MAX_COLUMNS unless large-maze mode is enabled
         configurator &columns(unsigned int columns) noexcept
         {
-            // Clamp to reasonable limits to prevent infinite loops and memory issues
-            m_columns = (columns == 0) ? 1 : (columns > MAX_COLUMNS) ? MAX_COLUMNS
-                                                                     : columns;
+            m_columns = (columns == 0) ? 1 : columns;
             return *this;
         }
 
         /// @brief Set the number of levels
         /// @param levels The number of levels (must be > 0, will be clamped to reasonable limits)
         /// @return A reference to this configurator
-        /// @warning Values will be clamped to prevent memory issues
+        /// @warning Values are clamped to MAX_LEVELS unless large-maze mode is enabled
         /// @note Most mazes are 2D (levels=1), 3D mazes should use moderate level counts
         configurator &levels(unsigned int levels) noexcept
         {
-            // Clamp to reasonable limits to prevent infinite loops and memory issues
-            // Levels are more memory-intensive than rows/columns, so lower limit
-            m_levels = (levels == 0) ? 1 : (levels > MAX_LEVELS) ? MAX_LEVELS
-                                                                 : levels;
+            m_levels = (levels == 0) ? 1 : levels;
+            return *this;
+        }
+
+        /// @brief Enable or disable large-maze mode
+        /// @param large_maze When true, dimensions are only bounded by MAX_LARGE_CELLS
+        /// @return A reference to this configurator
+        /// @details Large mazes use the flat grid backend, so memory grows by a few bytes per cell
+        configurator &large_maze(bool large_maze) noexcept
+        {
+            m_large_maze = large_maze;
+            return *this;
+        }
+
+        /// @brief Carve and render rows in parallel, carving with per-row random streams
+        /// @param threads Number of threads, 0 uses the hardware concurrency
+        /// @return A reference to this configurator
+        /// @details Only binary_tree and sidewinder carve rows independently, other algorithms ignore this
+        /// @details Text output of every algorithm is rendered in bands of rows on these threads
+        /// @details The maze depends on the seed but not on the thread count
+        configurator &parallel_rows(unsigned int threads) noexcept
+        {
+            m_parallel_rows = threads;
             return *this;
         }
 
@@ -108,7 +130,7 @@ namespace mazes
         }
 
         /// @brief Set the random seed
-        /// @param seed The random seed (0 = use random seed)
+        /// @param seed The random seed, the same seed and settings always build the same maze
         /// @return A reference to this configurator
         configurator &seed(unsigned int seed) noexcept
         {
@@ -163,15 +185,23 @@ namespace mazes
 
         /// @brief Get the number of rows
         /// @return The number of rows (guaranteed to be > 0)
-        unsigned int rows() const noexcept { return m_rows.value_or(DEFAULT_ROWS); }
+        unsigned int rows() const noexcept { return clamp_dimension(m_rows.value_or(DEFAULT_ROWS), MAX_ROWS); }
 
         /// @brief Get the number of columns
         /// @return The number of columns (guaranteed to be > 0)
-        unsigned int columns() const noexcept { return m_columns.value_or(DEFAULT_COLUMNS); }
+        unsigned int columns() const noexcept { return clamp_dimension(m_columns.value_or(DEFAULT_COLUMNS), MAX_COLUMNS); }
 
         /// @brief Get the number of levels
         /// @return The number of levels (guaranteed to be > 0)
-        unsigned int levels() const noexcept { return m_levels.value_or(DEFAULT_LEVELS); }
+        unsigned int levels() const noexcept { return clamp_dimension(m_levels.value_or(DEFAULT_LEVELS), MAX_LEVELS); }
+
+        /// @brief Check if large-maze mode is enabled
+        /// @return True when the MAX_ROWS, MAX_COLUMNS, and MAX_LEVELS limits are lifted
+        bool large_maze() const noexcept { return m_large_maze.value_or(DEFAULT_LARGE_MAZE); }
+
+        /// @brief Get the number of threads for row-parallel generation
+        /// @return The thread count, or nullopt when rows are carved serially
+        std::optional<unsigned int> parallel_rows() const noexcept { return m_parallel_rows; }
 
         /// @brief Get the maze generation algorithm
         /// @return The algorithm used for maze generation
@@ -218,17 +248,9 @@ namespace mazes
                 return false;
             }
 
-            // Check for excessive dimensions (would cause memory exhaustion)
-            if (m_rows.value() > MAX_ROWS || m_columns.value() > MAX_COLUMNS || m_levels.value() > MAX_LEVELS)
-            {
-
-                return false;
-            }
-
-            // Check for potential overflow in total cell calculation
-            constexpr auto max_cells = std::numeric_limits<size_t>::max() / sizeof(void *);
-
-            if (static_cast<size_t>(m_rows.value()) * m_columns.value() * m_levels.value() > max_cells)
+            // Dimensions are clamped by the getters unless large-maze mode is on
+            // Check for overflow in total cell calculation, every cell needs a 32-bit index
+            if (static_cast<size_t>(rows()) * columns() * levels() > MAX_LARGE_CELLS)
             {
                 // Potential overflow detected
                 return false;
@@ -250,18 +272,32 @@ namespace mazes
             else if (config.algo_id() == algo::BINARY_TREE)
             {
 
-                return std::make_optional(std::make_unique<binary_tree>());
+                return std::make_optional(config.parallel_rows().has_value() ? std::make_unique<binary_tree>(config.parallel_rows().value()) : std::make_unique<binary_tree>());
             }
             else if (config.algo_id() == algo::SIDEWINDER)
             {
 
-                return std::make_optional(std::make_unique<sidewinder>());
+                return std::make_optional(config.parallel_rows().has_value() ? std::make_unique<sidewinder>(config.parallel_rows().value()) : std::make_unique<sidewinder>());
+            }
+            else if (config.algo_id() == algo::ELLERS)
+            {
+
+                return std::make_optional(std::make_unique<ellers>());
             }
 
             return std::nullopt;
         }
 
     private:
+        /// @brief Apply a dimension limit unless large-maze mode lifts it
+        /// @param value
+        /// @param limit
+        /// @return
+        unsigned int clamp_dimension(unsigned int value, unsigned int limit) const noexcept
+        {
+            return (!large_maze() && value > limit) ? limit : value;
+        }
+
         std::optional<unsigned int> m_rows;
 
         std::optional<unsigned int> m_columns;
@@ -283,6 +319,10 @@ namespace mazes
         std::optional<output_format> m_output_format_id;
 
         std::optional<std::string> m_output_format_filename;
+
+        std::optional<bool> m_large_maze;
+
+        std::optional<unsigned int> m_parallel_rows;
     };
 
 } // namespace
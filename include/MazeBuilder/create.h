@@ -8,7 +8,7 @@
 #include <vector>
 
 #include <MazeBuilder/configurator.h>
-#include <MazeBuilder/grid.h>
+#include <MazeBuilder/flat_grid.h>
 #include <MazeBuilder/grid_factory.h>
 #include <MazeBuilder/grid_interface.h>
 #include <MazeBuilder/maze_factory.h>
@@ -31,7 +31,7 @@ namespace mazes
         {
             auto grid_creator = [](const configurator &config) -> std::unique_ptr<grid_interface>
             {
-                return std::make_unique<grid>(config.rows(), config.columns(), config.levels());
+                return std::make_unique<flat_grid>(config.rows(), config.columns(), config.levels());
             };
 
             auto maze_creator = [grid_creator](const configurator &config) -> std::unique_ptr<maze_interface>
@@ -62,7 +62,7 @@ namespace mazes
 
                         if (auto success = algo_runner.value()->run(igridimpl.get(), std::ref(rng)))
                         {
-                            thread_local stringify _stringifier;
+                            const auto _stringifier = config.parallel_rows().has_value() ? stringify{config.parallel_rows().value()} : stringify{};
 
                             _stringifier.run(igridimpl.get(), std::ref(rng));
 
@@ -4,10 +4,14 @@
 #include <MazeBuilder/configurator.h>
 #include <MazeBuilder/create.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
 #include <deque>
+#include <exception>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <sstream>
 #include <string>
 #include <thread>
 #include <vector>
@@ -19,207 +23,238 @@ namespace mazes
     /// @namespace detail
     namespace detail
     {
-        /// @brief A worker class for concurrent maze generation
-        class worker_concurrent
+        /// @brief A pool of threads that run batches of tasks with work stealing
+        /// @details Tasks of a batch are dealt round-robin into one deque per worker
+        /// @details A worker takes from the back of its own deque, and steals from the front of the others once it runs dry
+        /// @details A few large tasks therefore never hold up the small tasks queued behind them
+        class work_stealing_executor
         {
         private:
-            /// @brief A work item for maze generation
-            struct work_item
+            /// @brief A task index and the batch it belongs to
+            struct task_entry
             {
-                unsigned int id;
+                std::size_t generation;
 
-                std::string work_str; // This will store the result of create() calls
-
-                std::vector<configurator> configs; // Store the configs assigned to this worker
+                std::size_t index;
+            };
 
-                int start, count;
+            /// @brief Tasks of one worker
+            struct task_queue
+            {
+                std::mutex mtx;
 
-                work_item(unsigned int id, std::vector<configurator> configs, int start, int count)
-                    : id{id}, work_str{}, configs(std::move(configs)), start{start}, count{count}
-                {
-                }
+                std::deque<task_entry> tasks;
             };
 
-            std::condition_variable work_cond;
+            std::vector<std::unique_ptr<task_queue>> queues;
 
-            std::mutex work_mtx;
+            std::vector<std::thread> workers;
 
-            std::atomic<int> pending_work_count;
+            // Guards the batch, the generation, and the exit flag, it is always taken before a queue lock
+            std::mutex batch_mtx;
 
-            std::atomic<bool> should_exit;
+            std::condition_variable batch_cond;
 
-            std::deque<work_item> work_queue;
+            std::condition_variable done_cond;
 
-            std::vector<std::thread> workers;
+            // Batches run one at a time
+            std::mutex run_mtx;
 
-            std::string *target_str_ptr; // Pointer to the target string
+            std::function<void(std::size_t)> task;
 
-            std::mutex target_str_mutex; // Mutex to protect target_str access
+            std::size_t generation;
 
-        public:
-            // Add constructor and destructor
-            worker_concurrent() : should_exit(false), pending_work_count(0), target_str_ptr(nullptr) {}
+            std::size_t remaining;
 
-            ~worker_concurrent()
-            {
+            bool should_exit;
 
-                cleanup();
-            }
+            std::exception_ptr first_error;
 
-            // Initialize worker threads
-            void initThreads() noexcept
+            /// @brief Take a task of the batch a worker is running
+            /// @details Tasks of a later batch are left alone, a worker finishing the last batch must not run them with its old task
+            bool take(std::size_t self, std::size_t generation_seen, std::size_t &index) noexcept
             {
-
-                using namespace std;
-
-                auto thread_func = [](worker_concurrent *worker_ptr)
                 {
-                    while (!worker_ptr->should_exit.load())
-                    {
-                        unique_lock<mutex> lock(worker_ptr->work_mtx);
-
-                        worker_ptr->work_cond.wait(lock, [worker_ptr]
-                                                   { return worker_ptr->should_exit.load() || !worker_ptr->work_queue.empty(); });
-
-                        if (worker_ptr->should_exit.load())
-                        {
-
-                            break;
-                        }
-
-                        // Ready to do work
-                        if (!worker_ptr->work_queue.empty())
-                        {
-
-                            auto temp_worker = std::move(worker_ptr->work_queue.front());
+                    std::lock_guard<std::mutex> lock(queues[self]->mtx);
 
-                            worker_ptr->work_queue.pop_front();
-
-                            lock.unlock();
-
-                            worker_ptr->do_work(temp_worker);
+                    if (!queues[self]->tasks.empty() && queues[self]->tasks.back().generation == generation_seen)
+                    {
+                        index = queues[self]->tasks.back().index;
+                        queues[self]->tasks.pop_back();
 
-                            lock.lock();
+                        return true;
+                    }
+                }
 
-                            if (--worker_ptr->pending_work_count <= 0)
-                            {
-                                worker_ptr->work_cond.notify_one();
-                            }
-                        }
-                    } // while
-                }; // lambda
+                // Steal from the others, starting with the next worker
+                for (std::size_t k = 1; k < queues.size(); ++k)
+                {
+                    auto &victim = *queues[(self + k) % queues.size()];
 
-                static constexpr auto NUM_WORKERS = 4;
+                    std::lock_guard<std::mutex> lock(victim.mtx);
 
-                // Create worker threads
-                for (auto w{0}; w < NUM_WORKERS; w++)
-                {
+                    if (!victim.tasks.empty() && victim.tasks.front().generation == generation_seen)
+                    {
+                        index = victim.tasks.front().index;
+                        victim.tasks.pop_front();
 
-                    workers.emplace_back(thread_func, this);
+                        return true;
+                    }
                 }
+
+                return false;
             }
 
-            void generate(const std::vector<configurator> &configs, std::string &target_str) noexcept
+            void work(std::size_t self) noexcept
             {
-                using namespace std;
+                std::size_t seen = 0;
 
-                // Set the target string pointer
-                target_str_ptr = &target_str;
+                std::function<void(std::size_t)> current;
 
+                while (true)
                 {
-                    unique_lock<std::mutex> lock(this->work_mtx);
+                    {
+                        std::unique_lock<std::mutex> lock(batch_mtx);
 
-                    work_queue.clear();
+                        batch_cond.wait(lock, [this, seen]
+                                        { return should_exit || generation != seen; });
 
-                    static constexpr auto BLOCK_COUNT = 4;
+                        if (should_exit)
+                        {
+                            return;
+                        }
 
-                    size_t items_per_worker = configs.size() / BLOCK_COUNT;
-                    size_t remaining_items = configs.size() % BLOCK_COUNT;
+                        seen = generation;
+                        current = task;
+                    }
 
-                    size_t current_index = 0;
+                    std::size_t index = 0;
 
-                    for (auto w{0}; w < BLOCK_COUNT; w++)
+                    while (take(self, seen, index))
                     {
-                        size_t start_index = current_index;
-
-                        // Distribute items evenly, with remainder distributed to first workers
-                        size_t count = items_per_worker + (w < remaining_items ? 1 : 0);
-
-                        if (count > 0)
+                        try
+                        {
+                            current(index);
+                        }
+                        catch (...)
                         {
-                            // Extract configs for this worker
-                            std::vector<configurator> worker_configs;
-                            for (size_t i = start_index; i < start_index + count && i < configs.size(); ++i)
+                            std::lock_guard<std::mutex> lock(batch_mtx);
+
+                            if (!first_error)
                             {
-                                worker_configs.push_back(configs[i]);
+                                first_error = std::current_exception();
                             }
-
-                            work_queue.emplace_back(static_cast<unsigned int>(w), std::move(worker_configs), static_cast<int>(start_index), static_cast<int>(count));
                         }
 
-                        current_index += count;
+                        std::lock_guard<std::mutex> lock(batch_mtx);
+
+                        if (--remaining == 0)
+                        {
+                            done_cond.notify_all();
+                        }
                     }
 
-                    this->pending_work_count.store(static_cast<int>(work_queue.size()));
+                    current = nullptr;
                 }
-
-                this->work_cond.notify_all();
-            } // generate
-
-            void wait_for_completion() noexcept
-            {
-                using namespace std;
-
-                unique_lock<mutex> lock(work_mtx);
-                work_cond.wait(lock, [&]
-                               { return pending_work_count.load() <= 0; });
             }
 
-            void do_work(work_item &item) noexcept
+        public:
+            /// @brief Start the workers
+            /// @param threads Number of workers, 0 uses the hardware concurrency
+            explicit work_stealing_executor(unsigned int threads = 0)
+                : generation{0}, remaining{0}, should_exit{false}
             {
-                using namespace std;
+                const auto count = (threads == 0) ? std::max(1u, std::thread::hardware_concurrency()) : threads;
 
-                for (const auto &config : item.configs)
+                for (auto w{0u}; w < count; ++w)
                 {
-                    item.work_str += create(config);
+                    queues.push_back(std::make_unique<task_queue>());
                 }
 
-                // Append the worker's result to the shared target string
-                if (target_str_ptr && !item.work_str.empty())
+                for (auto w{0u}; w < count; ++w)
                 {
-                    lock_guard<mutex> lock(target_str_mutex);
-                    *target_str_ptr += item.work_str;
+                    workers.emplace_back([this, w]()
+                                         { work(w); });
                 }
             }
 
-            void cleanup() noexcept
+            work_stealing_executor(const work_stealing_executor &) = delete;
+
+            work_stealing_executor &operator=(const work_stealing_executor &) = delete;
+
+            ~work_stealing_executor()
             {
                 {
-                    std::lock_guard<std::mutex> lock(work_mtx);
+                    std::lock_guard<std::mutex> lock(batch_mtx);
 
                     should_exit = true;
-
-                    pending_work_count = 0;
                 }
 
-                work_cond.notify_all();
+                batch_cond.notify_all();
 
                 for (auto &t : workers)
                 {
-
                     if (t.joinable())
                     {
-
                         t.join();
                     }
                 }
+            }
+
+            /// @brief Get the number of workers
+            /// @return
+            std::size_t size() const noexcept { return workers.size(); }
 
-                workers.clear();
+            /// @brief Run task(i) for every i below count, and wait for all of them
+            /// @param count
+            /// @param fn
+            /// @details The first exception thrown by a task is rethrown once the batch is done
+            void run(std::size_t count, std::function<void(std::size_t)> fn)
+            {
+                if (count == 0)
+                {
+                    return;
+                }
+
+                std::lock_guard<std::mutex> run_lock(run_mtx);
+
+                // The batch is published with its tasks, no worker sees the new generation before both are in place
+                std::unique_lock<std::mutex> lock(batch_mtx);
+
+                task = std::move(fn);
+                remaining = count;
+                first_error = nullptr;
+                ++generation;
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    auto &q = *queues[i % queues.size()];
+
+                    std::lock_guard<std::mutex> queue_lock(q.mtx);
+
+                    q.tasks.push_front(task_entry{generation, i});
+                }
+
+                batch_cond.notify_all();
+
+                done_cond.wait(lock, [this]
+                               { return remaining == 0; });
+
+                task = nullptr;
+
+                if (first_error)
+                {
+                    std::rethrow_exception(first_error);
+                }
             }
         };
-    } // namespace details
+    } // namespace detail
 
-    static inline std::string create2(const std::vector<configurator> &configs)
+    /// @brief Create many mazes across a pool of threads
+    /// @param configs
+    /// @param threads Number of threads, 0 uses the hardware concurrency
+    /// @return One maze per configurator, in the order of the configurators
+    inline std::vector<std::string> create2(const std::vector<configurator> &configs, unsigned int threads = 0)
     {
         if (configs.empty())
         {
@@ -229,29 +264,33 @@ namespace mazes
         // For single config, just use the existing create function
         if (configs.size() == 1)
         {
-            return create(configs[0]);
+            return {create(configs[0])};
         }
 
-        // Static worker pool for thread reuse
-        static detail::worker_concurrent foreman{};
-        static std::once_flag init_flag;
-        
-        // Initialize threads only once
-        std::call_once(init_flag, [&]() {
-            foreman.initThreads();
-        });
+        std::vector<std::string> results(configs.size());
 
-        std::string result{};
+        auto create_at = [&configs, &results](std::size_t i)
+        {
+            results[i] = create(configs[i]);
+        };
 
-        foreman.generate(configs, result);
+        if (threads == 0)
+        {
+            // The default pool is kept alive for reuse, an inline function shares one pool across translation units
+            static detail::work_stealing_executor foreman{};
 
-        foreman.wait_for_completion();
+            foreman.run(configs.size(), create_at);
+        }
+        else
+        {
+            detail::work_stealing_executor foreman{threads};
 
-        // Note: We don't call cleanup() here to keep threads alive for reuse
+            foreman.run(configs.size(), create_at);
+        }
 
-        return result;
+        return results;
     }
 
 } // namespace mazes
 
-#endif // CREATE_2_H
\ No newline at end of file
+#endif // CREATE_2_H
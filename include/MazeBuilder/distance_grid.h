@@ -42,11 +42,29 @@ namespace mazes
         /// @return
         virtual std::string contents_of(std::shared_ptr<cell> const &c) const noexcept override;
 
+        /// @brief
+        /// @param index
+        /// @return
+        virtual std::string contents_at(int index) const noexcept override;
+
+        /// @brief Cells show their distance once distances are calculated
+        /// @return
+        virtual bool has_contents() const noexcept override;
+
         /// @brief
         /// @param c
         /// @return
         virtual std::uint32_t background_color_for(std::shared_ptr<cell> const &c) const noexcept override;
 
+        /// @brief Color a cell on the distance ramp once distances are calculated
+        /// @param index
+        /// @return
+        virtual std::uint32_t background_color_at(int index) const noexcept override;
+
+        /// @brief Cells are colored by distance once distances are calculated
+        /// @return
+        virtual bool has_background_colors() const noexcept override;
+
         // Delegate to embedded grid
         virtual grid_operations &operations() noexcept override;
 
@@ -57,6 +75,14 @@ namespace mazes
         /// @param end_index The ending index of the range (exclusive).
         void calculate_distances(int start_index, int end_index) noexcept;
 
+        /// @brief Calculate distances with the parallel breadth-first search
+        /// @param threads Number of threads, 1 keeps the serial search and 0 uses the hardware concurrency
+        void set_distance_threads(unsigned int threads) noexcept { m_distance_threads = threads; }
+
+        /// @brief Get the number of threads used to calculate distances
+        /// @return
+        unsigned int get_distance_threads() const noexcept { return m_distance_threads; }
+
         std::shared_ptr<distances> get_distances() const noexcept;
 
     private:
@@ -64,6 +90,10 @@ namespace mazes
 
         std::shared_ptr<distances> m_distances;
 
+        int m_max_distance{0};
+
+        unsigned int m_distance_threads{1};
+
         std::unique_ptr<grid_interface> m_grid;
     };
 }
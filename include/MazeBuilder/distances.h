@@ -2,19 +2,23 @@
 #define DISTANCES_H
 
 #include <cstdint>
+#include <limits>
 #include <memory>
-#include <unordered_map>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace mazes
 {
 
     class grid_interface;
+    class grid_operations;
 
     /// @file distances.h
     /// @class distances
     /// @brief A class that manages distances associated with cells in a grid.
     /// @details This class provides functionality to initialize distances from a root cell,
+    /// @details Distances are a dense field indexed by cell, -1 marks a cell without a distance
     class distances
     {
 
@@ -23,9 +27,15 @@ namespace mazes
         /// @param root_index The index of the root cell used to initialize the distances object.
         explicit distances(int32_t root_index);
 
+        /// @brief Take over a field of distances, such as the one returned by field()
+        /// @param root_index
+        /// @param field One distance per cell, -1 where a cell has no distance
+        distances(int32_t root_index, std::vector<std::int32_t> &&field) noexcept;
+
         /// @brief Overloaded operator to access the distance of a cell by index.
         /// @param index The index of the cell whose distance is to be accessed.
         /// @return A reference to the integer distance associated with the specified cell index.
+        /// @details A negative index, or one the field cannot grow to hold, refers to a slot outside of the field that reads -1
         int &operator[](int32_t index) noexcept;
 
         /// @brief Accesses the value associated with a given cell index.
@@ -51,14 +61,34 @@ namespace mazes
         /// @return A pair containing the index of the cell with the maximum distance and the distance value.
         std::pair<int32_t, int> max() const noexcept;
 
+        /// @brief Compute the distance of every cell from a root with one breadth-first search over the links
+        /// @param ops The grid to walk
+        /// @param root_index
+        /// @param max_distance Cells farther than this are left without a distance
+        /// @return One distance per cell, -1 where the cell cannot be reached or the root is out of range
+        static std::vector<std::int32_t> field(const grid_operations &ops, int32_t root_index, std::int32_t max_distance = std::numeric_limits<std::int32_t>::max());
+
+        /// @brief Map a distance onto a color ramp, bright at the root and dark at the farthest cell
+        /// @param distance
+        /// @param max_distance The largest distance in the field
+        /// @return The color as 0xRRGGBB
+        static std::uint32_t ramp_color(int distance, int max_distance) noexcept;
+
         /// @brief Collects all cell indices stored in the distances object.
         /// @param indices A reference to a vector to store the collected indices.
         void collect_keys(std::vector<int32_t> &indices) const noexcept;
 
+        /// @brief Get the dense field, one distance per cell index and -1 for cells without one
+        /// @return
+        std::span<const std::int32_t> values() const noexcept { return m_cells; }
+
     private:
-        std::unordered_map<int32_t, int> m_cells;
+        std::vector<std::int32_t> m_cells;
 
         int32_t m_root_index;
+
+        // Written through operator[] for indices the field does not hold, never read back
+        int m_outside;
     }; // class distances
 
 } // namespace mazes
@@ -0,0 +1,47 @@
+#ifndef ELLERS_H
+#define ELLERS_H
+
+#include <MazeBuilder/algo_interface.h>
+
+#include <cstdint>
+#include <functional>
+#include <span>
+
+namespace mazes
+{
+
+    class grid_interface;
+    class randomizer;
+
+    /// @file ellers.h
+    /// @class ellers
+    /// @brief Eller's algorithm for generating mazes one row at a time
+    /// @details Only the set of every cell in the current row is kept, so memory is O(columns) however tall the maze is
+    class ellers : public algo_interface
+    {
+
+    public:
+        /// @brief Receives each finished row, in order from the top
+        /// @details links holds one byte per column using the link_masks layout, bit d is set when the passage toward Direction d is open
+        /// @details The span is only valid during the call, return false to stop generating
+        using row_sink = std::function<bool(unsigned int row, std::span<const std::uint8_t> links)>;
+
+        /// @brief Implement Eller's algorithm on every level of the grid
+        /// @param g
+        /// @param rng
+        /// @return success or failure
+        bool run(grid_interface *g, randomizer &rng) const noexcept override;
+
+        /// @brief Generate a single-level maze without a grid, handing each row to the sink as soon as it is finished
+        /// @details Draws the same random numbers as run on a single-level grid of the same size, so both produce the same maze
+        /// @param rows
+        /// @param columns
+        /// @param rng
+        /// @param sink Called once per row
+        /// @return False when a dimension is zero or the sink stops early
+        bool run(unsigned int rows, unsigned int columns, randomizer &rng, const row_sink &sink) const;
+    };
+
+}
+
+#endif // ELLERS_H
@@ -41,7 +41,13 @@ namespace mazes
 
         STDOUT = 5,
 
-        TOTAL = 6
+        /// @brief glTF 2.0 binary
+        GLB = 6,
+
+        /// @brief Binary little-endian PLY
+        PLY = 7,
+
+        TOTAL = 8
     };
 
     /// @brief Convert an output_format enum to a string
@@ -71,6 +77,12 @@ namespace mazes
         case output_format::STDOUT:
 
             return "stdout";
+        case output_format::GLB:
+
+            return "glb";
+        case output_format::PLY:
+
+            return "ply";
         default:
 
             throw std::invalid_argument("Invalid output_format: " + std::to_string(static_cast<unsigned int>(of)));
@@ -118,6 +130,16 @@ namespace mazes
 
             return output_format::STDOUT;
         }
+        else if (sv.compare("glb") == 0)
+        {
+
+            return output_format::GLB;
+        }
+        else if (sv.compare("ply") == 0)
+        {
+
+            return output_format::PLY;
+        }
         else
         {
 
@@ -131,7 +153,8 @@ namespace mazes
         BINARY_TREE = 0,
         SIDEWINDER = 1,
         DFS = 2,
-        TOTAL = 3
+        ELLERS = 3,
+        TOTAL = 4
     };
 
     /// @brief Convert the algo enum to a string
@@ -150,6 +173,9 @@ namespace mazes
         case algo::DFS:
 
             return "dfs";
+        case algo::ELLERS:
+
+            return "ellers";
         default:
             throw std::invalid_argument("Invalid algo: " + std::to_string(static_cast<unsigned int>(a)));
         }
@@ -172,21 +198,105 @@ namespace mazes
         {
             return algo::DFS;
         }
+        else if (a.compare("ellers") == 0)
+        {
+            return algo::ELLERS;
+        }
         else
         {
             throw std::invalid_argument("Invalid algo: " + std::string{a});
         }
     };
 
+    /// @brief Enum class for the engines behind the randomizer
+    enum class rng_engine : unsigned int
+    {
+        XOSHIRO256SS = 0,
+        MT19937 = 1,
+        TOTAL = 2
+    };
+
+    /// @brief Convert the rng_engine enum to a string
+    /// @param e
+    /// @return string
+    inline std::string_view to_sv_from_rng_engine(rng_engine e)
+    {
+        switch (e)
+        {
+        case rng_engine::XOSHIRO256SS:
+
+            return "xoshiro256ss";
+        case rng_engine::MT19937:
+
+            return "mt19937";
+        default:
+            throw std::invalid_argument("Invalid rng_engine: " + std::to_string(static_cast<unsigned int>(e)));
+        }
+    };
+
+    /// @brief Convert a string to an rng_engine enum
+    /// @param e
+    /// @return rng_engine
+    inline rng_engine to_rng_engine_from_sv(std::string_view e)
+    {
+        if (e.compare("xoshiro256ss") == 0)
+        {
+            return rng_engine::XOSHIRO256SS;
+        }
+        else if (e.compare("mt19937") == 0)
+        {
+            return rng_engine::MT19937;
+        }
+        else
+        {
+            throw std::invalid_argument("Invalid rng_engine: " + std::string{e});
+        }
+    };
+
     /// @brief Directional neighbors for grid topology
+    /// @details UP and DOWN move between levels, UP being the next level
     enum class Direction : std::uint8_t
     {
         NORTH = 0,
         SOUTH = 1,
         EAST = 2,
         WEST = 3,
+        UP = 4,
+        DOWN = 5,
         COUNT
     };
+
+    /// @brief Convert a Direction to its bit in a cell's link mask
+    /// @param d
+    /// @return A mask with only the bit for the direction set
+    inline constexpr std::uint8_t to_link_bit_from_direction(Direction d) noexcept
+    {
+        return static_cast<std::uint8_t>(1u << static_cast<std::uint8_t>(d));
+    }
+
+    /// @brief Get the direction pointing back from a neighbor
+    /// @param d
+    /// @return The opposite direction
+    inline constexpr Direction to_opposite_from_direction(Direction d) noexcept
+    {
+        switch (d)
+        {
+        case Direction::NORTH:
+            return Direction::SOUTH;
+        case Direction::SOUTH:
+            return Direction::NORTH;
+        case Direction::EAST:
+            return Direction::WEST;
+        case Direction::WEST:
+            return Direction::EAST;
+        case Direction::UP:
+            return Direction::DOWN;
+        case Direction::DOWN:
+            return Direction::UP;
+        default:
+            return d;
+        }
+    }
 } // namespace
 
 #endif // ENUMS
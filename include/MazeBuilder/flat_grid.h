@@ -0,0 +1,205 @@
+#ifndef FLAT_GRID_H
+#define FLAT_GRID_H
+
+#include <MazeBuilder/enums.h>
+#include <MazeBuilder/grid_interface.h>
+#include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace mazes
+{
+
+    class cell;
+
+    /// @file flat_grid.h
+    /// @class flat_grid
+    /// @brief Grid backend that stores every cell in one contiguous, index-addressed block
+    /// @details Cells are laid out row-major within each level, and levels are stacked as planes
+    /// @details Lookups are pointer arithmetic into the block, there is no per-cell allocation
+    /// @details Cell pointers handed out share ownership of the whole block
+    /// @details Links live in a dense bitmask array, one byte per cell
+    /// @details The cell block is only created on the first search, index-based callers never pay for it
+    class flat_grid : public grid_interface, public grid_operations
+    {
+
+    public:
+        /// @brief Construct a flat grid using unsigned integers
+        /// @param rows
+        /// @param columns
+        /// @param levels
+        explicit flat_grid(unsigned int rows = 1u, unsigned int columns = 1u, unsigned int levels = 1u);
+
+        /// @brief Construct a flat grid using a tuple of unsigned integers
+        /// @param dimens
+        explicit flat_grid(std::tuple<unsigned int, unsigned int, unsigned int> dimens);
+
+        /// @brief Copy constructor, cells and links are copied into a new block
+        /// @param other
+        flat_grid(const flat_grid &other);
+
+        /// @brief Assignment operator, cells and links are copied into a new block
+        /// @param other
+        /// @return
+        flat_grid &operator=(const flat_grid &other);
+
+        /// @brief Move constructor
+        /// @param other
+        flat_grid(flat_grid &&other) noexcept;
+
+        /// @brief Move assignment operator
+        /// @param other
+        /// @return
+        flat_grid &operator=(flat_grid &&other) noexcept;
+
+        /// @brief Destructor
+        ~flat_grid() override;
+
+        /// @brief
+        /// @return
+        grid_operations &operations() noexcept override;
+
+        /// @brief
+        /// @return
+        const grid_operations &operations() const noexcept override;
+
+        /// @brief Get the dimensions of the grid
+        /// @return A tuple containing the number of rows, columns, and levels
+        std::tuple<unsigned int, unsigned int, unsigned int> get_dimensions() const noexcept override;
+
+        /// @brief Get detailed information of a cell in the grid
+        /// @param c
+        /// @return
+        virtual std::string contents_of(std::shared_ptr<cell> const &c) const noexcept override;
+
+        /// @brief Get detailed information of a cell by its index, without creating the cell block
+        /// @param index
+        /// @return
+        virtual std::string contents_at(int index) const noexcept override;
+
+        /// @brief Cells of a plain grid are always blank
+        /// @return false
+        virtual bool has_contents() const noexcept override;
+
+        /// @brief Get the background color for a cell in the grid
+        /// @param c
+        /// @return
+        virtual std::uint32_t background_color_for(std::shared_ptr<cell> const &c) const noexcept override;
+
+        /// @brief Get the background color for a cell by its index, without creating the cell
+        /// @param index
+        /// @return
+        virtual std::uint32_t background_color_at(int index) const noexcept override;
+
+        /// @brief Get neighbor by the cell's respective location
+        /// @param c
+        /// @param dir
+        /// @return
+        virtual std::shared_ptr<cell> get_neighbor(std::shared_ptr<cell> const &c, Direction dir) const noexcept override;
+
+        /// @brief Get all the neighbors by the cell
+        /// @param c
+        /// @return
+        virtual std::vector<std::shared_ptr<cell>> get_neighbors(std::shared_ptr<cell> const &c) const noexcept override;
+
+        /// @brief Topology is implied by the layout of the block, so this is a no-op
+        /// @param c
+        /// @param dir
+        /// @param neighbor
+        /// @return
+        virtual void set_neighbor(const std::shared_ptr<cell> &c, Direction dir, std::shared_ptr<cell> const &neighbor) noexcept override;
+
+        /// @brief Get the index of a cell's neighbor without touching any cell objects
+        /// @param index
+        /// @param dir
+        /// @return The neighbor index, or -1 when there is no neighbor in that direction
+        virtual int get_neighbor_index(int index, Direction dir) const noexcept override;
+
+        /// @brief Get the indices of all neighbors of a cell
+        /// @param index
+        /// @return Neighbor indices ordered by Direction, -1 where there is no neighbor
+        virtual std::array<int, static_cast<size_t>(Direction::COUNT)> get_neighbor_indices(int index) const noexcept override;
+
+        /// @brief Check if the passage from a cell toward a direction is open
+        /// @param index
+        /// @param dir
+        /// @return
+        virtual bool is_linked(int index, Direction dir) const noexcept override;
+
+        // Convenience methods for accessing neighbors
+        virtual std::shared_ptr<cell> get_north(const std::shared_ptr<cell> &c) const noexcept override;
+        virtual std::shared_ptr<cell> get_south(const std::shared_ptr<cell> &c) const noexcept override;
+        virtual std::shared_ptr<cell> get_east(const std::shared_ptr<cell> &c) const noexcept override;
+        virtual std::shared_ptr<cell> get_west(const std::shared_ptr<cell> &c) const noexcept override;
+
+        /// @brief Search for a cell by index
+        /// @param index
+        /// @return The cell at the index, or nullptr when the index is out of range
+        virtual std::shared_ptr<cell> search(int index) const noexcept override;
+
+        /// @brief Get the count of cells in the grid
+        /// @return The number of cells in the grid
+        virtual int num_cells() const noexcept override;
+
+        /// @brief Get the dense link storage of the grid, one bitmask per cell
+        /// @return
+        virtual link_masks &get_link_masks() noexcept override;
+
+        /// @brief Get the dense link storage of the grid, one bitmask per cell
+        /// @return
+        virtual const link_masks &get_link_masks() const noexcept override;
+
+        /// @brief Cleanup cells by cleaning up links within cells
+        virtual void clear_cells() noexcept override;
+
+        virtual void set_str(std::string const &str) noexcept override;
+
+        virtual void set_str(std::string &&str) noexcept override;
+
+        virtual std::string get_str() const noexcept override;
+
+        /// @brief Get the mesh for 3D output, such as the one built by objectify
+        /// @return
+        virtual mesh &get_mesh() noexcept override;
+
+        /// @brief Get the mesh for 3D output, such as the one built by objectify
+        /// @return
+        virtual const mesh &get_mesh() const noexcept override;
+
+        /// @brief Take over a mesh for 3D output
+        /// @param m
+        virtual void set_mesh(mesh &&m) noexcept override;
+
+    private:
+        /// @brief Point every cell in the block at this grid, or detach them
+        /// @param owner
+        void attach_cells(grid_operations *owner) noexcept;
+
+        /// @brief Create the cell block the first time a cell object is needed
+        void materialize_cells() const noexcept;
+
+        std::tuple<unsigned int, unsigned int, unsigned int> m_dimensions;
+
+        link_masks m_links;
+
+        // Contiguous cell storage, index == position in the block, created on demand
+        mutable std::shared_ptr<std::vector<cell>> m_cells;
+
+        mutable std::unique_ptr<std::once_flag> m_cells_once;
+
+        std::string m_str;
+
+        // 3D data
+        mesh m_mesh;
+    };
+
+} // namespace mazes
+
+#endif // FLAT_GRID_H
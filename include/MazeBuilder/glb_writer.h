@@ -0,0 +1,44 @@
+#ifndef GLB_WRITER_H
+#define GLB_WRITER_H
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace mazes
+{
+
+    class mesh;
+
+    /// @file glb_writer.h
+    /// @class glb_writer
+    /// @brief Binary glTF 2.0 writer for a mesh
+    /// @details The file holds a JSON chunk and one 4-byte aligned binary chunk: float positions, then uint32 indices
+    /// @details Indices are written straight from the mesh buffer, positions are converted to floats a block at a time
+    /// @details The maze lattice is turned to glTF's Y-up: columns run along +X, levels along +Y, and rows along +Z
+    class glb_writer final
+    {
+
+    public:
+        /// @brief Write to a stream opened in binary mode
+        /// @param os
+        explicit glb_writer(std::ostream &os) noexcept;
+
+        /// @brief Write the whole file
+        /// @param m
+        /// @return False when the stream failed or the mesh does not fit in a 4 GiB file
+        bool write(const mesh &m);
+
+        /// @brief Check if nothing has failed so far
+        /// @return
+        bool good() const noexcept { return static_cast<bool>(m_os); }
+
+    private:
+        std::ostream &m_os;
+
+        // Positions converted to floats, reused for every block
+        std::vector<float> m_block;
+    };
+} // namespace mazes
+
+#endif // GLB_WRITER_H
@@ -4,8 +4,10 @@
 #include <MazeBuilder/enums.h>
 #include <MazeBuilder/grid_interface.h>
 #include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
 
 #include <atomic>
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -38,11 +40,11 @@ namespace mazes
         /// @param dimens
         explicit grid(std::tuple<unsigned int, unsigned int, unsigned int> dimens);
 
-        /// @brief Copy constructor
+        /// @brief Copy constructor, cells and links are copied into this grid
         /// @param other
         grid(const grid &other);
 
-        /// @brief Assignment operator
+        /// @brief Assignment operator, cells and links are copied into this grid
         /// @param other
         /// @return
         grid &operator=(const grid &other);
@@ -76,11 +78,25 @@ namespace mazes
         /// @return
         virtual std::string contents_of(std::shared_ptr<cell> const &c) const noexcept override;
 
+        /// @brief Get detailed information of a cell by its index
+        /// @param index
+        /// @return
+        virtual std::string contents_at(int index) const noexcept override;
+
+        /// @brief Cells of a plain grid are always blank
+        /// @return false
+        virtual bool has_contents() const noexcept override;
+
         /// @brief Get the background color for a cell in the grid
         /// @param c
         /// @return
         virtual std::uint32_t background_color_for(std::shared_ptr<cell> const &c) const noexcept override;
 
+        /// @brief Get the background color for a cell by its index, without creating the cell
+        /// @param index
+        /// @return
+        virtual std::uint32_t background_color_at(int index) const noexcept override;
+
         /// @brief Get neighbor by the cell's respective location
         /// @param c
         /// @param dir
@@ -99,6 +115,23 @@ namespace mazes
         /// @return
         virtual void set_neighbor(const std::shared_ptr<cell> &c, Direction dir, std::shared_ptr<cell> const &neighbor) noexcept override;
 
+        /// @brief Get the index of a cell's neighbor without touching any cell objects
+        /// @param index
+        /// @param dir
+        /// @return The neighbor index, or -1 when there is no neighbor in that direction
+        virtual int get_neighbor_index(int index, Direction dir) const noexcept override;
+
+        /// @brief Get the indices of all neighbors of a cell
+        /// @param index
+        /// @return Neighbor indices ordered by Direction, -1 where there is no neighbor
+        virtual std::array<int, static_cast<size_t>(Direction::COUNT)> get_neighbor_indices(int index) const noexcept override;
+
+        /// @brief Check if the passage from a cell toward a direction is open
+        /// @param index
+        /// @param dir
+        /// @return
+        virtual bool is_linked(int index, Direction dir) const noexcept override;
+
         // Convenience methods for accessing neighbors
         virtual std::shared_ptr<cell> get_north(const std::shared_ptr<cell> &c) const noexcept override;
         virtual std::shared_ptr<cell> get_south(const std::shared_ptr<cell> &c) const noexcept override;
@@ -114,34 +147,47 @@ namespace mazes
         /// @return The number of cells in the grid
         virtual int num_cells() const noexcept override;
 
+        /// @brief Get the dense link storage of the grid, one bitmask per cell
+        /// @return
+        virtual link_masks &get_link_masks() noexcept override;
+
+        /// @brief Get the dense link storage of the grid, one bitmask per cell
+        /// @return
+        virtual const link_masks &get_link_masks() const noexcept override;
+
         /// @brief Cleanup cells by cleaning up links within cells
         virtual void clear_cells() noexcept override;
 
         virtual void set_str(std::string const &str) noexcept override;
 
-        virtual std::string get_str() const noexcept override;
+        virtual void set_str(std::string &&str) noexcept override;
 
-        /// @brief Get the vertices for wavefront object file generation
-        /// @return A vector of vertices as tuples (x, y, z, w)
-        virtual std::vector<std::tuple<int, int, int, int>> get_vertices() const noexcept override;
+        virtual std::string get_str() const noexcept override;
 
-        /// @brief Set the vertices for wavefront object file generation
-        /// @param vertices A vector of vertices as tuples (x, y, z, w)
-        virtual void set_vertices(const std::vector<std::tuple<int, int, int, int>> &vertices) noexcept override;
+        /// @brief Get the mesh for 3D output, such as the one built by objectify
+        /// @return
+        virtual mesh &get_mesh() noexcept override;
 
-        /// @brief Get the faces for wavefront object file generation
-        /// @return A vector of faces, where each face is a vector of vertex indices
-        virtual std::vector<std::vector<std::uint32_t>> get_faces() const noexcept override;
+        /// @brief Get the mesh for 3D output, such as the one built by objectify
+        /// @return
+        virtual const mesh &get_mesh() const noexcept override;
 
-        /// @brief Set the faces for wavefront object file generation
-        /// @param faces A vector of faces, where each face is a vector of vertex indices
-        virtual void set_faces(const std::vector<std::vector<std::uint32_t>> &faces) noexcept override;
+        /// @brief Take over a mesh for 3D output
+        /// @param m
+        virtual void set_mesh(mesh &&m) noexcept override;
 
     private:
+        /// @brief Point every cell at this grid, or detach them
+        /// @param owner
+        void attach_cells(grid_operations *owner) noexcept;
+
         std::unordered_map<int, std::shared_ptr<cell>> m_cells;
 
         std::tuple<unsigned int, unsigned int, unsigned int> m_dimensions;
 
+        // One link bitmask per cell, indexed like m_cells
+        link_masks m_links;
+
         // Store topology - which cell is neighbor to which in what direction
         // Key: cell index, Value: map of direction to neighbor cell index
         mutable std::mutex m_topology_mutex;
@@ -150,8 +196,7 @@ namespace mazes
         std::string m_str;
 
         // 3D data
-        std::vector<std::tuple<int, int, int, int>> m_vertices;
-        std::vector<std::vector<std::uint32_t>> m_faces;
+        mesh m_mesh;
     };
 
 } // namespace mazes
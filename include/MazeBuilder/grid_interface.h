@@ -1,6 +1,8 @@
 #ifndef GRID_INTERFACE_H
 #define GRID_INTERFACE_H
 
+#include <MazeBuilder/grid_operations.h>
+
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -27,11 +29,45 @@ namespace mazes
         /// @return
         virtual std::string contents_of(std::shared_ptr<cell> const &c) const noexcept = 0;
 
+        /// @brief Get detailed information of a cell by its index in the form of a string
+        /// @details Grids that can answer without a cell object override this to avoid creating one
+        /// @param index
+        /// @return
+        virtual std::string contents_at(int index) const noexcept
+        {
+            return contents_of(operations().search(index));
+        }
+
+        /// @brief Check if cells can have contents other than the blank " "
+        /// @details Renderers skip contents_at for every cell when this is false, override both together
+        /// @return
+        virtual bool has_contents() const noexcept
+        {
+            return true;
+        }
+
         /// @brief Returns the background color for the specified cell, if available.
         /// @param c A shared pointer to the cell for which to determine the background color.
         /// @return An optional 32-bit unsigned integer representing the background color of the cell
         virtual std::uint32_t background_color_for(std::shared_ptr<cell> const &c) const noexcept = 0;
 
+        /// @brief Get the background color of a cell by its index, as 0xRRGGBB
+        /// @details Grids that can answer without a cell object override this to avoid creating one
+        /// @param index
+        /// @return
+        virtual std::uint32_t background_color_at(int index) const noexcept
+        {
+            return background_color_for(operations().search(index));
+        }
+
+        /// @brief Check if cells can have a background color other than the plain floor
+        /// @details Renderers skip background_color_at for every cell when this is false, override both together
+        /// @return
+        virtual bool has_background_colors() const noexcept
+        {
+            return false;
+        }
+
         /// @brief Get access to grid operations interface
         /// @return A reference to the grid operations interface
         virtual class grid_operations &operations() noexcept = 0;
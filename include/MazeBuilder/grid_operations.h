@@ -3,7 +3,10 @@
 
 #include <MazeBuilder/cell.h>
 #include <MazeBuilder/enums.h>
+#include <MazeBuilder/link_masks.h>
+#include <MazeBuilder/mesh.h>
 
+#include <array>
 #include <memory>
 #include <tuple>
 #include <vector>
@@ -49,6 +52,23 @@ namespace mazes
         virtual std::shared_ptr<cell> get_east(const std::shared_ptr<cell> &c) const noexcept = 0;
         virtual std::shared_ptr<cell> get_west(const std::shared_ptr<cell> &c) const noexcept = 0;
 
+        /// @brief Get the index of a cell's neighbor without touching any cell objects
+        /// @param index
+        /// @param dir
+        /// @return The neighbor index, or -1 when there is no neighbor in that direction
+        virtual int get_neighbor_index(int index, Direction dir) const noexcept = 0;
+
+        /// @brief Get the indices of all neighbors of a cell
+        /// @param index
+        /// @return Neighbor indices ordered by Direction, -1 where there is no neighbor
+        virtual std::array<int, static_cast<size_t>(Direction::COUNT)> get_neighbor_indices(int index) const noexcept = 0;
+
+        /// @brief Check if the passage from a cell toward a direction is open
+        /// @param index
+        /// @param dir
+        /// @return
+        virtual bool is_linked(int index, Direction dir) const noexcept = 0;
+
         /// @brief Search for a cell by index
         /// @param index
         /// @return
@@ -58,28 +78,40 @@ namespace mazes
         /// @return The number of cells in the grid
         virtual int num_cells() const noexcept = 0;
 
+        /// @brief Get the dense link storage of the grid, one bitmask per cell
+        /// @return
+        virtual link_masks &get_link_masks() noexcept = 0;
+
+        /// @brief Get the dense link storage of the grid, one bitmask per cell
+        /// @return
+        virtual const link_masks &get_link_masks() const noexcept = 0;
+
         /// @brief Cleanup cells by cleaning up links within cells
         virtual void clear_cells() noexcept = 0;
 
         virtual void set_str(std::string const &str) noexcept = 0;
 
-        virtual std::string get_str() const noexcept = 0;
+        /// @brief Take over a string that is no longer needed by the caller
+        /// @details Grids that store the string override this to move it instead of copying
+        /// @param str
+        virtual void set_str(std::string &&str) noexcept
+        {
+            set_str(static_cast<std::string const &>(str));
+        }
 
-        /// @brief Get the vertices for wavefront object file generation
-        /// @return A vector of vertices as tuples (x, y, z, w)
-        virtual std::vector<std::tuple<int, int, int, int>> get_vertices() const noexcept = 0;
+        virtual std::string get_str() const noexcept = 0;
 
-        /// @brief Set the vertices for wavefront object file generation
-        /// @param vertices A vector of vertices as tuples (x, y, z, w)
-        virtual void set_vertices(const std::vector<std::tuple<int, int, int, int>> &vertices) noexcept = 0;
+        /// @brief Get the mesh for 3D output, such as the one built by objectify
+        /// @return
+        virtual mesh &get_mesh() noexcept = 0;
 
-        /// @brief Get the faces for wavefront object file generation
-        /// @return A vector of faces, where each face is a vector of vertex indices
-        virtual std::vector<std::vector<std::uint32_t>> get_faces() const noexcept = 0;
+        /// @brief Get the mesh for 3D output, such as the one built by objectify
+        /// @return
+        virtual const mesh &get_mesh() const noexcept = 0;
 
-        /// @brief Set the faces for wavefront object file generation
-        /// @param faces A vector of faces, where each face is a vector of vertex indices
-        virtual void set_faces(const std::vector<std::vector<std::uint32_t>> &faces) noexcept = 0;
+        /// @brief Take over a mesh for 3D output
+        /// @param m
+        virtual void set_mesh(mesh &&m) noexcept = 0;
     };
 
 } // namespace mazes
@@ -35,6 +35,22 @@ namespace mazes
         /// @return
         bool write_jpeg(const std::string &filename, const std::vector<std::uint8_t> &data, unsigned int w = 100, unsigned int h = 100, unsigned int stride = 4) const noexcept;
 
+        /// @brief Encode pixels as PNG file contents in memory
+        /// @param data
+        /// @param w
+        /// @param h
+        /// @param stride 4
+        /// @return The encoded bytes, empty on failure
+        std::string encode_png(const std::vector<std::uint8_t> &data, unsigned int w, unsigned int h, unsigned int stride = 4) const noexcept;
+
+        /// @brief Encode pixels as JPEG file contents in memory
+        /// @param data
+        /// @param w
+        /// @param h
+        /// @param stride 4
+        /// @return The encoded bytes, empty on failure
+        std::string encode_jpeg(const std::vector<std::uint8_t> &data, unsigned int w, unsigned int h, unsigned int stride = 4) const noexcept;
+
         /// @brief Handles writing to an output stream
         /// @param oss
         /// @param data
@@ -44,8 +60,9 @@ namespace mazes
         /// @brief Write to a file
         /// @param filename
         /// @param data
+        /// @param binary Write the bytes untranslated, as needed for images
         /// @return
-        bool write_file(const std::string &filename, const std::string &data) const noexcept;
+        bool write_file(const std::string &filename, const std::string &data, bool binary = false) const noexcept;
 
         /// @brief Get the directory path from a full file path
         /// @param filepath Full file path
@@ -1,6 +1,8 @@
 #ifndef LAB_H
 #define LAB_H
 
+#include <MazeBuilder/enums.h>
+
 #include <memory>
 #include <vector>
 
@@ -10,6 +12,7 @@ namespace mazes
 
     class cell;
     class configurator;
+    class grid_operations;
 
     /// @file lab.h
     /// @class lab
@@ -31,6 +34,29 @@ namespace mazes
         /// @param bidi A boolean flag indicating if the unlink should be bidirectional. Defaults to true.
         static void unlink(const std::shared_ptr<cell> &c1, const std::shared_ptr<cell> &c2, bool bidi = true) noexcept;
 
+        /// @brief Links a cell to its neighbor in a direction using the grid's link masks
+        /// @param g The grid that owns the cell
+        /// @param index The index of the cell
+        /// @param dir The direction of the neighbor
+        /// @param bidi A boolean flag indicating if the link should be bidirectional. Defaults to true.
+        /// @return False when the cell has no neighbor in that direction
+        static bool link(grid_operations &g, int index, Direction dir, bool bidi = true) noexcept;
+
+        /// @brief Unlinks a cell from its neighbor in a direction using the grid's link masks
+        /// @param g The grid that owns the cell
+        /// @param index The index of the cell
+        /// @param dir The direction of the neighbor
+        /// @param bidi A boolean flag indicating if the unlink should be bidirectional. Defaults to true.
+        /// @return False when the cell has no neighbor in that direction
+        static bool unlink(grid_operations &g, int index, Direction dir, bool bidi = true) noexcept;
+
+        /// @brief Checks if the passage from a cell toward a direction is open
+        /// @param g The grid that owns the cell
+        /// @param index The index of the cell
+        /// @param dir The direction of the neighbor
+        /// @return True if the cell is linked in that direction
+        static bool is_linked(grid_operations const &g, int index, Direction dir) noexcept;
+
         /// @brief Sets neighbors for a collection of cells based on the provided indices.
         /// @param config The configurator containing maze configuration parameters.
         /// @param indices A vector of indices representing the cells to set neighbors for.
@@ -0,0 +1,170 @@
+#ifndef LINK_MASKS_H
+#define LINK_MASKS_H
+
+#include <MazeBuilder/enums.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace mazes
+{
+
+    /// @file link_masks.h
+    /// @class link_masks
+    /// @brief Dense link storage for a grid, one bitmask byte per cell
+    /// @details Bit positions follow the Direction enum (NORTH, SOUTH, EAST, WEST, UP, DOWN)
+    /// @details Cells are addressed row-major within a level, levels are stacked as planes
+    class link_masks final
+    {
+
+    public:
+        /// @brief Construct link storage with every passage closed
+        /// @param dimens The rows, columns, and levels of the grid
+        explicit link_masks(std::tuple<unsigned int, unsigned int, unsigned int> dimens = {1u, 1u, 1u})
+            : m_rows{std::get<0>(dimens)}, m_columns{std::get<1>(dimens)}, m_levels{std::get<2>(dimens)}, m_masks(static_cast<size_t>(m_rows) * m_columns * m_levels, 0)
+        {
+        }
+
+        /// @brief Get the number of cells covered by the masks
+        /// @return The number of cells
+        int size() const noexcept { return static_cast<int>(m_masks.size()); }
+
+        /// @brief Compute the index of a neighbor from the index of a cell
+        /// @param index
+        /// @param dir
+        /// @return The neighbor index, or -1 when the neighbor would fall outside the grid
+        int neighbor_index(int index, Direction dir) const noexcept
+        {
+            const int columns = static_cast<int>(m_columns);
+            const int plane = static_cast<int>(m_rows) * columns;
+            const int level = index / plane;
+            const int within = index - level * plane;
+            const int row = within / columns;
+            const int col = within - row * columns;
+
+            switch (dir)
+            {
+            case Direction::NORTH:
+                return (row > 0) ? index - columns : -1;
+            case Direction::SOUTH:
+                return (row < static_cast<int>(m_rows) - 1) ? index + columns : -1;
+            case Direction::EAST:
+                return (col < columns - 1) ? index + 1 : -1;
+            case Direction::WEST:
+                return (col > 0) ? index - 1 : -1;
+            case Direction::UP:
+                return (level < static_cast<int>(m_levels) - 1) ? index + plane : -1;
+            case Direction::DOWN:
+                return (level > 0) ? index - plane : -1;
+            default:
+                return -1;
+            }
+        }
+
+        /// @brief Find the direction leading from one cell to an adjacent cell
+        /// @param from
+        /// @param to
+        /// @return The direction, or nullopt when the cells are not adjacent
+        std::optional<Direction> direction_between(int from, int to) const noexcept
+        {
+            for (auto d{0}; d < static_cast<int>(Direction::COUNT); ++d)
+            {
+                if (neighbor_index(from, static_cast<Direction>(d)) == to && to >= 0)
+                {
+                    return static_cast<Direction>(d);
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        /// @brief Get the link mask of a cell
+        /// @param index
+        /// @return The mask, bit d is set when the passage toward Direction d is open
+        std::uint8_t get(int index) const noexcept { return m_masks[static_cast<size_t>(index)]; }
+
+        /// @brief Replace the link mask of a cell
+        /// @param index
+        /// @param mask
+        void set(int index, std::uint8_t mask) noexcept { m_masks[static_cast<size_t>(index)] = mask; }
+
+        /// @brief Check if the passage from a cell toward a direction is open
+        /// @param index
+        /// @param dir
+        /// @return
+        bool is_linked(int index, Direction dir) const noexcept
+        {
+            return (get(index) & to_link_bit_from_direction(dir)) != 0;
+        }
+
+        /// @brief Open the passage from a cell toward a direction
+        /// @param index
+        /// @param dir
+        /// @param bidi Also open the passage back from the neighbor
+        /// @return False when there is no neighbor in that direction
+        bool link(int index, Direction dir, bool bidi = true) noexcept
+        {
+            const auto neighbor = neighbor_index(index, dir);
+
+            if (neighbor < 0)
+            {
+                return false;
+            }
+
+            m_masks[static_cast<size_t>(index)] |= to_link_bit_from_direction(dir);
+
+            if (bidi)
+            {
+                m_masks[static_cast<size_t>(neighbor)] |= to_link_bit_from_direction(to_opposite_from_direction(dir));
+            }
+
+            return true;
+        }
+
+        /// @brief Close the passage from a cell toward a direction
+        /// @param index
+        /// @param dir
+        /// @param bidi Also close the passage back from the neighbor
+        /// @return False when there is no neighbor in that direction
+        bool unlink(int index, Direction dir, bool bidi = true) noexcept
+        {
+            const auto neighbor = neighbor_index(index, dir);
+
+            if (neighbor < 0)
+            {
+                return false;
+            }
+
+            m_masks[static_cast<size_t>(index)] &= static_cast<std::uint8_t>(~to_link_bit_from_direction(dir));
+
+            if (bidi)
+            {
+                m_masks[static_cast<size_t>(neighbor)] &= static_cast<std::uint8_t>(~to_link_bit_from_direction(to_opposite_from_direction(dir)));
+            }
+
+            return true;
+        }
+
+        /// @brief Close every passage in the grid
+        void clear() noexcept { std::fill(m_masks.begin(), m_masks.end(), static_cast<std::uint8_t>(0)); }
+
+        /// @brief Get the masks of every cell in index order
+        /// @return A reference to the mask storage
+        const std::vector<std::uint8_t> &data() const noexcept { return m_masks; }
+
+    private:
+        unsigned int m_rows;
+
+        unsigned int m_columns;
+
+        unsigned int m_levels;
+
+        std::vector<std::uint8_t> m_masks;
+    };
+
+} // namespace mazes
+
+#endif // LINK_MASKS_H
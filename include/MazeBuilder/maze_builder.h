@@ -5,6 +5,7 @@
 /// @brief This file includes all the headers in the maze builder library
 
 #include <MazeBuilder/algo_interface.h>
+#include <MazeBuilder/analytics.h>
 #include <MazeBuilder/args.h>
 #include <MazeBuilder/base64_helper.h>
 #include <MazeBuilder/binary_tree.h>
@@ -17,24 +18,39 @@
 #include <MazeBuilder/dfs.h>
 #include <MazeBuilder/distance_grid.h>
 #include <MazeBuilder/distances.h>
+#include <MazeBuilder/ellers.h>
 #include <MazeBuilder/enums.h>
+#include <MazeBuilder/flat_grid.h>
+#include <MazeBuilder/glb_writer.h>
 #include <MazeBuilder/grid.h>
 #include <MazeBuilder/grid_factory.h>
 #include <MazeBuilder/hash_funcs.h>
 #include <MazeBuilder/io_utils.h>
 #include <MazeBuilder/json_helper.h>
 #include <MazeBuilder/lab.h>
+#include <MazeBuilder/link_masks.h>
 #include <MazeBuilder/maze_factory.h>
 #include <MazeBuilder/maze_interface.h>
+#include <MazeBuilder/mesh.h>
+#include <MazeBuilder/obj_writer.h>
 #include <MazeBuilder/objectify.h>
+#include <MazeBuilder/parallel_bfs.h>
+#include <MazeBuilder/path_index.h>
 #include <MazeBuilder/pixels.h>
+#include <MazeBuilder/ply_writer.h>
+#include <MazeBuilder/png_writer.h>
 #include <MazeBuilder/progress.h>
 #include <MazeBuilder/randomizer.h>
+#include <MazeBuilder/row_streams.h>
+#include <MazeBuilder/seed_search.h>
 #include <MazeBuilder/sidewinder.h>
 #include <MazeBuilder/singleton_base.h>
+#include <MazeBuilder/solver.h>
 #include <MazeBuilder/stringify.h>
 #include <MazeBuilder/string_utils.h>
 #include <MazeBuilder/wavefront_object_helper.h>
+#include <MazeBuilder/worker_team.h>
+#include <MazeBuilder/xoshiro256ss.h>
 
 namespace mazes
 {
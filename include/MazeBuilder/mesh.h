@@ -0,0 +1,100 @@
+#ifndef MESH_H
+#define MESH_H
+
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace mazes
+{
+
+    /// @file mesh.h
+    /// @class mesh
+    /// @brief Triangle mesh held in two flat buffers, one of positions and one of indices
+    /// @details Positions are x, y, z triplets on the integer lattice of the maze
+    /// @details Indices are triplets per triangle, counter-clockwise from outside, and start at 0
+    class mesh final
+    {
+
+    public:
+        /// @brief Reserve room so building a mesh of a known size does not reallocate
+        /// @param vertices
+        /// @param triangles
+        void reserve(size_t vertices, size_t triangles)
+        {
+            m_positions.reserve(vertices * 3);
+            m_indices.reserve(triangles * 3);
+        }
+
+        /// @brief Append a vertex
+        /// @param x
+        /// @param y
+        /// @param z
+        /// @return The index of the new vertex
+        std::uint32_t add_vertex(std::int32_t x, std::int32_t y, std::int32_t z)
+        {
+            const auto index = static_cast<std::uint32_t>(vertex_count());
+
+            m_positions.push_back(x);
+            m_positions.push_back(y);
+            m_positions.push_back(z);
+
+            return index;
+        }
+
+        /// @brief Append a triangle of existing vertices
+        /// @param a
+        /// @param b
+        /// @param c
+        void add_triangle(std::uint32_t a, std::uint32_t b, std::uint32_t c)
+        {
+            m_indices.push_back(a);
+            m_indices.push_back(b);
+            m_indices.push_back(c);
+        }
+
+        /// @brief Get the number of vertices
+        /// @return
+        size_t vertex_count() const noexcept { return m_positions.size() / 3; }
+
+        /// @brief Get the number of triangles
+        /// @return
+        size_t triangle_count() const noexcept { return m_indices.size() / 3; }
+
+        /// @brief Check if there are no triangles
+        /// @return
+        bool empty() const noexcept { return m_indices.empty(); }
+
+        /// @brief Get the positions, three per vertex
+        /// @return
+        std::span<const std::int32_t> positions() const noexcept { return m_positions; }
+
+        /// @brief Get the indices, three per triangle
+        /// @return
+        std::span<const std::uint32_t> indices() const noexcept { return m_indices; }
+
+        /// @brief Move the position buffer out, the mesh is left without vertices
+        /// @return
+        std::vector<std::int32_t> release_positions() noexcept { return std::move(m_positions); }
+
+        /// @brief Move the index buffer out, the mesh is left without triangles
+        /// @return
+        std::vector<std::uint32_t> release_indices() noexcept { return std::move(m_indices); }
+
+        /// @brief Remove every vertex and triangle, keeping the capacity
+        void clear() noexcept
+        {
+            m_positions.clear();
+            m_indices.clear();
+        }
+
+    private:
+        std::vector<std::int32_t> m_positions;
+
+        std::vector<std::uint32_t> m_indices;
+    };
+
+} // namespace mazes
+
+#endif // MESH_H
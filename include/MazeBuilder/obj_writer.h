@@ -0,0 +1,58 @@
+#ifndef OBJ_WRITER_H
+#define OBJ_WRITER_H
+
+#include <MazeBuilder/worker_team.h>
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace mazes
+{
+
+    class mesh;
+
+    /// @file obj_writer.h
+    /// @class obj_writer
+    /// @brief Streaming Wavefront OBJ writer for a mesh
+    /// @details Lines are formatted with std::to_chars, so output does not depend on the locale
+    /// @details Vertex and face lines are formatted in chunks, a batch of chunks in parallel, and written in order
+    /// @details Peak memory is one chunk buffer per thread, reused for every batch
+    class obj_writer final
+    {
+
+    public:
+        /// @brief Write to a stream, such as a std::ofstream
+        /// @param os The stream to write to
+        /// @param threads Number of threads formatting chunks, 0 uses the hardware concurrency
+        /// @param chunk_lines Lines per chunk, 0 picks about 2 MiB of text per chunk
+        explicit obj_writer(std::ostream &os, unsigned int threads = 1, std::size_t chunk_lines = 0);
+
+        /// @brief Write a header comment, then a v line per vertex and an f line per triangle
+        /// @param m
+        /// @return True when the stream is still good
+        bool write(const mesh &m);
+
+        /// @brief Check if nothing has failed so far
+        /// @return
+        bool good() const noexcept { return static_cast<bool>(m_os); }
+
+    private:
+        template <typename Format>
+        void write_lines(std::size_t count, Format &&format);
+
+        std::ostream &m_os;
+
+        // Formats the chunks of every batch, kept for the whole mesh
+        worker_team m_team;
+
+        std::size_t m_chunk_lines;
+
+        // Formatted text of each chunk in a batch
+        std::vector<std::vector<char>> m_buffers;
+
+        std::vector<std::size_t> m_lengths;
+    };
+} // namespace mazes
+
+#endif // OBJ_WRITER_H
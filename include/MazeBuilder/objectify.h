@@ -6,9 +6,18 @@
 namespace mazes
 {
 
+    /// @file objectify.h
+    /// @class objectify
+    /// @brief Build a 3D mesh of the walls of a maze straight from its links
+    /// @details Walls use the layout of stringify, one unit per character, stacked one unit per level
+    /// @details Touching walls share vertices, hidden faces are culled and coplanar faces are merged into rectangles
     class objectify : public algo_interface
     {
     public:
+        /// @brief Build the mesh and hand it to the grid, see grid_operations::get_mesh
+        /// @param g
+        /// @param rng Unused
+        /// @return True if successful
         virtual bool run(grid_interface *g, randomizer &rng) const noexcept override;
     };
 }
@@ -0,0 +1,91 @@
+#ifndef PARALLEL_BFS_H
+#define PARALLEL_BFS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace mazes
+{
+
+    class grid_operations;
+
+    class worker_team;
+
+    /// @file parallel_bfs.h
+    /// @class parallel_bfs
+    /// @brief Direction-optimizing breadth-first search over the link masks of a grid
+    /// @details Each level is expanded top-down from a queue of frontier cells, or bottom-up by every unvisited cell checking a frontier bitmap
+    /// @details Top-down levels claim cells with an atomic compare and swap and collect them in one local queue per thread
+    /// @details The search switches to bottom-up when the frontier has more links than 1 / ALPHA of the unexplored cells, and back when it shrinks below 1 / BETA of the grid
+    /// @details Levels with a small frontier run on the calling thread, which keeps deep mazes, such as those carved by dfs, close to the serial search
+    /// @details The field is the same as distances::field, scratch buffers are kept for the next run
+    /// @details Threads are started once, then every parallel level of every run waits for all of them before the next level
+    class parallel_bfs final
+    {
+
+    public:
+        /// @brief Tuning of the top-down to bottom-up switch
+        static constexpr std::uint64_t ALPHA = 14;
+
+        /// @brief Tuning of the bottom-up to top-down switch
+        static constexpr std::uint64_t BETA = 24;
+
+        /// @brief Frontier cells per thread before a level is expanded in parallel
+        static constexpr std::size_t GRAIN = 4096;
+
+        /// @brief Search on several threads
+        /// @param threads Number of threads, 0 uses the hardware concurrency
+        /// @param grain Frontier cells per thread before a top-down level is expanded in parallel, 0 uses GRAIN
+        explicit parallel_bfs(unsigned int threads = 0, std::size_t grain = 0) noexcept;
+
+        /// @brief Stop the threads of the search
+        ~parallel_bfs();
+
+        parallel_bfs(const parallel_bfs &) = delete;
+
+        parallel_bfs &operator=(const parallel_bfs &) = delete;
+
+        /// @brief Compute the distance of every cell from a root
+        /// @param ops The grid to walk
+        /// @param root_index
+        /// @param max_distance Cells farther than this are left without a distance
+        /// @return One distance per cell, -1 where the cell cannot be reached or the root is out of range
+        std::vector<std::int32_t> run(const grid_operations &ops, std::int32_t root_index, std::int32_t max_distance = std::numeric_limits<std::int32_t>::max());
+
+        /// @brief Get the number of levels expanded bottom-up by the last run
+        /// @return
+        unsigned int bottom_up_levels() const noexcept { return m_bottom_up_levels; }
+
+    private:
+        worker_team &team(unsigned int threads);
+
+        unsigned int m_threads;
+
+        std::size_t m_grain;
+
+        unsigned int m_bottom_up_levels;
+
+        // Frontier and next frontier as queues of cells
+        std::vector<std::int32_t> m_frontier;
+
+        std::vector<std::int32_t> m_next;
+
+        // Cells found by each thread during a top-down level, and links out of them
+        std::vector<std::vector<std::int32_t>> m_locals;
+
+        std::vector<std::uint64_t> m_local_links;
+
+        // Frontier and next frontier as one bit per cell
+        std::vector<std::uint64_t> m_frontier_bits;
+
+        std::vector<std::uint64_t> m_next_bits;
+
+        // Started by the first level expanded in parallel, and kept for the next run
+        std::unique_ptr<worker_team> m_team;
+    };
+} // namespace mazes
+
+#endif // PARALLEL_BFS_H
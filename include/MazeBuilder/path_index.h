@@ -0,0 +1,88 @@
+#ifndef PATH_INDEX_H
+#define PATH_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mazes
+{
+
+    class grid_operations;
+
+    /// @file path_index.h
+    /// @class path_index
+    /// @brief Answers distance and path queries between any two cells of a perfect maze
+    /// @details A perfect maze is a spanning tree, so the path between two cells runs through their lowest common ancestor
+    /// @details The index walks the tree once in depth-first order, a range minimum over the depths of that order finds the ancestor
+    /// @details Range minimums use blocks of 64 cells, a sparse table over the blocks and a bitmask of the increasing minimums inside a block
+    /// @details Queries take constant time, paths take time in their length, and the index takes about 24 bytes per cell
+    /// @details On mazes with loops, distances and paths follow the spanning tree of the depth-first walk
+    class path_index final
+    {
+
+    public:
+        /// @brief Build the index of the cells connected to a root
+        /// @param ops The grid to walk, after a maze has been generated
+        /// @param root_index Cells not connected to the root are left out of the index
+        explicit path_index(const grid_operations &ops, std::int32_t root_index = 0);
+
+        /// @brief Find the cell where the paths from the root to two cells meet
+        /// @param a
+        /// @param b
+        /// @return The ancestor, or -1 when a cell is not in the index
+        std::int32_t lowest_common_ancestor(std::int32_t a, std::int32_t b) const noexcept;
+
+        /// @brief Count the steps from one cell to another
+        /// @param a
+        /// @param b
+        /// @return The number of steps, or -1 when a cell is not in the index
+        std::int32_t distance(std::int32_t a, std::int32_t b) const noexcept;
+
+        /// @brief Collect the cells on the path from one cell to another
+        /// @param a
+        /// @param b
+        /// @param cells Cleared, then filled with the cells from a to b inclusive
+        /// @return False when a cell is not in the index
+        bool path(std::int32_t a, std::int32_t b, std::vector<std::int32_t> &cells) const;
+
+        /// @brief Check if a cell is connected to the root
+        /// @param index
+        /// @return
+        bool contains(std::int32_t index) const noexcept;
+
+        /// @brief Get the number of cells connected to the root
+        /// @return
+        std::size_t size() const noexcept { return m_order.size(); }
+
+    private:
+        static constexpr std::size_t BLOCK = 64;
+
+        // Position in m_order of the shallowest cell among positions first to last inclusive
+        std::size_t shallowest(std::size_t first, std::size_t last) const noexcept;
+
+        std::size_t shallowest_in_block(std::size_t first, std::size_t last) const noexcept;
+
+        std::size_t shallower(std::size_t i, std::size_t j) const noexcept;
+
+        // Per cell, -1 for cells not connected to the root
+        std::vector<std::int32_t> m_parent;
+
+        std::vector<std::int32_t> m_depth;
+
+        std::vector<std::int32_t> m_position;
+
+        // Cells in depth-first order
+        std::vector<std::int32_t> m_order;
+
+        // Per position, the increasing minimums of its block up to that position
+        std::vector<std::uint64_t> m_block_masks;
+
+        // Level k holds the shallowest position over 2^k blocks starting at each block
+        std::vector<std::int32_t> m_sparse;
+
+        std::size_t m_blocks;
+    };
+} // namespace mazes
+
+#endif // PATH_INDEX_H
@@ -3,13 +3,89 @@
 
 #include <MazeBuilder/algo_interface.h>
 
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
 namespace mazes
 {
 
+    /// @file pixels.h
+    /// @class pixels
+    /// @brief Rasterize the walls of a maze to RGBA pixels straight from its link masks
+    /// @details Every cell is cell_size pixels square, walls and corner posts are wall_size pixels thick
+    /// @details Only level 0 is drawn, the same as stringify
+    /// @details Grids with background colors, such as a colored_grid after calculate_distances, get colored floors
     class pixels : public algo_interface
     {
     public:
+        static constexpr auto DEFAULT_CELL_SIZE = 8u;
+
+        static constexpr auto DEFAULT_WALL_SIZE = 2u;
+
+        /// @brief Bytes per pixel, in R, G, B, A order
+        static constexpr auto CHANNELS = 4u;
+
+        static constexpr std::array<std::uint8_t, CHANNELS> WALL_COLOR{0, 0, 0, 255};
+
+        static constexpr std::array<std::uint8_t, CHANNELS> FLOOR_COLOR{255, 255, 255, 255};
+
+        /// @brief Receives each scanline of the image from top to bottom
+        /// @details Return false to stop rasterizing
+        using scanline_sink = std::function<bool(std::span<const std::uint8_t> scanline)>;
+
+        /// @brief Rasterize with the default cell and wall sizes
+        pixels() = default;
+
+        /// @brief Rasterize with custom cell and wall sizes
+        /// @param cell_size Pixels across the open part of a cell, at least 1
+        /// @param wall_size Pixels across a wall, at least 1
+        pixels(unsigned int cell_size, unsigned int wall_size) noexcept
+            : m_cell_size{cell_size == 0 ? 1 : cell_size}, m_wall_size{wall_size == 0 ? 1 : wall_size}
+        {
+        }
+
+        /// @brief Rasterize the grid and keep the RGBA bytes as the grid string
+        /// @details The string holds width * height * CHANNELS bytes, row-major from the top left
+        /// @param g
+        /// @param rng
+        /// @return True if successful, false when the grid is missing or the image is too large
         virtual bool run(grid_interface *g, randomizer &rng) const noexcept override;
+
+        /// @brief Rasterize the grid into a buffer of RGBA bytes
+        /// @param g
+        /// @param rgba Resized to width * height * CHANNELS bytes
+        /// @return True if successful, false when the grid is missing or the image is too large
+        bool run(const grid_interface *g, std::vector<std::uint8_t> &rgba) const;
+
+        /// @brief Rasterize the grid one scanline at a time, holding only a single scanline
+        /// @param g
+        /// @param sink
+        /// @return True if every scanline was accepted by the sink
+        bool run(const grid_interface *g, const scanline_sink &sink) const;
+
+        /// @brief Get the width of the image in pixels
+        /// @param columns
+        /// @return
+        std::uint64_t width(unsigned int columns) const noexcept
+        {
+            return static_cast<std::uint64_t>(columns) * (m_cell_size + m_wall_size) + m_wall_size;
+        }
+
+        /// @brief Get the height of the image in pixels
+        /// @param rows
+        /// @return
+        std::uint64_t height(unsigned int rows) const noexcept
+        {
+            return static_cast<std::uint64_t>(rows) * (m_cell_size + m_wall_size) + m_wall_size;
+        }
+
+    private:
+        unsigned int m_cell_size{DEFAULT_CELL_SIZE};
+
+        unsigned int m_wall_size{DEFAULT_WALL_SIZE};
     };
 }
 
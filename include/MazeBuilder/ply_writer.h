@@ -0,0 +1,43 @@
+#ifndef PLY_WRITER_H
+#define PLY_WRITER_H
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace mazes
+{
+
+    class mesh;
+
+    /// @file ply_writer.h
+    /// @class ply_writer
+    /// @brief Binary little-endian PLY writer for a mesh
+    /// @details Vertices are int x, y, z properties written straight from the position buffer
+    /// @details Faces are a uchar count and three uint indices each, packed a block at a time
+    class ply_writer final
+    {
+
+    public:
+        /// @brief Write to a stream opened in binary mode
+        /// @param os
+        explicit ply_writer(std::ostream &os) noexcept;
+
+        /// @brief Write the header, then every vertex and face
+        /// @param m
+        /// @return True when the stream is still good
+        bool write(const mesh &m);
+
+        /// @brief Check if nothing has failed so far
+        /// @return
+        bool good() const noexcept { return static_cast<bool>(m_os); }
+
+    private:
+        std::ostream &m_os;
+
+        // Packed face records, reused for every block
+        std::vector<std::uint8_t> m_block;
+    };
+} // namespace mazes
+
+#endif // PLY_WRITER_H
@@ -0,0 +1,87 @@
+#ifndef PNG_WRITER_H
+#define PNG_WRITER_H
+
+#include <MazeBuilder/worker_team.h>
+
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace mazes
+{
+
+    /// @file png_writer.h
+    /// @class png_writer
+    /// @brief Streaming PNG encoder that compresses scanlines as they arrive
+    /// @details Rows are gathered into bands, and a batch of bands is filtered and deflated in parallel
+    /// @details Every band ends on a byte boundary with an empty stored block, so the bands join into one zlib stream
+    /// @details Peak memory is a batch of bands, not the whole image
+    class png_writer final
+    {
+
+    public:
+        /// @brief Start a PNG on a stream, the signature and header are written right away
+        /// @param os The stream to write to, opened in binary mode
+        /// @param width Pixels per scanline
+        /// @param height Number of scanlines
+        /// @param channels Bytes per pixel, 1 (gray), 2 (gray and alpha), 3 (RGB), or 4 (RGBA)
+        /// @param threads Number of threads deflating bands, 0 uses the hardware concurrency
+        /// @param band_rows Scanlines per band, 0 picks about 1 MiB of pixels per band
+        png_writer(std::ostream &os, unsigned int width, unsigned int height, unsigned int channels = 4, unsigned int threads = 1, unsigned int band_rows = 0);
+
+        /// @brief Add the next scanline
+        /// @param scanline width * channels bytes
+        /// @return False when the writer failed, the scanline has the wrong size, or every row was already written
+        bool write_row(std::span<const std::uint8_t> scanline);
+
+        /// @brief Add the next scanlines, one after another in a single buffer
+        /// @param rows A whole number of scanlines
+        /// @return False when the writer failed, the rows have the wrong size, or there are too many rows
+        bool write_rows(std::span<const std::uint8_t> rows);
+
+        /// @brief Compress the remaining rows and end the image
+        /// @return True when every row was written and the stream is still good
+        bool finish();
+
+        /// @brief Check if nothing has failed so far
+        /// @return
+        bool good() const noexcept { return m_good && static_cast<bool>(m_os); }
+
+    private:
+        void flush_batch();
+
+        void write_chunk(const char *type, std::span<const std::uint8_t> data);
+
+        std::ostream &m_os;
+
+        unsigned int m_height;
+
+        unsigned int m_channels;
+
+        // Deflates the bands of every batch, kept for the whole image
+        worker_team m_team;
+
+        unsigned int m_band_rows;
+
+        size_t m_row_bytes;
+
+        unsigned int m_rows_written;
+
+        unsigned int m_bands_written;
+
+        std::uint32_t m_adler;
+
+        bool m_good;
+
+        bool m_finished;
+
+        // Unfiltered rows waiting to be compressed, up to one band per thread
+        std::vector<std::uint8_t> m_pending;
+
+        // The last row of the previous batch, filters look one row up
+        std::vector<std::uint8_t> m_previous;
+    };
+} // namespace mazes
+
+#endif // PNG_WRITER_H
@@ -1,8 +1,13 @@
 #ifndef RANDOMIZER_H
 #define RANDOMIZER_H
 
-#include <vector>
+#include <MazeBuilder/enums.h>
+#include <MazeBuilder/xoshiro256ss.h>
+
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <vector>
 
 /// @brief Namespace for the maze builder
 namespace mazes
@@ -10,15 +15,53 @@ namespace mazes
 
     /// @file randomizer.h
 
+    /// @brief Map random bits onto [low, high] without modulo bias
+    /// @details Lemire's multiply-shift on the upper 32 bits of a draw, redrawing the few values that would bias the result
+    /// @tparam Next Callable returning 64 random bits
+    /// @param next
+    /// @param low The lower bound of the integer (inclusive).
+    /// @param high The upper bound of the integer (inclusive), not less than low.
+    /// @return A random integer within the specified range.
+    template <typename Next>
+    inline int to_bounded_int(Next &&next, int low, int high) noexcept
+    {
+        const auto range = static_cast<std::uint32_t>(static_cast<std::int64_t>(high) - low) + 1u;
+
+        if (range == 0u)
+        {
+            // [low, high] covers every int
+            return static_cast<int>(static_cast<std::uint32_t>(next() >> 32));
+        }
+
+        auto product = (next() >> 32) * range;
+
+        if (static_cast<std::uint32_t>(product) < range)
+        {
+            const auto threshold = (0u - range) % range;
+
+            while (static_cast<std::uint32_t>(product) < threshold)
+            {
+                product = (next() >> 32) * range;
+            }
+        }
+
+        return static_cast<int>(static_cast<std::int64_t>(low) + static_cast<std::int64_t>(product >> 32));
+    }
+
     /// @class randomizer
     /// @brief Provides random-number generating capabilities
     /// @details This class provides methods for generating random numbers
+    /// @details The default xoshiro256** engine is held inline and bounded integers are drawn in the header, mt19937 stays available behind a pimpl
     class randomizer
     {
     public:
-        /// @brief Default constructor
+        /// @brief Default constructor, a xoshiro256** engine seeded from std::random_device
         randomizer();
 
+        /// @brief Construct with a specific engine seeded from std::random_device
+        /// @param engine
+        explicit randomizer(rng_engine engine);
+
         /// @brief Destructor
         ~randomizer();
 
@@ -53,7 +96,34 @@ namespace mazes
         /// @return A vector containing all integers in [low, high] in random order
         std::vector<int> get_vector_ints(int low = 0, int high = 1, int count = 1) noexcept;
 
+        /// @brief Fill a span with random bits
+        /// @details Draws the same values as calling the engine once per element
+        /// @param bits
+        void fill(std::span<std::uint64_t> bits) noexcept;
+
+        /// @brief Fill a span with random integers
+        /// @details Draws the same values as calling get_int once per element
+        /// @param values
+        /// @param low The lower bound of the integers (inclusive).
+        /// @param high The upper bound of the integers (inclusive).
+        void fill(std::span<int> values, int low, int high) noexcept;
+
+        /// @brief Advance the engine by 2^128 draws
+        /// @details Copy a randomizer and jump it once more than the last copy to hand out non-overlapping streams
+        /// @details The mt19937 engine cannot jump, it is reseeded from its own output instead
+        void jump() noexcept;
+
+        /// @brief Derive an independent randomizer for another worker
+        /// @details The child is seeded from one draw of this stream, so children can be split again
+        /// @return A randomizer with the same engine
+        randomizer split();
+
+        /// @brief Get the engine behind the randomizer
+        /// @return
+        rng_engine engine() const noexcept;
+
         /// @brief Seeds the random number generator with the given seed value.
+        /// @details The engines and the bounded mapping are fully specified, so a seed gives the same numbers on every platform and standard library
         /// @param seed The seed value to initialize the random number generator.
         void seed(unsigned long long seed = 0) noexcept;
 
@@ -64,12 +134,23 @@ namespace mazes
         int operator()(int low, int high) noexcept
         {
 
+            if (m_engine_id == rng_engine::XOSHIRO256SS)
+            {
+
+                return to_bounded_int(m_engine, low, high);
+            }
+
             return get_int(low, high);
         }
 
     private:
         class randomizer_impl;
 
+        rng_engine m_engine_id;
+
+        xoshiro256ss m_engine;
+
+        // Only created for the mt19937 engine
         std::unique_ptr<randomizer_impl> m_impl;
     };
 
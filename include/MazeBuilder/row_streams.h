@@ -0,0 +1,186 @@
+#ifndef ROW_STREAMS_H
+#define ROW_STREAMS_H
+
+#include <MazeBuilder/link_masks.h>
+#include <MazeBuilder/randomizer.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace mazes
+{
+
+    /// @file row_streams.h
+    /// @class row_stream
+    /// @brief Counter-based random stream for one row of a maze
+    /// @details The n-th value only depends on (seed, level, row, n), so rows can be carved in any order on any thread
+    /// @details Values are splitmix64 outputs of a key derived from the seed, level, and row
+    class row_stream final
+    {
+
+    public:
+        /// @brief Construct the stream for a row
+        /// @param seed Base seed shared by every row of one maze
+        /// @param level
+        /// @param row
+        row_stream(std::uint64_t seed, unsigned int level, unsigned int row) noexcept
+            : m_key{mix(mix(seed ^ (static_cast<std::uint64_t>(level) << 32 | row)) + GAMMA)}, m_counter{0}
+        {
+        }
+
+        /// @brief Get the next 64 random bits of the stream
+        /// @return
+        std::uint64_t next() noexcept
+        {
+            return mix(m_key + GAMMA * ++m_counter);
+        }
+
+        /// @brief Gets a random integer within a specified range, without modulo bias
+        /// @param low The lower bound of the integer (inclusive).
+        /// @param high The upper bound of the integer (inclusive).
+        /// @return A random integer within the specified range.
+        int operator()(int low, int high) noexcept
+        {
+            return to_bounded_int([this]()
+                                  { return next(); }, low, high);
+        }
+
+    private:
+        static constexpr std::uint64_t GAMMA = 0x9E3779B97F4A7C15ull;
+
+        static constexpr std::uint64_t mix(std::uint64_t z) noexcept
+        {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        std::uint64_t m_key;
+
+        std::uint64_t m_counter;
+    };
+
+    /// @brief Split rows into contiguous bands and carve each band on its own thread
+    /// @tparam F Callable taking the first and one-past-last row of a band
+    /// @param total_rows
+    /// @param threads Number of threads, 0 uses the hardware concurrency
+    /// @param carve
+    /// @return The first row of every band, in order
+    /// @details Every band runs to the end, then the exception of the first band that threw is rethrown
+    template <typename F>
+    std::vector<unsigned int> for_each_row_band(unsigned int total_rows, unsigned int threads, F &&carve)
+    {
+        if (threads == 0)
+        {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        const auto bands = std::max(1u, std::min(threads, total_rows));
+
+        std::vector<unsigned int> firsts;
+        firsts.reserve(bands);
+
+        for (auto b{0u}; b < bands; ++b)
+        {
+            firsts.push_back(static_cast<unsigned int>(static_cast<std::uint64_t>(total_rows) * b / bands));
+        }
+
+        auto last_of = [&firsts, total_rows, bands](unsigned int b)
+        {
+            return (b + 1 < bands) ? firsts[b + 1] : total_rows;
+        };
+
+        // A band that throws must not take the process down, its exception is rethrown once every band is done
+        std::vector<std::exception_ptr> errors(bands);
+
+        auto guarded = [&carve, &errors](unsigned int b, unsigned int first, unsigned int last) noexcept
+        {
+            try
+            {
+                carve(first, last);
+            }
+            catch (...)
+            {
+                errors[b] = std::current_exception();
+            }
+        };
+
+        // Joins the workers on every way out of this scope
+        struct joiner
+        {
+            std::vector<std::thread> threads;
+
+            ~joiner()
+            {
+                for (auto &t : threads)
+                {
+                    if (t.joinable())
+                    {
+                        t.join();
+                    }
+                }
+            }
+        } workers;
+
+        workers.threads.reserve(bands - 1);
+
+        for (auto b{1u}; b < bands; ++b)
+        {
+            try
+            {
+                workers.threads.emplace_back(guarded, b, firsts[b], last_of(b));
+            }
+            catch (const std::system_error &)
+            {
+                // No thread available, carve the band here instead
+                guarded(b, firsts[b], last_of(b));
+            }
+        }
+
+        // The calling thread takes the first band
+        guarded(0u, firsts.front(), last_of(0));
+
+        for (auto &t : workers.threads)
+        {
+            t.join();
+        }
+
+        for (const auto &error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        return firsts;
+    }
+
+    /// @brief Link the first row of every band back to the row above it
+    /// @details Bands only set the north bit of their first row, since the row above belongs to another thread
+    /// @param masks
+    /// @param firsts The first row of every band, as returned by for_each_row_band
+    /// @param columns
+    inline void stitch_row_bands(link_masks &masks, const std::vector<unsigned int> &firsts, unsigned int columns) noexcept
+    {
+        for (size_t b{1}; b < firsts.size(); ++b)
+        {
+            for (auto col{0u}; col < columns; ++col)
+            {
+                const auto index = static_cast<int>(static_cast<std::int64_t>(firsts[b]) * columns + col);
+
+                if (masks.is_linked(index, Direction::NORTH))
+                {
+                    masks.link(index, Direction::NORTH, true);
+                }
+            }
+        }
+    }
+
+} // namespace mazes
+
+#endif // ROW_STREAMS_H
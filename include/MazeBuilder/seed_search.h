@@ -0,0 +1,83 @@
+#ifndef SEED_SEARCH_H
+#define SEED_SEARCH_H
+
+#include <MazeBuilder/configurator.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace mazes
+{
+
+    /// @file seed_search.h
+    /// @class seed_search
+    /// @brief Searches a range of seeds for mazes that meet difficulty targets
+    /// @details Every candidate is generated from the configuration with its own seed, the same maze that create makes from that seed
+    /// @details Candidates are scored from the links, nothing is rendered, each thread reuses one grid and one solver
+    /// @details Threads take seeds in order and stop once enough matches are found, the matches kept are those with the lowest seeds
+    class seed_search final
+    {
+
+    public:
+        /// @brief Thresholds a maze has to meet, bounds are inclusive
+        struct targets
+        {
+            std::int32_t min_solution_length{0};
+
+            std::int32_t max_solution_length{std::numeric_limits<std::int32_t>::max()};
+
+            /// @brief Bounds on dead ends per cell
+            double min_dead_end_ratio{0.0};
+
+            double max_dead_end_ratio{1.0};
+
+            /// @brief Ends of the solution, -1 for the goal is the last cell
+            std::int32_t start_index{0};
+
+            std::int32_t goal_index{-1};
+        };
+
+        /// @brief A seed whose maze meets the targets
+        struct match
+        {
+            unsigned int seed{0};
+
+            std::int32_t solution_length{0};
+
+            double dead_end_ratio{0.0};
+
+            /// @brief Share of cells on the solution plus the dead end ratio, higher is harder
+            double score{0.0};
+        };
+
+        /// @brief Search mazes made from a configuration
+        /// @param config The template of every candidate, its seed is replaced
+        /// @param threads Number of threads, 0 uses the hardware concurrency
+        explicit seed_search(const configurator &config, unsigned int threads = 0) noexcept;
+
+        /// @brief Generate and score the mazes of a range of seeds
+        /// @param first_seed
+        /// @param last_seed One past the last seed
+        /// @param goals
+        /// @param max_matches Stop after this many matches
+        /// @return Matches ranked by score, highest first, then by seed
+        /// @details Throws std::invalid_argument when the configuration has no algorithm, and rethrows the first error of a thread once every thread stopped
+        std::vector<match> run(unsigned int first_seed, unsigned int last_seed, const targets &goals, std::size_t max_matches) const;
+
+        /// @brief Get matches as a JSON array
+        /// @param matches
+        /// @param pretty_print Number of spaces to use for indenting the JSON string
+        /// @return
+        static std::string to_json(const std::vector<match> &matches, int pretty_print = 4);
+
+    private:
+        configurator m_config;
+
+        unsigned int m_threads;
+    };
+} // namespace mazes
+
+#endif // SEED_SEARCH_H
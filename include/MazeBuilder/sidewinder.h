@@ -3,6 +3,8 @@
 
 #include <MazeBuilder/algo_interface.h>
 
+#include <optional>
+
 namespace mazes
 {
 
@@ -16,11 +18,24 @@ namespace mazes
     {
 
     public:
+        /// @brief Construct the serial algorithm, drawing every choice from the randomizer
+        sidewinder() noexcept = default;
+
+        /// @brief Construct the row-parallel algorithm
+        /// @details Each row draws from its own stream keyed by (seed, level, row), the seed being drawn once from the randomizer
+        /// @details The maze is the same for any thread count
+        /// @param threads Number of threads to split rows across, 0 uses the hardware concurrency
+        explicit sidewinder(unsigned int threads) noexcept;
+
         /// @brief Implement the sidewinder maze generation algorithm
         /// @param g
         /// @param rng
         /// @return success or failure
         bool run(grid_interface *g, randomizer &rng) const noexcept override;
+
+    private:
+        // Set when rows are carved in parallel
+        std::optional<unsigned int> m_threads;
     };
 
 }
@@ -0,0 +1,61 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace mazes
+{
+
+    class grid_operations;
+
+    /// @file solver.h
+    /// @class solver
+    /// @brief Finds shortest paths between two cells with a bidirectional breadth-first search over the link masks
+    /// @details The start and the goal each grow a search one level at a time, the smaller frontier goes next, until they meet
+    /// @details Scratch arrays are sized to the grid on the first call and reused, so later queries on the same grid allocate nothing
+    /// @details Cells are marked with a stamp per query instead of clearing the arrays between queries
+    class solver final
+    {
+
+    public:
+        solver() noexcept;
+
+        /// @brief Find a shortest path
+        /// @param ops The grid to walk
+        /// @param start_index
+        /// @param goal_index
+        /// @return The cells from the start to the goal inclusive, empty when there is no path
+        /// @details The span is valid until the next call
+        std::span<const std::int32_t> solve(const grid_operations &ops, std::int32_t start_index, std::int32_t goal_index);
+
+        /// @brief Get the number of cells visited by the last call, from both ends
+        /// @return
+        std::size_t visited() const noexcept { return m_visited; }
+
+    private:
+        // Stamp of the search from the start, the search from the goal uses the next stamp
+        std::uint32_t m_stamp;
+
+        std::size_t m_visited;
+
+        // Per cell, which search reached it, its parent in that search, and its distance from that end
+        std::vector<std::uint32_t> m_marks;
+
+        std::vector<std::int32_t> m_parents;
+
+        std::vector<std::int32_t> m_distances;
+
+        // Frontiers of both searches, and the next frontier
+        std::vector<std::int32_t> m_forward;
+
+        std::vector<std::int32_t> m_backward;
+
+        std::vector<std::int32_t> m_next;
+
+        std::vector<std::int32_t> m_path;
+    };
+} // namespace mazes
+
+#endif // SOLVER_H
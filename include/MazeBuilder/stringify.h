@@ -3,6 +3,12 @@
 
 #include <MazeBuilder/algo_interface.h>
 
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+
 /// @file stringify.h
 /// @namespace mazes
 namespace mazes
@@ -11,11 +17,44 @@ namespace mazes
     class stringify : public algo_interface
     {
     public:
+        /// @brief Render rows one after another on the calling thread
+        stringify() = default;
+
+        /// @brief Render bands of rows in parallel, straight into their slices of the output
+        /// @param threads Number of threads, 0 uses the hardware concurrency
+        /// @details Every row has a known offset in the output, so no locks or concatenation are needed
+        explicit stringify(unsigned int threads) noexcept
+            : m_threads{threads}
+        {
+        }
+
         /// @brief Run the stringify algorithm
         /// @param g The grid to stringify
         /// @param rng The randomizer to use
         /// @return True if successful, false otherwise
         virtual bool run(grid_interface *g, randomizer &rng) const noexcept override;
+
+        /// @brief Write the same text as run straight to a stream, without building the whole string
+        /// @details Only a chunk of rows is held at a time, the grid string is left untouched
+        /// @param g The grid to stringify
+        /// @param os The stream to write to, such as a std::ofstream
+        /// @return True if successful, false when the grid is missing or too large or the stream fails
+        bool run(grid_interface *g, std::ostream &os) const;
+
+        /// @brief Append the top border of a maze that is streamed one row at a time
+        /// @param columns
+        /// @param out Text to append to, including the newline of the border
+        static void render_top_border(unsigned int columns, std::string &out);
+
+        /// @brief Append one finished row of links in the same layout as run, with empty cells
+        /// @details Appending the top border and then every row in order gives the same text as run
+        /// @details The caller owns the text, so a sink can clear and reuse one string for every row
+        /// @param links One link_masks byte per column
+        /// @param out Text to append the wall and floor lines of the row to, including their newlines
+        static void render_row(std::span<const std::uint8_t> links, std::string &out);
+
+    private:
+        std::optional<unsigned int> m_threads;
     };
 }
 
@@ -9,6 +9,7 @@ namespace mazes
 {
     /// @class wavefront_object_helper
     /// @brief Transform a maze into a Wavefront object string
+    /// @details Writes the grid's mesh with obj_writer, use obj_writer directly to stream a large mesh to a file
     class wavefront_object_helper : public algo_interface
     {
     public:
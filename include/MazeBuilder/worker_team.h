@@ -0,0 +1,82 @@
+#ifndef WORKER_TEAM_H
+#define WORKER_TEAM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mazes
+{
+
+    /// @file worker_team.h
+    /// @class worker_team
+    /// @brief Threads that are started once and then share the items of one call after another
+    /// @details The calling thread works alongside the team, so a team of n threads starts n - 1 of its own
+    /// @details Items are taken from a shared counter, and a call returns once every item is done
+    /// @details Writers and searches that run many short rounds keep one team instead of starting threads every round
+    class worker_team final
+    {
+
+    public:
+        /// @brief Start the threads of the team
+        /// @param threads Number of threads including the caller, 0 uses the hardware concurrency
+        /// @details A team that cannot start a thread keeps the ones it has, down to the calling thread alone
+        explicit worker_team(unsigned int threads = 0);
+
+        /// @brief Stop and join the threads
+        ~worker_team();
+
+        worker_team(const worker_team &) = delete;
+
+        worker_team &operator=(const worker_team &) = delete;
+
+        /// @brief Get the number of threads, including the caller
+        /// @return
+        unsigned int size() const noexcept { return static_cast<unsigned int>(m_workers.size()) + 1; }
+
+        /// @brief Run task(i) for every i below count, and wait for all of them
+        /// @param count
+        /// @param task
+        /// @details Every item runs, then the first exception thrown by an item is rethrown
+        void for_each(std::size_t count, const std::function<void(std::size_t)> &task);
+
+    private:
+        void work() noexcept;
+
+        void take_items() noexcept;
+
+        std::vector<std::thread> m_workers;
+
+        // Guards the round, the generation, and the exit flag
+        std::mutex m_mtx;
+
+        std::condition_variable m_start;
+
+        std::condition_variable m_done;
+
+        // Rounds run one at a time
+        std::mutex m_run_mtx;
+
+        const std::function<void(std::size_t)> *m_task;
+
+        std::size_t m_count;
+
+        std::atomic<std::size_t> m_next;
+
+        std::size_t m_generation;
+
+        // Threads of the team still in the current round
+        std::size_t m_busy;
+
+        bool m_exit;
+
+        std::exception_ptr m_error;
+    };
+} // namespace mazes
+
+#endif // WORKER_TEAM_H
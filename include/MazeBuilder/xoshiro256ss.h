@@ -0,0 +1,133 @@
+#ifndef XOSHIRO256SS_H
+#define XOSHIRO256SS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace mazes
+{
+
+    /// @file xoshiro256ss.h
+    /// @class xoshiro256ss
+    /// @brief The xoshiro256** engine, 32 bytes of state and a few instructions per draw
+    /// @details Satisfies UniformRandomBitGenerator, so it also works with the standard library distributions
+    /// @details Reference: Blackman and Vigna, https://prng.di.unimi.it/xoshiro256starstar.c
+    class xoshiro256ss final
+    {
+
+    public:
+        using result_type = std::uint64_t;
+
+        /// @brief Construct from a 64-bit seed
+        /// @param seed Expanded into the full state with splitmix64
+        explicit xoshiro256ss(std::uint64_t seed = 0) noexcept
+        {
+            this->seed(seed);
+        }
+
+        /// @brief Construct from a full state
+        /// @details The state must not be all zeros
+        /// @param state
+        explicit xoshiro256ss(const std::array<std::uint64_t, 4> &state) noexcept
+            : m_state{state}
+        {
+        }
+
+        static constexpr result_type min() noexcept { return std::numeric_limits<result_type>::min(); }
+
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        /// @brief Reset the state from a 64-bit seed
+        /// @param seed Expanded into the full state with splitmix64
+        void seed(std::uint64_t seed) noexcept
+        {
+            for (auto &word : m_state)
+            {
+                seed += 0x9E3779B97F4A7C15ull;
+
+                auto z = seed;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        /// @brief Get the next 64 random bits
+        /// @return
+        result_type operator()() noexcept
+        {
+            const auto result = rotl(m_state[1] * 5, 7) * 9;
+            const auto t = m_state[1] << 17;
+
+            m_state[2] ^= m_state[0];
+            m_state[3] ^= m_state[1];
+            m_state[1] ^= m_state[2];
+            m_state[0] ^= m_state[3];
+
+            m_state[2] ^= t;
+
+            m_state[3] = rotl(m_state[3], 45);
+
+            return result;
+        }
+
+        /// @brief Advance the engine by 2^128 draws
+        /// @details Copies that are jumped a different number of times produce non-overlapping streams
+        void jump() noexcept
+        {
+            static constexpr std::array<std::uint64_t, 4> JUMP{0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+
+            advance(JUMP);
+        }
+
+        /// @brief Advance the engine by 2^192 draws
+        void long_jump() noexcept
+        {
+            static constexpr std::array<std::uint64_t, 4> LONG_JUMP{0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull};
+
+            advance(LONG_JUMP);
+        }
+
+        /// @brief Get the full state
+        /// @return
+        const std::array<std::uint64_t, 4> &state() const noexcept { return m_state; }
+
+        bool operator==(const xoshiro256ss &other) const noexcept = default;
+
+    private:
+        static constexpr std::uint64_t rotl(std::uint64_t x, int k) noexcept
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+
+        void advance(const std::array<std::uint64_t, 4> &polynomial) noexcept
+        {
+            std::array<std::uint64_t, 4> next{};
+
+            for (auto word : polynomial)
+            {
+                for (auto b{0}; b < 64; ++b)
+                {
+                    if (word & (std::uint64_t{1} << b))
+                    {
+                        for (std::size_t i{0}; i < next.size(); ++i)
+                        {
+                            next[i] ^= m_state[i];
+                        }
+                    }
+
+                    this->operator()();
+                }
+            }
+
+            m_state = next;
+        }
+
+        std::array<std::uint64_t, 4> m_state;
+    };
+
+} // namespace mazes
+
+#endif // XOSHIRO256SS_H
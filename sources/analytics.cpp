@@ -0,0 +1,227 @@
+#include <MazeBuilder/analytics.h>
+
+#include <MazeBuilder/enums.h>
+#include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <vector>
+
+using namespace mazes;
+
+namespace
+{
+    constexpr std::uint64_t LOW_BITS = 0x0101010101010101ull;
+
+    // Add the degrees of eight cells packed in a word to the histogram
+    // Each byte is popcounted in place, then the bytes equal to each degree are counted with one more popcount
+    void add_degrees(std::uint64_t word, std::array<std::size_t, 7> &histogram) noexcept
+    {
+        word = word - ((word >> 1) & 0x5555555555555555ull);
+        word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+
+        // Degrees are at most 6, so three bits of each byte hold them
+        const std::uint64_t bits[3]{word & LOW_BITS, (word >> 1) & LOW_BITS, (word >> 2) & LOW_BITS};
+
+        for (auto degree = 0u; degree < histogram.size(); ++degree)
+        {
+            auto equal = LOW_BITS;
+
+            for (auto b = 0u; b < 3; ++b)
+            {
+                equal &= ((degree >> b) & 1u) ? bits[b] : bits[b] ^ LOW_BITS;
+            }
+
+            histogram[degree] += static_cast<std::size_t>(std::popcount(equal));
+        }
+    }
+
+    // Breadth-first search that keeps the visiting order and the parents, returns the farthest cell
+    std::int32_t breadth_first(const link_masks &masks, const std::array<std::int32_t, static_cast<size_t>(Direction::COUNT)> &offsets, std::int32_t root,
+                               std::vector<std::int32_t> &dist, std::vector<std::int32_t> &parent, std::vector<std::int32_t> &order)
+    {
+        std::fill(dist.begin(), dist.end(), -1);
+
+        order.clear();
+        order.push_back(root);
+        dist[static_cast<size_t>(root)] = 0;
+        parent[static_cast<size_t>(root)] = -1;
+
+        for (size_t head = 0; head < order.size(); ++head)
+        {
+            const auto current = order[head];
+
+            for (auto bits = static_cast<unsigned int>(masks.get(current)); bits != 0; bits &= bits - 1)
+            {
+                const auto neighbor = current + offsets[static_cast<size_t>(std::countr_zero(bits))];
+
+                if (dist[static_cast<size_t>(neighbor)] < 0)
+                {
+                    dist[static_cast<size_t>(neighbor)] = dist[static_cast<size_t>(current)] + 1;
+                    parent[static_cast<size_t>(neighbor)] = current;
+                    order.push_back(neighbor);
+                }
+            }
+        }
+
+        // Cells are visited in order of distance
+        return order.back();
+    }
+} // namespace
+
+/// @brief Count degrees, walk the straight runs, then search twice for the diameter
+/// @param ops
+/// @return
+analytics analytics::from(const grid_operations &ops)
+{
+    analytics stats{};
+
+    const auto &masks = ops.get_link_masks();
+    const auto &bytes = masks.data();
+
+    stats.cells = bytes.size();
+
+    if (bytes.empty())
+    {
+        return stats;
+    }
+
+    size_t i = 0;
+
+    for (; i + 8 <= bytes.size(); i += 8)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, bytes.data() + i, sizeof(word));
+
+        add_degrees(word, stats.degree_histogram);
+    }
+
+    for (; i < bytes.size(); ++i)
+    {
+        ++stats.degree_histogram[static_cast<size_t>(std::popcount(static_cast<unsigned int>(bytes[i])))];
+    }
+
+    size_t degree_sum = 0;
+
+    for (size_t degree = 0; degree < stats.degree_histogram.size(); ++degree)
+    {
+        degree_sum += degree * stats.degree_histogram[degree];
+    }
+
+    stats.passages = degree_sum / 2;
+    stats.dead_ends = stats.degree_histogram[1];
+    stats.corridors = stats.degree_histogram[2];
+    stats.junctions = stats.cells - stats.degree_histogram[0] - stats.dead_ends - stats.corridors;
+
+    const auto open_cells = stats.cells - stats.degree_histogram[0];
+    stats.river_factor = (open_cells > 0) ? static_cast<double>(stats.corridors) / static_cast<double>(open_cells) : 0.0;
+
+    auto [rows, columns, levels] = ops.get_dimensions();
+
+    // A link only exists toward a neighbor inside the grid, so the offsets need no bounds checks
+    const auto plane = static_cast<std::int32_t>(rows * columns);
+    const std::array<std::int32_t, static_cast<size_t>(Direction::COUNT)> offsets{-static_cast<std::int32_t>(columns), static_cast<std::int32_t>(columns), 1, -1, plane, -plane};
+
+    // Runs start where a passage leads on along an axis but none leads in, walking them visits each passage once
+    static constexpr std::array<Direction, 3> forward{Direction::SOUTH, Direction::EAST, Direction::UP};
+
+    size_t run_passages = 0;
+
+    for (const auto d : forward)
+    {
+        const auto ahead = to_link_bit_from_direction(d);
+        const auto behind = to_link_bit_from_direction(to_opposite_from_direction(d));
+        const auto step = offsets[static_cast<size_t>(d)];
+
+        for (size_t cell = 0; cell < bytes.size(); ++cell)
+        {
+            if ((bytes[cell] & ahead) == 0 || (bytes[cell] & behind) != 0)
+            {
+                continue;
+            }
+
+            size_t length = 0;
+
+            for (auto at = static_cast<std::int32_t>(cell); bytes[static_cast<size_t>(at)] & ahead; at += step)
+            {
+                ++length;
+            }
+
+            ++stats.straight_runs;
+            run_passages += length;
+            stats.longest_straight_run = std::max(stats.longest_straight_run, length);
+        }
+    }
+
+    for (const auto mask : bytes)
+    {
+        static constexpr std::uint8_t NORTH_SOUTH = to_link_bit_from_direction(Direction::NORTH) | to_link_bit_from_direction(Direction::SOUTH);
+        static constexpr std::uint8_t EAST_WEST = to_link_bit_from_direction(Direction::EAST) | to_link_bit_from_direction(Direction::WEST);
+        static constexpr std::uint8_t UP_DOWN = to_link_bit_from_direction(Direction::UP) | to_link_bit_from_direction(Direction::DOWN);
+
+        stats.straight_corridors += (mask == NORTH_SOUTH || mask == EAST_WEST || mask == UP_DOWN) ? 1u : 0u;
+    }
+
+    stats.mean_straight_run = (stats.straight_runs > 0) ? static_cast<double>(run_passages) / static_cast<double>(stats.straight_runs) : 0.0;
+
+    // The farthest cell from any cell ends a longest path, the farthest cell from there ends it at the other side
+    std::vector<std::int32_t> dist(bytes.size()), parent(bytes.size()), order;
+    order.reserve(bytes.size());
+
+    stats.diameter_start = breadth_first(masks, offsets, 0, dist, parent, order);
+    stats.diameter_end = breadth_first(masks, offsets, stats.diameter_start, dist, parent, order);
+    stats.diameter = dist[static_cast<size_t>(stats.diameter_end)];
+    stats.reachable = order.size();
+
+    // Every pair of cells on both sides of a passage of the tree is joined through that passage
+    if (order.size() > 1)
+    {
+        const auto n = static_cast<std::uint64_t>(order.size());
+
+        std::vector<std::uint32_t> subtree(bytes.size(), 1u);
+
+        // The sum grows with the cube of the cells, a 64-bit integer overflows past about 4.8 million cells in a line
+        long double pair_distances = 0;
+
+        for (auto it = order.rbegin(); it + 1 != order.rend(); ++it)
+        {
+            const auto size = subtree[static_cast<size_t>(*it)];
+
+            subtree[static_cast<size_t>(parent[static_cast<size_t>(*it)])] += size;
+            pair_distances += static_cast<long double>(size) * static_cast<long double>(n - size);
+        }
+
+        stats.mean_path_length = static_cast<double>(pair_distances / (static_cast<long double>(n) * static_cast<long double>(n - 1) / 2));
+    }
+
+    return stats;
+}
+
+std::string analytics::to_json(int pretty_print) const
+{
+    nlohmann::json j;
+
+    j["cells"] = cells;
+    j["passages"] = passages;
+    j["degree_histogram"] = degree_histogram;
+    j["dead_ends"] = dead_ends;
+    j["corridors"] = corridors;
+    j["straight_corridors"] = straight_corridors;
+    j["junctions"] = junctions;
+    j["river_factor"] = river_factor;
+    j["straight_runs"] = straight_runs;
+    j["mean_straight_run"] = mean_straight_run;
+    j["longest_straight_run"] = longest_straight_run;
+    j["reachable"] = reachable;
+    j["diameter"] = diameter;
+    j["diameter_start"] = diameter_start;
+    j["diameter_end"] = diameter_end;
+    j["mean_path_length"] = mean_path_length;
+
+    return j.dump(pretty_print);
+}
@@ -1,19 +1,25 @@
 #include <MazeBuilder/binary_tree.h>
 
-#include <MazeBuilder/cell.h>
 #include <MazeBuilder/grid_interface.h>
 #include <MazeBuilder/grid_operations.h>
 #include <MazeBuilder/lab.h>
 #include <MazeBuilder/randomizer.h>
+#include <MazeBuilder/row_streams.h>
 
-#include <functional>
-#include <memory>
-#include <random>
-#include <stack>
-#include <vector>
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <limits>
 
 using namespace mazes;
 
+/// @brief
+/// @param threads
+binary_tree::binary_tree(unsigned int threads) noexcept
+    : m_threads{threads}
+{
+}
+
 /// @brief Generate maze in the direction of NORTH and EAST, starting in bottom - left corner of a 2D grid
 /// @param g
 /// @param rng
@@ -22,42 +28,102 @@ bool binary_tree::run(grid_interface *g, randomizer &rng) const noexcept
 {
     using namespace std;
 
-    const auto &grid_ops = g->operations();
+    if (!g)
+    {
+        return false;
+    }
+
+    auto &grid_ops = g->operations();
 
     // Use iterator-based approach instead of get_cells() for large grid efficiency
     auto [rows, columns, levels] = grid_ops.get_dimensions();
 
-    // Process each cell position without materializing all cells
-    for (auto level{0u}; level < levels; ++level)
+    if (m_threads.has_value())
     {
-        for (auto row{0u}; row < rows; ++row)
+        auto &masks = grid_ops.get_link_masks();
+
+        // Two draws from the shared randomizer key every row stream, the high and low halves of the seed
+        const auto seed = static_cast<std::uint64_t>(rng(0, numeric_limits<int>::max())) << 32 | static_cast<std::uint32_t>(rng(0, numeric_limits<int>::max()));
+
+        // Rows of every level are carved as one sequence, row units never link across levels
+        auto carve = [&masks, seed, rows, columns](unsigned int first, unsigned int last)
         {
-            for (auto col{0u}; col < columns; ++col)
+            for (auto unit{first}; unit < last; ++unit)
             {
-                if (auto c = grid_ops.search(static_cast<int>(level * (rows * columns) + row * columns + col)))
+                const auto level = unit / rows, row = unit % rows;
+
+                row_stream stream{seed, level, row};
+
+                for (auto col{0u}; col < columns; ++col)
                 {
-                    vector<shared_ptr<cell>> neighbors;
+                    const auto index = static_cast<int>(static_cast<std::int64_t>(unit) * columns + col);
 
-                    if (auto north_cell = grid_ops.get_north(cref(c)))
+                    array<Direction, 2> neighbors{};
+                    int neighbor_count{0};
+
+                    if (row > 0)
                     {
-                        neighbors.emplace_back(north_cell);
+                        neighbors[static_cast<size_t>(neighbor_count++)] = Direction::NORTH;
                     }
 
-                    if (auto east_cell = grid_ops.get_east(cref(c)))
+                    if (col + 1 < columns)
                     {
-                        neighbors.emplace_back(east_cell);
+                        neighbors[static_cast<size_t>(neighbor_count++)] = Direction::EAST;
                     }
 
-                    // Skip linking stage if we have no neighbors, prevent RNG out-of-bounds
-                    if (!neighbors.empty())
+                    if (neighbor_count > 0)
                     {
-                        if (auto neighbor = neighbors.at(static_cast<int>(rng(0, static_cast<int>(neighbors.size()) - 1))))
-                        {
+                        const auto dir = neighbors[static_cast<size_t>(stream(0, neighbor_count - 1))];
 
-                            lab::link(c, neighbor, true);
-                        }
+                        // The row above the first row of a band belongs to another thread, it is linked back after the join
+                        masks.link(index, dir, !(dir == Direction::NORTH && unit == first));
                     }
                 }
+            }
+        };
+
+        try
+        {
+            const auto firsts = for_each_row_band(rows * levels, m_threads.value(), carve);
+
+            stitch_row_bands(masks, firsts, columns);
+        }
+        catch (const std::exception &)
+        {
+
+            return false;
+        }
+
+        return true;
+    }
+
+    // Process each cell position by index, no cell objects are touched
+    for (auto level{0u}; level < levels; ++level)
+    {
+        for (auto row{0u}; row < rows; ++row)
+        {
+            for (auto col{0u}; col < columns; ++col)
+            {
+                const auto index = static_cast<int>(level * (rows * columns) + row * columns + col);
+
+                array<Direction, 2> neighbors{};
+                int neighbor_count{0};
+
+                if (grid_ops.get_neighbor_index(index, Direction::NORTH) >= 0)
+                {
+                    neighbors[static_cast<size_t>(neighbor_count++)] = Direction::NORTH;
+                }
+
+                if (grid_ops.get_neighbor_index(index, Direction::EAST) >= 0)
+                {
+                    neighbors[static_cast<size_t>(neighbor_count++)] = Direction::EAST;
+                }
+
+                // Skip linking stage if we have no neighbors, prevent RNG out-of-bounds
+                if (neighbor_count > 0)
+                {
+                    lab::link(grid_ops, index, neighbors[static_cast<size_t>(rng(0, neighbor_count - 1))], true);
+                }
             } // end col loop
         } // end row loop
     } // end level loop
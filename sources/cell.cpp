@@ -1,131 +1,59 @@
 #include <MazeBuilder/cell.h>
 
-#include <mutex>
+#include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
+
+#include <algorithm>
 
 using namespace mazes;
 
 /// @brief
 /// @param index 0
 cell::cell(std::int32_t index)
-    : m_index{index}, m_links{}
+    : cell::cell(index, nullptr)
 {
 }
 
-// Destructor
-cell::~cell()
+/// @brief
+/// @param index
+/// @param owner
+cell::cell(std::int32_t index, grid_operations *owner)
+    : m_links{}, m_owner{owner}, m_index{index}
 {
-
-    std::unique_lock<std::shared_mutex> lock(m_links_mutex);
-
-    m_links.clear();
 }
 
-// Copy Constructor
-cell::cell(const cell &other)
-    : m_index(other.m_index)
-{
-
-    // Copy links
-    std::unique_lock<std::shared_mutex> lock(other.m_links_mutex);
+// Destructor
+cell::~cell() = default;
 
-    m_links = other.m_links;
-}
+// Copy Constructor
+cell::cell(const cell &other) = default;
 
 // Copy Assignment Operator
-cell &cell::operator=(const cell &other)
-{
-
-    if (this == &other)
-    {
-
-        return *this;
-    }
-
-    // Copy index
-    m_index = other.m_index;
-
-    // Copy links
-    {
-        std::scoped_lock lock(m_links_mutex, other.m_links_mutex);
-
-        m_links = other.m_links;
-    }
-
-    return *this;
-}
+cell &cell::operator=(const cell &other) = default;
 
 // Move Constructor
-cell::cell(cell &&other) noexcept
-    : m_index(other.m_index)
-{
-
-    // Move links
-    std::unique_lock<std::shared_mutex> lock(other.m_links_mutex);
-
-    m_links = std::move(other.m_links);
-}
+cell::cell(cell &&other) noexcept = default;
 
 // Move Assignment Operator
-cell &cell::operator=(cell &&other) noexcept
-{
-    if (this == &other)
-    {
+cell &cell::operator=(cell &&other) noexcept = default;
 
-        return *this;
-    }
-
-    // Move index
-    m_index = other.m_index;
-
-    // Move links
+int cell::direction_to(const std::shared_ptr<cell> &other) const noexcept
+{
+    if (!m_owner || !other || other->m_owner != m_owner)
     {
-        std::scoped_lock lock(m_links_mutex, other.m_links_mutex);
-
-        m_links = std::move(other.m_links);
+        return -1;
     }
 
-    return *this;
-}
-
-bool cell::has_key(const std::shared_ptr<cell> &c)
-{
+    const auto dir = m_owner->get_link_masks().direction_between(m_index, other->m_index);
 
-    std::lock_guard<std::shared_mutex> lock(m_links_mutex);
-
-    for (const auto &[weak_cell, _] : m_links)
-    {
-        if (auto shared_cell = weak_cell.lock())
-        {
-            if (shared_cell == c)
-            {
-                return true;
-            }
-        }
-    }
-    return false;
+    return dir ? static_cast<int>(*dir) : -1;
 }
 
 void cell::cleanup_links()
 {
-    // Create a temporary map to hold non-expired links
-    std::unordered_map<std::weak_ptr<cell>, bool, weak_ptr_hash, weak_ptr_equal> valid_links;
-
-    std::unique_lock<std::shared_mutex> lock(m_links_mutex);
-
-    // Identify and collect non-expired links
-    for (const auto &pair : m_links)
-    {
-        if (!pair.first.expired())
-        {
-            valid_links.insert(pair);
-        }
-    }
-
-    // If we have fewer valid links than total links, replace the map
-    if (valid_links.size() < m_links.size())
-    {
-        m_links = std::move(valid_links);
-    }
+    m_links.erase(std::remove_if(m_links.begin(), m_links.end(), [](const auto &w)
+                                 { return w.expired(); }),
+                  m_links.end());
 }
 
 void cell::add_link(const std::shared_ptr<cell> &other)
@@ -136,21 +64,16 @@ void cell::add_link(const std::shared_ptr<cell> &other)
         return;
     }
 
-    std::unique_lock<std::shared_mutex> lock(m_links_mutex);
-    m_links.insert_or_assign(std::weak_ptr<cell>(other), true);
+    if (auto dir = direction_to(other); dir >= 0)
+    {
+        m_owner->get_link_masks().link(m_index, static_cast<Direction>(dir), false);
+
+        return;
+    }
 
-    // Instead of calling cleanup_links which would require another lock,
-    // we'll remove any expired links while we already have the lock
-    for (auto it = m_links.begin(); it != m_links.end();)
+    if (!is_linked(other))
     {
-        if (it->first.expired())
-        {
-            it = m_links.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
+        m_links.emplace_back(other);
     }
 }
 
@@ -162,35 +85,43 @@ void cell::remove_link(const std::shared_ptr<cell> &other)
         return;
     }
 
-    std::unique_lock<std::shared_mutex> lock(m_links_mutex);
-    m_links.erase(std::weak_ptr<cell>(other));
-
-    // Clean up any expired links while we have the lock
-    for (auto it = m_links.begin(); it != m_links.end();)
+    if (auto dir = direction_to(other); dir >= 0)
     {
-        if (it->first.expired())
-        {
-            it = m_links.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
+        m_owner->get_link_masks().unlink(m_index, static_cast<Direction>(dir), false);
+
+        return;
     }
+
+    m_links.erase(std::remove_if(m_links.begin(), m_links.end(), [&other](const auto &w)
+                                 { return w.expired() || w.lock() == other; }),
+                  m_links.end());
 }
 
 std::vector<std::pair<std::shared_ptr<cell>, bool>> cell::get_links() const
 {
     std::vector<std::pair<std::shared_ptr<cell>, bool>> shared_links;
 
-    std::shared_lock<std::shared_mutex> lock(m_links_mutex);
-    shared_links.reserve(m_links.size());
+    if (m_owner)
+    {
+        const auto &masks = m_owner->get_link_masks();
 
-    for (const auto &[weak_cell, linked] : m_links)
+        for (auto d{0}; d < static_cast<int>(Direction::COUNT); ++d)
+        {
+            if (masks.is_linked(m_index, static_cast<Direction>(d)))
+            {
+                if (auto shared_cell = m_owner->search(masks.neighbor_index(m_index, static_cast<Direction>(d))))
+                {
+                    shared_links.emplace_back(std::move(shared_cell), true);
+                }
+            }
+        }
+    }
+
+    for (const auto &weak_cell : m_links)
     {
         if (auto shared_cell = weak_cell.lock())
         {
-            shared_links.emplace_back(shared_cell, linked);
+            shared_links.emplace_back(std::move(shared_cell), true);
         }
     }
 
@@ -199,8 +130,19 @@ std::vector<std::pair<std::shared_ptr<cell>, bool>> cell::get_links() const
 
 bool cell::is_linked(const std::shared_ptr<cell> &c)
 {
+    if (!c)
+    {
 
-    return has_key(c);
+        return false;
+    }
+
+    if (auto dir = direction_to(c); dir >= 0)
+    {
+        return m_owner->get_link_masks().is_linked(m_index, static_cast<Direction>(dir));
+    }
+
+    return std::any_of(m_links.cbegin(), m_links.cend(), [&c](const auto &w)
+                       { return w.lock() == c; });
 }
 
 std::int32_t cell::get_index() const noexcept
@@ -212,3 +154,13 @@ void cell::set_index(std::int32_t next_index) noexcept
 {
     this->m_index = next_index;
 }
+
+grid_operations *cell::get_owner() const noexcept
+{
+    return this->m_owner;
+}
+
+void cell::set_owner(grid_operations *owner) noexcept
+{
+    this->m_owner = owner;
+}
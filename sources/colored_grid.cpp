@@ -2,9 +2,11 @@
 
 #include <MazeBuilder/cell.h>
 #include <MazeBuilder/distances.h>
-#include <MazeBuilder/grid.h>
+#include <MazeBuilder/flat_grid.h>
 #include <MazeBuilder/grid_operations.h>
 
+#include <algorithm>
+#include <exception>
 #include <functional>
 #include <string>
 
@@ -19,7 +21,7 @@ using namespace mazes;
 /// @param cols 1
 /// @param levels 1
 colored_grid::colored_grid(unsigned int rows, unsigned int cols, unsigned int levels)
-    : m_grid{std::make_unique<grid>(rows, cols, levels)}, m_distances{std::make_shared<distances>(rows * cols)}
+    : m_distances{}, m_max_distance{0}, m_grid{std::make_unique<flat_grid>(rows, cols, levels)}
 {
 }
 
@@ -62,18 +64,33 @@ colored_grid::colored_grid(unsigned int rows, unsigned int cols, unsigned int le
 
 std::string colored_grid::contents_of(const std::shared_ptr<cell> &c) const noexcept
 {
-    if (m_distances)
+
+    if (!c)
     {
 
-        if (m_distances->contains(c->get_index()))
-        {
+        return m_grid->contents_of(c);
+    }
+
+    return contents_at(c->get_index());
+}
+
+std::string colored_grid::contents_at(int index) const noexcept
+{
+
+    if (index >= 0 && static_cast<size_t>(index) < m_distances.size() && m_distances[static_cast<size_t>(index)] >= 0)
+    {
 
-            return std::to_string(m_distances->operator[](c->get_index()));
-        }
+        return std::to_string(m_distances[static_cast<size_t>(index)]);
     }
 
     // Fall back to default representation if no distance info available
-    return m_grid->contents_of(c);
+    return m_grid->contents_at(index);
+}
+
+bool colored_grid::has_contents() const noexcept
+{
+
+    return !m_distances.empty();
 }
 
 std::uint32_t colored_grid::background_color_for(const std::shared_ptr<cell> &c) const noexcept
@@ -87,22 +104,43 @@ std::uint32_t colored_grid::background_color_for(const std::shared_ptr<cell> &c)
         return m_grid->background_color_for(cref(c));
     }
 
-    const auto &d = this->m_distances->path_to(m_grid, c->get_index());
+    return background_color_at(c->get_index());
+}
+
+std::uint32_t colored_grid::background_color_at(int index) const noexcept
+{
 
-    if (!d)
+    if (index >= 0 && static_cast<size_t>(index) < m_distances.size() && m_distances[static_cast<size_t>(index)] >= 0)
     {
 
-        return m_grid->background_color_for(cref(c));
+        return distances::ramp_color(m_distances[static_cast<size_t>(index)], m_max_distance);
     }
 
-    auto max = d->max();
+    return m_grid->background_color_at(index);
+}
+
+bool colored_grid::has_background_colors() const noexcept
+{
+
+    return !m_distances.empty();
+}
+
+/// @brief One breadth-first search from the root, every cell is then colored from the stored field
+/// @param root_index
+void colored_grid::calculate_distances(int root_index) noexcept
+{
 
-    int distance1 = d->operator[](max.first);
+    try
+    {
+        m_distances = distances::field(m_grid->operations(), root_index);
 
-    float intensity = static_cast<float>(10 - distance1) / 10;
-    int dark = static_cast<int>(255 * intensity);
-    int bright = 128 + static_cast<int>(127 * intensity);
-    return (dark << 16) | (bright << 8) | dark;
+        m_max_distance = m_distances.empty() ? 0 : std::max(0, *std::max_element(m_distances.cbegin(), m_distances.cend()));
+    }
+    catch (const std::exception &)
+    {
+        m_distances.clear();
+        m_max_distance = 0;
+    }
 }
 
 // Delegate to embedded grid
@@ -1,18 +1,20 @@
 #include <MazeBuilder/dfs.h>
 
-#include <MazeBuilder/cell.h>
-#include <MazeBuilder/grid.h>
-#include <MazeBuilder/lab.h>
+#include <MazeBuilder/grid_interface.h>
+#include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
 #include <MazeBuilder/randomizer.h>
 
-#include <algorithm>
-#include <iterator>
-#include <stack>
-#include <unordered_set>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
 
 using namespace mazes;
 
 /// @brief Generates maze structure by linking and manipulating the cells
+/// @details Iterative recursive-backtracker: the index stack and visited bitset are sized once, nothing is allocated while carving
 /// @param g the grid to generate the maze on
 /// @param rng the randomizer to use for selecting neighbors
 /// @return
@@ -21,61 +23,92 @@ bool dfs::run(grid_interface *g, randomizer &rng) const noexcept
 
     using namespace std;
 
-    const auto &grid_ops = g->operations();
+    if (!g)
+    {
+        return false;
+    }
+
+    auto &grid_ops = g->operations();
 
-    // For large grids with lazy cell creation, we need to calculate total potential cells
     auto [rows, columns, levels] = grid_ops.get_dimensions();
-    int total_possible_cells = static_cast<int>(rows * columns * levels);
+    const auto total_cells = static_cast<size_t>(rows) * columns * levels;
 
-    if (total_possible_cells <= 0)
+    if (total_cells == 0 || total_cells > static_cast<size_t>(numeric_limits<int>::max()))
     {
         return false;
     }
 
-    // Start with a random cell index, cell will be created lazily
-    int start_index = rng(0, total_possible_cells - 1);
-    auto start = grid_ops.search(start_index);
+    // Links are written straight into the grid's masks, no virtual call per step
+    auto &masks = grid_ops.get_link_masks();
 
-    if (!start)
+    if (static_cast<size_t>(masks.size()) != total_cells)
     {
         return false;
     }
 
-    stack<shared_ptr<cell>> stack_of_cells;
-    unordered_set<shared_ptr<cell>> visited_cells;
+    // Start with a random cell index
+    const int start_index = rng(0, static_cast<int>(total_cells) - 1);
 
-    stack_of_cells.push(start);
-    visited_cells.insert(start);
+    // The stack can never hold more than every cell once, pages are only touched as it grows
+    auto stack_of_cells = make_unique_for_overwrite<int[]>(total_cells);
+    size_t top{0};
 
-    while (!stack_of_cells.empty())
+    // One bit per cell
+    vector<uint64_t> visited_cells((total_cells + 63) / 64, 0);
+
+    auto visit = [&visited_cells](int index)
+    {
+        visited_cells[static_cast<size_t>(index) >> 6] |= uint64_t{1} << (index & 63);
+    };
+
+    auto is_visited = [&visited_cells](int index)
     {
-        auto current_cell = stack_of_cells.top();
+        return (visited_cells[static_cast<size_t>(index) >> 6] >> (index & 63)) & 1u;
+    };
 
-        auto current_neighbors = grid_ops.get_neighbors(current_cell);
+    stack_of_cells[top++] = start_index;
+    visit(start_index);
 
-        // Filter out visited neighbors - use proper visited tracking
-        vector<shared_ptr<cell>> unvisited_neighbors;
+    // Planar neighbors in north, south, east, west order, the order the picks are drawn in
+    static constexpr array<Direction, 4> planar{Direction::NORTH, Direction::SOUTH, Direction::EAST, Direction::WEST};
 
-        copy_if(current_neighbors.begin(), current_neighbors.end(),
-                back_inserter(unvisited_neighbors), [&visited_cells](const auto &n)
-                { return n && visited_cells.find(n) == visited_cells.end(); });
+    // Unvisited neighbors of the current cell, fixed slots reused every step
+    array<Direction, static_cast<size_t>(Direction::COUNT)> unvisited_neighbors{};
+    array<int, static_cast<size_t>(Direction::COUNT)> unvisited_indices{};
 
-        if (unvisited_neighbors.empty())
+    while (top > 0)
+    {
+        const int current_index = stack_of_cells[top - 1];
+
+        int unvisited_count{0};
+
+        for (auto dir : planar)
         {
-            stack_of_cells.pop();
+            const int n = masks.neighbor_index(current_index, dir);
+
+            if (n >= 0 && !is_visited(n))
+            {
+                unvisited_neighbors[static_cast<size_t>(unvisited_count)] = dir;
+                unvisited_indices[static_cast<size_t>(unvisited_count)] = n;
+                ++unvisited_count;
+            }
         }
-        else
-        {
-            const auto &random_index = rng(0, static_cast<int>(unvisited_neighbors.size()) - 1);
-            const auto &neighbor = unvisited_neighbors.at(random_index);
 
-            // Use the lab class for linking
-            lab::link(current_cell, neighbor, true);
+        if (unvisited_count == 0)
+        {
+            --top;
 
-            // Mark neighbor as visited and add to stack
-            visited_cells.insert(neighbor);
-            stack_of_cells.push(neighbor);
+            continue;
         }
+
+        const auto pick = static_cast<size_t>(rng(0, unvisited_count - 1));
+        const int neighbor = unvisited_indices[pick];
+
+        masks.link(current_index, unvisited_neighbors[pick], true);
+
+        // Mark neighbor as visited and add to stack
+        visit(neighbor);
+        stack_of_cells[top++] = neighbor;
     }
 
     return true;
@@ -2,14 +2,13 @@
 
 #include <MazeBuilder/cell.h>
 #include <MazeBuilder/distances.h>
-#include <MazeBuilder/grid.h>
+#include <MazeBuilder/flat_grid.h>
 #include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/parallel_bfs.h>
 
 #include <algorithm>
-#include <deque>
-#include <numeric>
+#include <limits>
 #include <stdexcept>
-#include <unordered_map>
 
 using namespace mazes;
 
@@ -18,21 +17,36 @@ using namespace mazes;
 /// @param cols 1
 /// @param levels 1
 distance_grid::distance_grid(unsigned int rows, unsigned int cols, unsigned int levels)
-    : m_grid{std::make_unique<grid>(rows, cols, levels)}
+    : m_grid{std::make_unique<flat_grid>(rows, cols, levels)}
 {
 }
 
 std::string distance_grid::contents_of(std::shared_ptr<cell> const &c) const noexcept
 {
 
-    if (m_distances && c)
+    if (!c)
     {
 
+        return m_grid->contents_of(c);
+    }
+
+    return contents_at(c->get_index());
+}
+
+std::string distance_grid::contents_at(int index) const noexcept
+{
+
+    if (m_distances)
+    {
+
+        // Read through a const reference, rows can be rendered on several threads at once
+        const distances &dists = *m_distances;
+
         // Check if the cell exists in our distance map
-        if (m_distances->contains(c->get_index()))
+        if (dists.contains(index))
         {
 
-            const auto d = m_distances->operator[](c->get_index());
+            const auto d = dists[index];
             if (d >= 0)
             {
 
@@ -42,13 +56,48 @@ std::string distance_grid::contents_of(std::shared_ptr<cell> const &c) const noe
     }
 
     // Fall back to default representation if no distance info available
-    return m_grid->contents_of(c);
+    return m_grid->contents_at(index);
+}
+
+bool distance_grid::has_contents() const noexcept
+{
+
+    return m_distances != nullptr;
 }
 
 std::uint32_t distance_grid::background_color_for(std::shared_ptr<cell> const &c) const noexcept
 {
 
-    return m_grid->background_color_for(cref(c));
+    if (!c || !m_distances)
+    {
+
+        return m_grid->background_color_for(cref(c));
+    }
+
+    return background_color_at(c->get_index());
+}
+
+std::uint32_t distance_grid::background_color_at(int index) const noexcept
+{
+
+    if (m_distances)
+    {
+        const distances &dists = *m_distances;
+
+        if (dists.contains(index))
+        {
+
+            return distances::ramp_color(dists[index], m_max_distance);
+        }
+    }
+
+    return m_grid->background_color_at(index);
+}
+
+bool distance_grid::has_background_colors() const noexcept
+{
+
+    return m_distances != nullptr;
 }
 
 std::string distance_grid::to_base36(int value) const
@@ -71,7 +120,7 @@ std::string distance_grid::to_base36(int value) const
     return result;
 }
 
-/// @brief
+/// @brief Compute the distance of every reachable cell from the start
 /// @param start_index
 /// @param end_index
 void distance_grid::calculate_distances(int start_index, int end_index) noexcept
@@ -81,80 +130,27 @@ void distance_grid::calculate_distances(int start_index, int end_index) noexcept
     {
         const auto &grid_ops = m_grid->operations();
 
-        auto start_cell = grid_ops.search(start_index);
-        if (!start_cell)
+        const auto total_cells = grid_ops.num_cells();
+
+        if (start_index < 0 || start_index >= total_cells)
         {
             throw std::runtime_error("Invalid start cell index.");
         }
 
-        // Create distances from start cell to all reachable cells
-        m_distances = std::make_shared<distances>(start_cell->get_index());
-        if (!m_distances)
+        // One breadth-first search over the link masks fills a dense field
+        // If end_index is specified (not -1), cells past the range end_index - start_index are left out
+        const auto max_distance = (end_index == -1) ? std::numeric_limits<std::int32_t>::max() : end_index - start_index;
+
+        if (m_distance_threads == 1)
         {
-            throw std::runtime_error("Failed to create distances object.");
+            m_distances = std::make_shared<distances>(start_index, distances::field(grid_ops, start_index, max_distance));
         }
-
-        // Calculate distances from start cell to reachable cells using BFS
-        // Respect the end_index range if specified
-        std::unordered_map<int32_t, bool> visited;
-        std::deque<int32_t> queue;
-
-        queue.push_back(start_index);
-        visited[start_index] = true;
-        m_distances->set(start_index, 0);
-
-        while (!queue.empty())
+        else
         {
-            int32_t current_index = queue.front();
-            queue.pop_front();
-
-            auto current_cell = grid_ops.search(current_index);
-            if (!current_cell)
-                continue;
-
-            int current_distance = (*m_distances)[current_index];
-
-            // If end_index is specified (not -1) and we've reached it, stop processing
-            if (end_index != -1 && current_distance >= (end_index - start_index))
-            {
-                continue;
-            }
-
-            // Get all neighbors
-            auto neighbors = grid_ops.get_neighbors(current_cell);
-            for (const auto &neighbor : neighbors)
-            {
-                if (!neighbor)
-                    continue;
-
-                int32_t neighbor_index = neighbor->get_index();
-
-                // Skip if already visited
-                if (visited.find(neighbor_index) != visited.end())
-                {
-                    continue;
-                }
-
-                // Only follow passages that exist (cells that are linked)
-                if (!current_cell->is_linked(neighbor))
-                {
-                    continue;
-                }
-
-                int next_distance = current_distance + 1;
-
-                // If end_index is specified, don't exceed the distance range
-                if (end_index != -1 && next_distance > (end_index - start_index))
-                {
-                    continue;
-                }
-
-                // Mark as visited and set distance
-                visited[neighbor_index] = true;
-                m_distances->set(neighbor_index, next_distance);
-                queue.push_back(neighbor_index);
-            }
+            m_distances = std::make_shared<distances>(start_index, parallel_bfs{m_distance_threads}.run(grid_ops, start_index, max_distance));
         }
+
+        m_max_distance = m_distances->max().second;
     }
     catch (const std::exception &)
     {
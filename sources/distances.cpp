@@ -1,176 +1,231 @@
 #include <MazeBuilder/distances.h>
 
-#include <MazeBuilder/cell.h>
 #include <MazeBuilder/grid_interface.h>
 #include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
+#include <MazeBuilder/solver.h>
 
-#include <deque>
-
-#if defined(MAZE_DEBUG)
-#include <iostream>
-#endif
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <exception>
+#include <utility>
 
 using namespace mazes;
 
+namespace
+{
+    // Breadth-first search from the root over the link masks, dist is sized to the grid and filled with -1
+    // The frontier is one array allocated up front, every cell enters it at most once so it never wraps
+    void breadth_first(const grid_operations &ops, std::int32_t root_index, std::int32_t max_distance, std::vector<std::int32_t> &dist)
+    {
+        const auto &masks = ops.get_link_masks();
+
+        auto [rows, columns, levels] = ops.get_dimensions();
+
+        // A link only exists toward a neighbor inside the grid, so the offsets need no bounds checks
+        const auto plane = static_cast<std::int32_t>(rows * columns);
+        const std::array<std::int32_t, static_cast<size_t>(Direction::COUNT)> offsets{-static_cast<std::int32_t>(columns), static_cast<std::int32_t>(columns), 1, -1, plane, -plane};
+
+        std::vector<std::int32_t> frontier(dist.size());
+        size_t head = 0, tail = 0;
+
+        frontier[tail++] = root_index;
+        dist[static_cast<size_t>(root_index)] = 0;
+
+        while (head < tail)
+        {
+            const auto current = frontier[head++];
+            const auto current_distance = dist[static_cast<size_t>(current)];
+
+            if (current_distance >= max_distance)
+            {
+                continue;
+            }
+
+            for (auto bits = static_cast<unsigned int>(masks.get(current)); bits != 0; bits &= bits - 1)
+            {
+                const auto neighbor = current + offsets[static_cast<size_t>(std::countr_zero(bits))];
+
+                if (dist[static_cast<size_t>(neighbor)] < 0)
+                {
+                    dist[static_cast<size_t>(neighbor)] = current_distance + 1;
+                    frontier[tail++] = neighbor;
+                }
+            }
+        }
+    }
+
+    // Returned for cells without a distance
+    constexpr int NO_DISTANCE = -1;
+} // namespace
+
 distances::distances(int32_t root_index)
-    : m_root_index(root_index)
+    : m_cells{}, m_root_index(root_index), m_outside{NO_DISTANCE}
+{
+    set(root_index, 0);
+}
+
+distances::distances(int32_t root_index, std::vector<std::int32_t> &&field) noexcept
+    : m_cells{std::move(field)}, m_root_index(root_index), m_outside{NO_DISTANCE}
 {
-    m_cells.insert_or_assign(root_index, 0);
 }
 
+/// @brief Cells past the end of the field are added as it grows
+/// @param index
+/// @return
 int &distances::operator[](int32_t index) noexcept
 {
-    return m_cells[index];
+    if (!contains(index))
+    {
+        set(index, 0);
+    }
+
+    // Negative indices, and cells the field could not grow to hold, get a slot outside of the field
+    if (index < 0 || static_cast<size_t>(index) >= m_cells.size())
+    {
+        m_outside = NO_DISTANCE;
+
+        return m_outside;
+    }
+
+    return m_cells[static_cast<size_t>(index)];
 }
 
 const int &distances::operator[](int32_t index) const noexcept
 {
-    return m_cells.at(index);
+    return contains(index) ? m_cells[static_cast<size_t>(index)] : NO_DISTANCE;
 }
 
 void distances::set(int32_t index, int distance) noexcept
 {
-    m_cells[index] = distance;
+    if (index < 0)
+    {
+        return;
+    }
+
+    try
+    {
+        if (static_cast<size_t>(index) >= m_cells.size())
+        {
+            m_cells.resize(static_cast<size_t>(index) + 1, -1);
+        }
+
+        m_cells[static_cast<size_t>(index)] = distance;
+    }
+    catch (const std::exception &)
+    {
+    }
 }
 
 bool distances::contains(int32_t index) const noexcept
 {
-    return m_cells.find(index) != m_cells.end();
+    return index >= 0 && static_cast<size_t>(index) < m_cells.size() && m_cells[static_cast<size_t>(index)] >= 0;
 }
 
-/// @brief Implementation of breadth-first search
+/// @brief Search from the root and the goal until they meet, keep the cells on the path
 /// @param goal_index
 /// @param g
 /// @return
 std::shared_ptr<distances> distances::path_to(std::unique_ptr<grid_interface> const &g, int32_t goal_index) const noexcept
 {
-    // Create a new distances object to store the path
-    auto path = std::make_shared<distances>(m_root_index);
-
-    // If the goal index is the same as the root index, return path with just the root
-    if (goal_index == m_root_index)
+    try
     {
-        return path;
-    }
-
-    // Parent map to reconstruct the path
-    std::unordered_map<int32_t, int32_t> parent;
-    std::unordered_map<int32_t, bool> visited;
-
-    // BFS queue
-    std::deque<int32_t> q;
-    q.push_back(m_root_index);
-    visited[m_root_index] = true;
-    parent[m_root_index] = -1;
-
-    static constexpr auto MAX_ITERATIONS = 1000000;
-#if defined(MAZE_DEBUG)
-    auto current_iteration = 0;
-#endif
-
-    // Get the grid operations interface
-    auto &ops = g->operations();
-
-    while (!q.empty())
-    {
-#if defined(MAZE_DEBUG)
-        if (current_iteration++ > MAX_ITERATIONS)
+        if (!g)
         {
-            std::cerr << "Error: path_to exceeded maximum iterations." << std::endl;
-            return path;
+            return std::make_shared<distances>(m_root_index);
         }
-#endif
-
-        int32_t current_index = q.front();
-        q.pop_front();
-
-        // If we reached the goal, reconstruct the path
-        if (current_index == goal_index)
-        {
-            // Reconstruct path from goal to root
-            std::vector<int32_t> path_indices;
-            int32_t step = goal_index;
 
-            while (step != -1)
-            {
-                path_indices.push_back(step);
-                step = parent[step];
-            }
+        const auto &ops = g->operations();
 
-            // Set distances in the path (distance 0 for root, increasing towards goal)
-            for (size_t i = 0; i < path_indices.size(); ++i)
-            {
-                int distance = static_cast<int>(path_indices.size() - 1 - i);
-                path->set(path_indices[i], distance);
-            }
+        solver s;
 
-            return path;
-        }
+        const auto cells = s.solve(ops, m_root_index, goal_index);
 
-        // Retrieve the current cell
-        auto current_cell = ops.search(current_index);
-        if (!current_cell)
+        if (cells.empty())
         {
-#if defined(MAZE_DEBUG)
-            std::cerr << "Error: grid::search returned nullptr for index " << current_index << std::endl;
-#endif
-            continue;
+            // No path found, return the root alone
+            return std::make_shared<distances>(m_root_index);
         }
 
-        // Process each neighbor that has a passage (linked cells)
-        auto neighbors = ops.get_neighbors(current_cell);
-        for (const auto &neighbor : neighbors)
-        {
-            if (!neighbor)
-                continue;
-
-            int32_t neighbor_index = neighbor->get_index();
-
-            // Skip if already visited
-            if (visited.find(neighbor_index) != visited.end())
-            {
-                continue;
-            }
+        std::vector<std::int32_t> path(static_cast<size_t>(ops.get_link_masks().size()), -1);
 
-            // Only follow passages that exist (cells that are linked)
-            if (!current_cell->is_linked(neighbor))
-            {
-                continue;
-            }
-
-            // Mark as visited and add to queue
-            visited[neighbor_index] = true;
-            parent[neighbor_index] = current_index;
-            q.push_back(neighbor_index);
+        for (size_t step = 0; step < cells.size(); ++step)
+        {
+            path[static_cast<size_t>(cells[step])] = static_cast<std::int32_t>(step);
         }
-    }
 
-    // No path found, return empty path
-    return std::make_shared<distances>(m_root_index);
+        return std::make_shared<distances>(m_root_index, std::move(path));
+    }
+    catch (const std::exception &)
+    {
+        return std::make_shared<distances>(m_root_index);
+    }
 }
 
+/// @brief Scan the field for the farthest cell, the lowest index wins a tie
+/// @return
 std::pair<int32_t, int> distances::max() const noexcept
 {
     int32_t max_index = m_root_index;
     int max_distance = 0;
 
-    for (const auto &[index, distance] : m_cells)
+    for (size_t i = 0; i < m_cells.size(); ++i)
     {
-        if (distance > max_distance)
+        if (m_cells[i] > max_distance)
         {
-            max_index = index;
-            max_distance = distance;
+            max_index = static_cast<int32_t>(i);
+            max_distance = m_cells[i];
         }
     }
 
     return {max_index, max_distance};
 }
 
+/// @brief Scan the field for cells with a distance, in index order
+/// @param indices
 void distances::collect_keys(std::vector<int32_t> &indices) const noexcept
 {
     indices.clear();
-    for (const auto &[index, _] : m_cells)
+
+    for (size_t i = 0; i < m_cells.size(); ++i)
     {
-        indices.push_back(index);
+        if (m_cells[i] >= 0)
+        {
+            indices.push_back(static_cast<int32_t>(i));
+        }
     }
 }
+
+/// @brief Breadth-first search from the root over the link masks
+/// @param ops
+/// @param root_index
+/// @param max_distance
+/// @return
+std::vector<std::int32_t> distances::field(const grid_operations &ops, int32_t root_index, std::int32_t max_distance)
+{
+    std::vector<std::int32_t> dist(static_cast<size_t>(ops.get_link_masks().size()), -1);
+
+    if (root_index < 0 || static_cast<size_t>(root_index) >= dist.size())
+    {
+        return dist;
+    }
+
+    breadth_first(ops, root_index, max_distance, dist);
+
+    return dist;
+}
+
+/// @brief The root is a light green that darkens with distance
+/// @param distance
+/// @param max_distance
+/// @return
+std::uint32_t distances::ramp_color(int distance, int max_distance) noexcept
+{
+    const auto intensity = (max_distance > 0) ? static_cast<float>(max_distance - std::clamp(distance, 0, max_distance)) / static_cast<float>(max_distance) : 1.0f;
+
+    const auto dark = static_cast<std::uint32_t>(255 * intensity);
+    const auto bright = 128u + static_cast<std::uint32_t>(127 * intensity);
+
+    return (dark << 16) | (bright << 8) | dark;
+}
@@ -0,0 +1,224 @@
+#include <MazeBuilder/ellers.h>
+
+#include <MazeBuilder/enums.h>
+#include <MazeBuilder/grid_interface.h>
+#include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
+#include <MazeBuilder/randomizer.h>
+
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <utility>
+#include <vector>
+
+using namespace mazes;
+
+/// @brief Generate every level of the grid as its own maze, row by row
+/// @param g
+/// @param rng
+/// @return
+bool ellers::run(grid_interface *g, randomizer &rng) const noexcept
+{
+
+    using namespace std;
+
+    if (!g)
+    {
+
+        return false;
+    }
+
+    auto &grid_ops = g->operations();
+
+    auto [rows, columns, levels] = grid_ops.get_dimensions();
+
+    auto &masks = grid_ops.get_link_masks();
+
+    if (static_cast<size_t>(masks.size()) != static_cast<size_t>(rows) * columns * levels)
+    {
+
+        return false;
+    }
+
+    try
+    {
+        for (auto level{0u}; level < levels; ++level)
+        {
+            const auto level_offset = static_cast<int64_t>(level) * rows * columns;
+
+            // Rows come out finished, so they are copied over whatever the grid held
+            auto copy_row = [&masks, level_offset, columns](unsigned int row, span<const uint8_t> links)
+            {
+                const auto first = level_offset + static_cast<int64_t>(row) * columns;
+
+                for (auto col{0u}; col < columns; ++col)
+                {
+                    masks.set(static_cast<int>(first + col), links[col]);
+                }
+
+                return true;
+            };
+
+            if (!this->run(rows, columns, rng, copy_row))
+            {
+
+                return false;
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+
+        return false;
+    }
+
+    return true;
+}
+
+/// @brief Carve rows top to bottom, joining sets east-west and carrying every set at least once to the south
+/// @param rows
+/// @param columns
+/// @param rng
+/// @param sink
+/// @return
+bool ellers::run(unsigned int rows, unsigned int columns, randomizer &rng, const row_sink &sink) const
+{
+
+    using namespace std;
+
+    if (rows == 0 || columns == 0 || columns > static_cast<unsigned int>(numeric_limits<int>::max()))
+    {
+
+        return false;
+    }
+
+    static constexpr auto NORTH_BIT = to_link_bit_from_direction(Direction::NORTH);
+    static constexpr auto SOUTH_BIT = to_link_bit_from_direction(Direction::SOUTH);
+    static constexpr auto EAST_BIT = to_link_bit_from_direction(Direction::EAST);
+    static constexpr auto WEST_BIT = to_link_bit_from_direction(Direction::WEST);
+
+    // Set ids are renumbered every row so they always fit in [0, columns)
+    vector<unsigned int> sets(columns), parents(columns), counts(columns), renumbered(columns);
+    vector<uint8_t> carried(columns);
+
+    // Links of the row being carved and of the row below it
+    vector<uint8_t> current(columns, 0), below(columns, 0);
+
+    auto find = [&parents](unsigned int s)
+    {
+        while (parents[s] != s)
+        {
+            parents[s] = parents[parents[s]];
+            s = parents[s];
+        }
+
+        return s;
+    };
+
+    for (auto col{0u}; col < columns; ++col)
+    {
+        sets[col] = col;
+    }
+
+    for (auto row{0u}; row < rows; ++row)
+    {
+        const bool last_row = row + 1 == rows;
+
+        for (auto s{0u}; s < columns; ++s)
+        {
+            parents[s] = s;
+        }
+
+        // Join neighbors from different sets, the last row joins all of them so the maze is connected
+        for (auto col{0u}; col + 1 < columns; ++col)
+        {
+            const auto west = find(sets[col]), east = find(sets[col + 1]);
+
+            if (west != east && (last_row || rng(0, 1) == 0))
+            {
+                current[col] |= EAST_BIT;
+                current[col + 1] |= WEST_BIT;
+
+                parents[east] = west;
+            }
+        }
+
+        for (auto col{0u}; col < columns; ++col)
+        {
+            sets[col] = find(sets[col]);
+        }
+
+        if (!last_row)
+        {
+            fill(counts.begin(), counts.end(), 0u);
+            fill(carried.begin(), carried.end(), static_cast<uint8_t>(0));
+
+            for (auto col{0u}; col < columns; ++col)
+            {
+                ++counts[sets[col]];
+            }
+
+            // Carve south at random, forcing the last cell of a set south when nothing else in it was
+            for (auto col{0u}; col < columns; ++col)
+            {
+                const auto s = sets[col];
+
+                --counts[s];
+
+                if (rng(0, 1) == 0 || (counts[s] == 0 && !carried[s]))
+                {
+                    current[col] |= SOUTH_BIT;
+                    below[col] |= NORTH_BIT;
+
+                    carried[s] = 1;
+                }
+            }
+        }
+
+        if (!sink(row, span<const uint8_t>{current}))
+        {
+
+            return false;
+        }
+
+        if (last_row)
+        {
+            break;
+        }
+
+        // Cells reached from above keep their set, every other cell starts a new one
+        fill(renumbered.begin(), renumbered.end(), columns);
+        auto next_set{0u};
+
+        for (auto col{0u}; col < columns; ++col)
+        {
+            if (current[col] & SOUTH_BIT)
+            {
+                if (renumbered[sets[col]] == columns)
+                {
+                    renumbered[sets[col]] = next_set++;
+                }
+
+                sets[col] = renumbered[sets[col]];
+            }
+            else
+            {
+                sets[col] = columns;
+            }
+        }
+
+        for (auto col{0u}; col < columns; ++col)
+        {
+            if (sets[col] == columns)
+            {
+                sets[col] = next_set++;
+            }
+        }
+
+        swap(current, below);
+        fill(below.begin(), below.end(), static_cast<uint8_t>(0));
+    }
+
+    return true;
+}
@@ -0,0 +1,334 @@
+#include <MazeBuilder/flat_grid.h>
+
+#include <MazeBuilder/cell.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace mazes;
+
+/// @brief
+/// @param rows
+/// @param columns
+/// @param levels
+flat_grid::flat_grid(unsigned int rows, unsigned int columns, unsigned int levels)
+    : flat_grid::flat_grid(std::make_tuple(rows, columns, levels))
+{
+}
+
+/// @brief Only the link masks are allocated up front, cell indices match their offset in the block
+/// @param dimens
+flat_grid::flat_grid(std::tuple<unsigned int, unsigned int, unsigned int> dimens)
+    : m_dimensions(dimens), m_links(dimens), m_cells{}, m_cells_once{std::make_unique<std::once_flag>()}
+{
+}
+
+// Copy constructor
+flat_grid::flat_grid(const flat_grid &other)
+    : m_dimensions(other.m_dimensions), m_links(other.m_links), m_cells{}, m_cells_once{std::make_unique<std::once_flag>()}, m_str(other.m_str), m_mesh(other.m_mesh)
+{
+}
+
+// Copy assignment operator
+flat_grid &flat_grid::operator=(const flat_grid &other)
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    flat_grid copy{other};
+
+    return *this = std::move(copy);
+}
+
+// Move constructor
+flat_grid::flat_grid(flat_grid &&other) noexcept
+    : m_dimensions(other.m_dimensions), m_links(std::move(other.m_links)), m_cells(std::move(other.m_cells)), m_cells_once(std::move(other.m_cells_once)), m_str(std::move(other.m_str)), m_mesh(std::move(other.m_mesh))
+{
+    attach_cells(this);
+}
+
+// Move assignment operator
+flat_grid &flat_grid::operator=(flat_grid &&other) noexcept
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    attach_cells(nullptr);
+
+    m_dimensions = other.m_dimensions;
+    m_links = std::move(other.m_links);
+    m_cells = std::move(other.m_cells);
+    m_cells_once = std::move(other.m_cells_once);
+    m_str = std::move(other.m_str);
+    m_mesh = std::move(other.m_mesh);
+
+    attach_cells(this);
+
+    return *this;
+}
+
+// Destructor, cells that outlive the grid fall back to their own links
+flat_grid::~flat_grid()
+{
+    attach_cells(nullptr);
+}
+
+void flat_grid::attach_cells(grid_operations *owner) noexcept
+{
+    if (!m_cells)
+    {
+        return;
+    }
+
+    for (auto &c : *m_cells)
+    {
+        c.set_owner(owner);
+    }
+}
+
+void flat_grid::materialize_cells() const noexcept
+{
+    if (!m_cells_once)
+    {
+        return;
+    }
+
+    std::call_once(*m_cells_once, [this]()
+                   {
+        auto cells = std::make_shared<std::vector<cell>>();
+        auto owner = const_cast<flat_grid *>(this);
+
+        cells->reserve(static_cast<size_t>(m_links.size()));
+
+        for (auto i{0}; i < m_links.size(); ++i)
+        {
+            cells->emplace_back(static_cast<std::int32_t>(i), owner);
+        }
+
+        m_cells = std::move(cells); });
+}
+
+link_masks &flat_grid::get_link_masks() noexcept
+{
+    return this->m_links;
+}
+
+const link_masks &flat_grid::get_link_masks() const noexcept
+{
+    return this->m_links;
+}
+
+void flat_grid::clear_cells() noexcept
+{
+    if (!m_cells)
+    {
+        return;
+    }
+
+    for (auto &c : *m_cells)
+    {
+        c.cleanup_links();
+    }
+}
+
+std::tuple<unsigned int, unsigned int, unsigned int> flat_grid::get_dimensions() const noexcept
+{
+    return this->m_dimensions;
+}
+
+std::shared_ptr<cell> flat_grid::search(int index) const noexcept
+{
+    if (index < 0 || index >= m_links.size())
+    {
+        return nullptr;
+    }
+
+    materialize_cells();
+
+    if (!m_cells)
+    {
+        return nullptr;
+    }
+
+    // Alias into the block, no allocation and no lookup
+    return std::shared_ptr<cell>(m_cells, m_cells->data() + index);
+}
+
+int flat_grid::num_cells() const noexcept
+{
+    return m_links.size();
+}
+
+// Get the contents of a cell for this type of grid
+std::string flat_grid::contents_of([[maybe_unused]] std::shared_ptr<cell> const &c) const noexcept
+{
+    return " ";
+}
+
+// Every cell reads the same, so the block is never touched
+std::string flat_grid::contents_at([[maybe_unused]] int index) const noexcept
+{
+    return " ";
+}
+
+bool flat_grid::has_contents() const noexcept
+{
+    return false;
+}
+
+// Get the background color for this type of grid
+std::uint32_t flat_grid::background_color_for([[maybe_unused]] std::shared_ptr<cell> const &c) const noexcept
+{
+    return 0xFFFFFFFF;
+}
+
+std::uint32_t flat_grid::background_color_at([[maybe_unused]] int index) const noexcept
+{
+    return 0xFFFFFFFF;
+}
+
+grid_operations &flat_grid::operations() noexcept
+{
+    return *this;
+}
+
+const grid_operations &flat_grid::operations() const noexcept
+{
+    return *this;
+}
+
+void flat_grid::set_str(std::string const &str) noexcept
+{
+    this->m_str = str;
+}
+
+void flat_grid::set_str(std::string &&str) noexcept
+{
+    this->m_str = std::move(str);
+}
+
+std::string flat_grid::get_str() const noexcept
+{
+    return this->m_str;
+}
+
+int flat_grid::get_neighbor_index(int index, Direction dir) const noexcept
+{
+    if (index < 0 || index >= m_links.size())
+    {
+        return -1;
+    }
+
+    return m_links.neighbor_index(index, dir);
+}
+
+std::array<int, static_cast<size_t>(Direction::COUNT)> flat_grid::get_neighbor_indices(int index) const noexcept
+{
+    std::array<int, static_cast<size_t>(Direction::COUNT)> indices{};
+
+    for (auto d{0}; d < static_cast<int>(Direction::COUNT); ++d)
+    {
+        indices[static_cast<size_t>(d)] = get_neighbor_index(index, static_cast<Direction>(d));
+    }
+
+    return indices;
+}
+
+bool flat_grid::is_linked(int index, Direction dir) const noexcept
+{
+    if (index < 0 || index >= m_links.size())
+    {
+        return false;
+    }
+
+    return m_links.is_linked(index, dir);
+}
+
+std::shared_ptr<cell> flat_grid::get_neighbor(std::shared_ptr<cell> const &c, Direction dir) const noexcept
+{
+    if (!c)
+    {
+        return nullptr;
+    }
+
+    return search(get_neighbor_index(c->get_index(), dir));
+}
+
+std::vector<std::shared_ptr<cell>> flat_grid::get_neighbors(std::shared_ptr<cell> const &c) const noexcept
+{
+    std::vector<std::shared_ptr<cell>> neighbors;
+
+    if (!c)
+    {
+        return neighbors;
+    }
+
+    const auto indices = get_neighbor_indices(c->get_index());
+
+    neighbors.reserve(4);
+
+    // Planar neighbors only: north, south, east, west
+    for (auto dir : {Direction::NORTH, Direction::SOUTH, Direction::EAST, Direction::WEST})
+    {
+        if (auto n = search(indices[static_cast<size_t>(dir)]))
+        {
+            neighbors.push_back(std::move(n));
+        }
+    }
+
+    return neighbors;
+}
+
+void flat_grid::set_neighbor([[maybe_unused]] const std::shared_ptr<cell> &c, [[maybe_unused]] Direction dir, [[maybe_unused]] std::shared_ptr<cell> const &neighbor) noexcept
+{
+}
+
+// Convenience methods for accessing neighbors
+std::shared_ptr<cell> flat_grid::get_north(const std::shared_ptr<cell> &c) const noexcept
+{
+    return get_neighbor(c, Direction::NORTH);
+}
+
+std::shared_ptr<cell> flat_grid::get_south(const std::shared_ptr<cell> &c) const noexcept
+{
+    return get_neighbor(c, Direction::SOUTH);
+}
+
+std::shared_ptr<cell> flat_grid::get_east(const std::shared_ptr<cell> &c) const noexcept
+{
+    return get_neighbor(c, Direction::EAST);
+}
+
+std::shared_ptr<cell> flat_grid::get_west(const std::shared_ptr<cell> &c) const noexcept
+{
+    return get_neighbor(c, Direction::WEST);
+}
+
+/// @brief Get the mesh for 3D output
+/// @return
+mesh &flat_grid::get_mesh() noexcept
+{
+    return m_mesh;
+}
+
+/// @brief Get the mesh for 3D output
+/// @return
+const mesh &flat_grid::get_mesh() const noexcept
+{
+    return m_mesh;
+}
+
+/// @brief Take over a mesh for 3D output
+/// @param m
+void flat_grid::set_mesh(mesh &&m) noexcept
+{
+    m_mesh = std::move(m);
+}
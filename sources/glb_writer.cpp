@@ -0,0 +1,189 @@
+#include <MazeBuilder/glb_writer.h>
+
+#include <MazeBuilder/buildinfo.h>
+#include <MazeBuilder/mesh.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <ios>
+#include <limits>
+#include <span>
+#include <string>
+
+using namespace mazes;
+
+namespace
+{
+    constexpr std::uint32_t GLB_MAGIC = 0x46546C67u;
+
+    constexpr std::uint32_t GLB_VERSION = 2u;
+
+    constexpr std::uint32_t JSON_CHUNK = 0x4E4F534Au;
+
+    constexpr std::uint32_t BIN_CHUNK = 0x004E4942u;
+
+    // Vertices converted per block
+    constexpr std::size_t BLOCK_VERTICES = std::size_t{1} << 16;
+
+    // glTF stores little-endian words, on little-endian hosts buffers are written as they are
+    template <typename T>
+    void write_le(std::ostream &os, std::span<const T> values)
+    {
+        static_assert(sizeof(T) == 4);
+
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            os.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+        }
+        else
+        {
+            for (const auto value : values)
+            {
+                const auto word = std::bit_cast<std::uint32_t>(value);
+                const char bytes[4]{static_cast<char>(word), static_cast<char>(word >> 8), static_cast<char>(word >> 16), static_cast<char>(word >> 24)};
+
+                os.write(bytes, 4);
+            }
+        }
+    }
+
+    void write_u32(std::ostream &os, std::uint32_t value)
+    {
+        write_le(os, std::span<const std::uint32_t>{&value, 1});
+    }
+
+    // The lattice is x down the rows, y across the columns, z up the levels
+    // glTF is Y-up, so the axes are rotated, which keeps the winding of every face
+    std::array<std::int32_t, 3> to_y_up(std::span<const std::int32_t> p) noexcept
+    {
+        return {p[1], p[2], p[0]};
+    }
+
+    std::string vec3_json(const std::array<std::int32_t, 3> &v)
+    {
+        // Three numbers of at most 11 characters, two commas, and the brackets
+        std::array<char, 3 * 11 + 4> text{};
+
+        char *out = text.data();
+
+        *out++ = '[';
+
+        for (std::size_t i = 0; i < v.size(); ++i)
+        {
+            if (i > 0)
+            {
+                *out++ = ',';
+            }
+
+            out = std::to_chars(out, out + 11, v[i]).ptr;
+        }
+
+        *out++ = ']';
+
+        return std::string(text.data(), out);
+    }
+} // namespace
+
+/// @brief Write to a stream
+/// @param os
+glb_writer::glb_writer(std::ostream &os) noexcept
+    : m_os{os}, m_block{}
+{
+}
+
+/// @brief Write the header, the JSON chunk, and the binary chunk
+/// @param m
+/// @return
+bool glb_writer::write(const mesh &m)
+{
+    const auto positions = m.positions();
+    const auto indices = m.indices();
+
+    const auto position_bytes = static_cast<std::uint64_t>(positions.size()) * sizeof(float);
+    const auto index_bytes = static_cast<std::uint64_t>(indices.size()) * sizeof(std::uint32_t);
+
+    std::string json = R"({"asset":{"version":"2.0","generator":"MazeBuilder )" + buildinfo::Version + R"("})";
+
+    if (!m.empty())
+    {
+        // Accessors of positions need their bounds
+        auto low = to_y_up(positions.first(3)), high = low;
+
+        for (std::size_t i = 3; i < positions.size(); i += 3)
+        {
+            const auto p = to_y_up(positions.subspan(i, 3));
+
+            for (auto k = 0u; k < 3; ++k)
+            {
+                low[k] = std::min(low[k], p[k]);
+                high[k] = std::max(high[k], p[k]);
+            }
+        }
+
+        json += R"(,"scene":0,"scenes":[{"nodes":[0]}],"nodes":[{"mesh":0}])";
+        json += R"(,"meshes":[{"primitives":[{"attributes":{"POSITION":0},"indices":1,"mode":4}]}])";
+        json += R"(,"buffers":[{"byteLength":)" + std::to_string(position_bytes + index_bytes) + "}]";
+        json += R"(,"bufferViews":[{"buffer":0,"byteOffset":0,"byteLength":)" + std::to_string(position_bytes) + R"(,"target":34962})";
+        json += R"(,{"buffer":0,"byteOffset":)" + std::to_string(position_bytes) + R"(,"byteLength":)" + std::to_string(index_bytes) + R"(,"target":34963}])";
+        json += R"(,"accessors":[{"bufferView":0,"componentType":5126,"count":)" + std::to_string(m.vertex_count()) + R"(,"type":"VEC3","min":)" + vec3_json(low) + R"(,"max":)" + vec3_json(high) + "}";
+        json += R"(,{"bufferView":1,"componentType":5125,"count":)" + std::to_string(indices.size()) + R"(,"type":"SCALAR"}])";
+    }
+
+    json += "}";
+
+    // Chunks start on 4-byte boundaries, JSON is padded with spaces
+    json.resize((json.size() + 3) / 4 * 4, ' ');
+
+    const auto bin_bytes = m.empty() ? 0 : position_bytes + index_bytes;
+    const auto total = 12 + 8 + json.size() + (m.empty() ? 0 : 8 + bin_bytes);
+
+    if (total > std::numeric_limits<std::uint32_t>::max())
+    {
+        m_os.setstate(std::ios::failbit);
+
+        return false;
+    }
+
+    write_u32(m_os, GLB_MAGIC);
+    write_u32(m_os, GLB_VERSION);
+    write_u32(m_os, static_cast<std::uint32_t>(total));
+
+    write_u32(m_os, static_cast<std::uint32_t>(json.size()));
+    write_u32(m_os, JSON_CHUNK);
+    m_os.write(json.data(), static_cast<std::streamsize>(json.size()));
+
+    if (m.empty())
+    {
+        return good();
+    }
+
+    write_u32(m_os, static_cast<std::uint32_t>(bin_bytes));
+    write_u32(m_os, BIN_CHUNK);
+
+    m_block.resize(std::min(m.vertex_count(), BLOCK_VERTICES) * 3);
+
+    for (std::size_t first = 0; first < m.vertex_count() && good(); first += BLOCK_VERTICES)
+    {
+        const auto count = std::min(BLOCK_VERTICES, m.vertex_count() - first);
+
+        for (std::size_t v = 0; v < count; ++v)
+        {
+            const auto p = to_y_up(positions.subspan((first + v) * 3, 3));
+
+            m_block[v * 3] = static_cast<float>(p[0]);
+            m_block[v * 3 + 1] = static_cast<float>(p[1]);
+            m_block[v * 3 + 2] = static_cast<float>(p[2]);
+        }
+
+        write_le(m_os, std::span<const float>{m_block.data(), count * 3});
+    }
+
+    write_le(m_os, indices);
+
+    m_os.flush();
+
+    return good();
+}
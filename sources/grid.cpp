@@ -5,11 +5,13 @@
 #include <MazeBuilder/lab.h>
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <random>
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 using namespace mazes;
@@ -27,22 +29,30 @@ grid::grid(unsigned int rows, unsigned int columns, unsigned int height)
 /// @brief
 /// @param dimensions
 grid::grid(std::tuple<unsigned int, unsigned int, unsigned int> dimens)
-    : m_dimensions(dimens)
+    : m_dimensions(dimens), m_links(dimens)
 {
     auto total_cells = std::get<0>(m_dimensions) * std::get<1>(m_dimensions) * std::get<2>(m_dimensions);
 
     m_cells.reserve(total_cells);
 
     for (size_t i{0}; i < total_cells; ++i) {
-        m_cells.emplace(static_cast<int32_t>(i), std::make_shared<cell>(static_cast<int32_t>(i)));
+        m_cells.emplace(static_cast<int32_t>(i), std::make_shared<cell>(static_cast<int32_t>(i), this));
     }
 }
 
 // Copy constructor
 grid::grid(const grid &other)
-    : m_dimensions(other.m_dimensions), m_cells(other.m_cells)
+    : m_dimensions(other.m_dimensions), m_links(other.m_links)
 {
 
+    m_cells.reserve(other.m_cells.size());
+
+    for (const auto &[index, c] : other.m_cells)
+    {
+        m_cells.emplace(index, std::make_shared<cell>(*c));
+    }
+
+    attach_cells(this);
 }
 
 // Copy assignment operator
@@ -53,18 +63,17 @@ grid &grid::operator=(const grid &other)
         return *this;
     }
 
-    m_dimensions = other.m_dimensions;
-
-    m_cells = other.m_cells;
+    grid copy{other};
 
-    return *this;
+    return *this = std::move(copy);
 }
 
 // Move constructor
 grid::grid(grid &&other) noexcept
-    : m_dimensions(other.m_dimensions), m_cells(other.m_cells)
+    : m_cells(std::move(other.m_cells)), m_dimensions(other.m_dimensions), m_links(std::move(other.m_links))
 {
 
+    attach_cells(this);
 }
 
 // Move assignment operator
@@ -75,9 +84,15 @@ grid &grid::operator=(grid &&other) noexcept
         return *this;
     }
 
+    attach_cells(nullptr);
+
     m_dimensions = other.m_dimensions;
 
-    m_cells = other.m_cells;
+    m_cells = std::move(other.m_cells);
+
+    m_links = std::move(other.m_links);
+
+    attach_cells(this);
 
     return *this;
 }
@@ -88,6 +103,27 @@ grid::~grid()
 
     // First clean up cell references
     grid::clear_cells();
+
+    // Cells that outlive the grid fall back to their own links
+    attach_cells(nullptr);
+}
+
+void grid::attach_cells(grid_operations *owner) noexcept
+{
+    for (auto &[_, c] : m_cells)
+    {
+        c->set_owner(owner);
+    }
+}
+
+link_masks &grid::get_link_masks() noexcept
+{
+    return this->m_links;
+}
+
+const link_masks &grid::get_link_masks() const noexcept
+{
+    return this->m_links;
 }
 
 void grid::clear_cells() noexcept
@@ -130,12 +166,28 @@ std::string grid::contents_of([[maybe_unused]] std::shared_ptr<cell> const &c) c
     return " ";
 }
 
+// Every cell reads the same, so there is no lookup
+std::string grid::contents_at([[maybe_unused]] int index) const noexcept
+{
+    return " ";
+}
+
+bool grid::has_contents() const noexcept
+{
+    return false;
+}
+
 // Get the background color for this type of grid
 std::uint32_t grid::background_color_for([[maybe_unused]] std::shared_ptr<cell> const &c) const noexcept
 {
     return 0xFFFFFFFF;
 }
 
+std::uint32_t grid::background_color_at([[maybe_unused]] int index) const noexcept
+{
+    return 0xFFFFFFFF;
+}
+
 grid_operations &grid::operations() noexcept
 {
     return *this;
@@ -151,60 +203,56 @@ void grid::set_str(std::string const &str) noexcept
     this->m_str = str;
 }
 
+void grid::set_str(std::string &&str) noexcept
+{
+    this->m_str = std::move(str);
+}
+
 std::string grid::get_str() const noexcept
 {
     return this->m_str;
 }
 
-std::shared_ptr<cell> grid::get_neighbor(std::shared_ptr<cell> const &c, Direction dir) const noexcept
+int grid::get_neighbor_index(int index, Direction dir) const noexcept
 {
-    if (!c)
+    if (index < 0 || index >= m_links.size())
     {
-        return nullptr;
+        return -1;
     }
 
-    // Calculate neighbor index on-demand instead of pre-computing topology
-    auto [rows, columns, levels] = m_dimensions;
-    int current_index = c->get_index();
+    return m_links.neighbor_index(index, dir);
+}
 
-    // Calculate 3D coordinates from index
-    int level = current_index / (rows * columns);
-    int remaining = current_index % (rows * columns);
-    int row = remaining / columns;
-    int col = remaining % columns;
+std::array<int, static_cast<size_t>(Direction::COUNT)> grid::get_neighbor_indices(int index) const noexcept
+{
+    std::array<int, static_cast<size_t>(Direction::COUNT)> indices{};
+
+    for (auto d{0}; d < static_cast<int>(Direction::COUNT); ++d)
+    {
+        indices[static_cast<size_t>(d)] = get_neighbor_index(index, static_cast<Direction>(d));
+    }
 
-    int neighbor_index = -1;
+    return indices;
+}
 
-    switch (dir)
+bool grid::is_linked(int index, Direction dir) const noexcept
+{
+    if (index < 0 || index >= m_links.size())
     {
-    case Direction::NORTH:
-        if (row > 0)
-        {
-            neighbor_index = level * (rows * columns) + (row - 1) * columns + col;
-        }
-        break;
-    case Direction::SOUTH:
-        if (row < static_cast<int>(rows) - 1)
-        {
-            neighbor_index = level * (rows * columns) + (row + 1) * columns + col;
-        }
-        break;
-    case Direction::EAST:
-        if (col < static_cast<int>(columns) - 1)
-        {
-            neighbor_index = level * (rows * columns) + row * columns + (col + 1);
-        }
-        break;
-    case Direction::WEST:
-        if (col > 0)
-        {
-            neighbor_index = level * (rows * columns) + row * columns + (col - 1);
-        }
-        break;
+        return false;
+    }
+
+    return m_links.is_linked(index, dir);
+}
+
+std::shared_ptr<cell> grid::get_neighbor(std::shared_ptr<cell> const &c, Direction dir) const noexcept
+{
+    if (!c)
+    {
+        return nullptr;
     }
 
-    // Return the neighbor (will be created lazily if it doesn't exist)
-    return (neighbor_index >= 0) ? search(neighbor_index) : nullptr;
+    return search(get_neighbor_index(c->get_index(), dir));
 }
 
 std::vector<std::shared_ptr<cell>> grid::get_neighbors(std::shared_ptr<cell> const &c) const noexcept
@@ -216,22 +264,17 @@ std::vector<std::shared_ptr<cell>> grid::get_neighbors(std::shared_ptr<cell> con
         return neighbors;
     }
 
-    // Get neighbors in all four directions
-    if (auto north = get_neighbor(c, Direction::NORTH))
-    {
-        neighbors.push_back(north);
-    }
-    if (auto south = get_neighbor(c, Direction::SOUTH))
-    {
-        neighbors.push_back(south);
-    }
-    if (auto east = get_neighbor(c, Direction::EAST))
-    {
-        neighbors.push_back(east);
-    }
-    if (auto west = get_neighbor(c, Direction::WEST))
+    const auto indices = get_neighbor_indices(c->get_index());
+
+    neighbors.reserve(4);
+
+    // Planar neighbors only: north, south, east, west
+    for (auto dir : {Direction::NORTH, Direction::SOUTH, Direction::EAST, Direction::WEST})
     {
-        neighbors.push_back(west);
+        if (auto n = search(indices[static_cast<size_t>(dir)]))
+        {
+            neighbors.push_back(std::move(n));
+        }
     }
 
     return neighbors;
@@ -282,30 +325,23 @@ std::shared_ptr<cell> grid::get_west(const std::shared_ptr<cell> &c) const noexc
     return get_neighbor(c, Direction::WEST);
 }
 
-/// @brief Get the vertices for wavefront object file generation
-/// @return A vector of vertices as tuples (x, y, z, w)
-std::vector<std::tuple<int, int, int, int>> grid::get_vertices() const noexcept
-{
-    return m_vertices;
-}
-
-/// @brief Set the vertices for wavefront object file generation
-/// @param vertices A vector of vertices as tuples (x, y, z, w)
-void grid::set_vertices(const std::vector<std::tuple<int, int, int, int>> &vertices) noexcept
+/// @brief Get the mesh for 3D output
+/// @return
+mesh &grid::get_mesh() noexcept
 {
-    m_vertices = vertices;
+    return m_mesh;
 }
 
-/// @brief Get the faces for wavefront object file generation
-/// @return A vector of faces, where each face is a vector of vertex indices
-std::vector<std::vector<std::uint32_t>> grid::get_faces() const noexcept
+/// @brief Get the mesh for 3D output
+/// @return
+const mesh &grid::get_mesh() const noexcept
 {
-    return m_faces;
+    return m_mesh;
 }
 
-/// @brief Set the faces for wavefront object file generation
-/// @param faces A vector of faces, where each face is a vector of vertex indices
-void grid::set_faces(const std::vector<std::vector<std::uint32_t>> &faces) noexcept
+/// @brief Take over a mesh for 3D output
+/// @param m
+void grid::set_mesh(mesh &&m) noexcept
 {
-    m_faces = faces;
+    m_mesh = std::move(m);
 }
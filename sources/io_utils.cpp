@@ -38,17 +38,79 @@ bool io_utils::write_jpeg(const std::string &filename, const std::vector<std::ui
     return (0 != stbi_write_jpg(filename.c_str(), w, h, stride, data.data(), w * stride));
 }
 
+namespace
+{
+    // Collects the output of the stb writers
+    void append_to_string(void *context, void *data, int size)
+    {
+        static_cast<std::string *>(context)->append(static_cast<const char *>(data), static_cast<size_t>(size));
+    }
+} // namespace
+
+/// @brief Encode pixels as PNG file contents in memory
+/// @param data
+/// @param w
+/// @param h
+/// @param stride 4
+/// @return
+std::string io_utils::encode_png(const std::vector<std::uint8_t> &data, unsigned int w, unsigned int h, unsigned int stride) const noexcept
+{
+    std::string encoded;
+
+    try
+    {
+        if (0 == stbi_write_png_to_func(append_to_string, &encoded, w, h, stride, data.data(), w * stride))
+        {
+            encoded.clear();
+        }
+    }
+    catch (const std::exception &)
+    {
+        encoded.clear();
+    }
+
+    return encoded;
+}
+
+/// @brief Encode pixels as JPEG file contents in memory
+/// @param data
+/// @param w
+/// @param h
+/// @param stride 4
+/// @return
+std::string io_utils::encode_jpeg(const std::vector<std::uint8_t> &data, unsigned int w, unsigned int h, unsigned int stride) const noexcept
+{
+    static constexpr auto JPEG_QUALITY = 90;
+
+    std::string encoded;
+
+    try
+    {
+        if (0 == stbi_write_jpg_to_func(append_to_string, &encoded, w, h, stride, data.data(), JPEG_QUALITY))
+        {
+            encoded.clear();
+        }
+    }
+    catch (const std::exception &)
+    {
+        encoded.clear();
+    }
+
+    return encoded;
+}
+
 /// @brief Write to a conventional file
 /// @param filename
 /// @param data
+/// @param binary
 /// @return
-bool io_utils::write_file(const std::string &filename, const std::string &data) const noexcept
+bool io_utils::write_file(const std::string &filename, const std::string &data, bool binary) const noexcept
 {
     using namespace std;
 
     filesystem::path data_path{filename};
 
-    ofstream out_writer{data_path};
+    ofstream out_writer{data_path, binary ? ios::out | ios::binary : ios::out};
 
     if (!out_writer.is_open())
     {
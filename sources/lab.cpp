@@ -3,6 +3,7 @@
 #include <MazeBuilder/cell.h>
 #include <MazeBuilder/configurator.h>
 #include <MazeBuilder/enums.h>
+#include <MazeBuilder/grid_operations.h>
 
 #include <cstdint>
 #include <functional>
@@ -60,3 +61,60 @@ void lab::unlink(const std::shared_ptr<cell> &c1, const std::shared_ptr<cell> &c
         c2->remove_link(c1);
     }
 }
+
+
+/// @brief Open the passage from a cell toward a direction
+/// @param g Grid that owns the cell
+/// @param index Index of the cell
+/// @param dir Direction of the neighbor
+/// @param bidi If true, also opens the passage back from the neighbor
+/// @return False when there is no cell or neighbor to link
+bool lab::link(grid_operations &g, int index, Direction dir, bool bidi) noexcept
+{
+    auto &masks = g.get_link_masks();
+
+    if (index < 0 || index >= masks.size())
+    {
+
+        return false;
+    }
+
+    return masks.link(index, dir, bidi);
+}
+
+/// @brief Close the passage from a cell toward a direction
+/// @param g Grid that owns the cell
+/// @param index Index of the cell
+/// @param dir Direction of the neighbor
+/// @param bidi If true, also closes the passage back from the neighbor
+/// @return False when there is no cell or neighbor to unlink
+bool lab::unlink(grid_operations &g, int index, Direction dir, bool bidi) noexcept
+{
+    auto &masks = g.get_link_masks();
+
+    if (index < 0 || index >= masks.size())
+    {
+
+        return false;
+    }
+
+    return masks.unlink(index, dir, bidi);
+}
+
+/// @brief Check the passage from a cell toward a direction
+/// @param g Grid that owns the cell
+/// @param index Index of the cell
+/// @param dir Direction of the neighbor
+/// @return True if the passage is open
+bool lab::is_linked(grid_operations const &g, int index, Direction dir) noexcept
+{
+    const auto &masks = g.get_link_masks();
+
+    if (index < 0 || index >= masks.size())
+    {
+
+        return false;
+    }
+
+    return masks.is_linked(index, dir);
+}
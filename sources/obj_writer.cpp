@@ -0,0 +1,133 @@
+#include <MazeBuilder/obj_writer.h>
+
+#include <MazeBuilder/buildinfo.h>
+#include <MazeBuilder/mesh.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <exception>
+#include <ios>
+#include <string>
+
+using namespace mazes;
+
+namespace
+{
+    // Longest line: a tag, then three numbers of at most 11 characters each after a space, then a newline
+    constexpr std::size_t MAX_LINE = 1 + 3 * 12 + 1;
+
+    constexpr std::size_t DEFAULT_CHUNK_BYTES = std::size_t{1} << 21;
+
+    // Length of a chunk that could not be formatted
+    constexpr std::size_t FAILED = static_cast<std::size_t>(-1);
+
+    template <typename T>
+    char *write_line(char *out, char tag, T a, T b, T c) noexcept
+    {
+        *out++ = tag;
+
+        for (auto n : {a, b, c})
+        {
+            *out++ = ' ';
+            out = std::to_chars(out, out + 11, n).ptr;
+        }
+
+        *out++ = '\n';
+
+        return out;
+    }
+} // namespace
+
+/// @brief Write to a stream
+/// @param os
+/// @param threads
+/// @param chunk_lines
+obj_writer::obj_writer(std::ostream &os, unsigned int threads, std::size_t chunk_lines)
+    : m_os{os}, m_team{threads}, m_chunk_lines{chunk_lines == 0 ? DEFAULT_CHUNK_BYTES / MAX_LINE : chunk_lines}, m_buffers{}, m_lengths{}
+{
+}
+
+/// @brief Write the mesh as OBJ text
+/// @details Indices in OBJ start at 1, the mesh starts them at 0
+/// @param m
+/// @return
+bool obj_writer::write(const mesh &m)
+{
+    const std::string header = std::string{"# Generated by MazeBuilder\n# "} + buildinfo::Version + "-" + buildinfo::CommitSHA + "\n";
+
+    m_os.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    const auto positions = m.positions();
+
+    write_lines(m.vertex_count(), [positions](std::size_t i, char *out)
+                { return write_line(out, 'v', positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]); });
+
+    const auto indices = m.indices();
+
+    write_lines(m.triangle_count(), [indices](std::size_t i, char *out)
+                { return write_line(out, 'f', indices[i * 3] + 1, indices[i * 3 + 1] + 1, indices[i * 3 + 2] + 1); });
+
+    m_os.flush();
+
+    return good();
+}
+
+/// @brief Format a batch of chunks in parallel, then write them in order
+/// @tparam Format Callable writing line i at a pointer and returning the end of the line
+/// @param count Number of lines
+/// @param format
+template <typename Format>
+void obj_writer::write_lines(std::size_t count, Format &&format)
+{
+    const auto chunks = (count + m_chunk_lines - 1) / m_chunk_lines;
+
+    const auto threads = static_cast<std::size_t>(m_team.size());
+
+    for (std::size_t first_chunk = 0; first_chunk < chunks && good(); first_chunk += threads)
+    {
+        const auto batch = static_cast<unsigned int>(std::min(threads, chunks - first_chunk));
+
+        if (m_buffers.size() < batch)
+        {
+            m_buffers.resize(batch);
+            m_lengths.resize(batch);
+        }
+
+        m_team.for_each(batch, [&](std::size_t b)
+                        {
+            const auto first_line = (first_chunk + b) * m_chunk_lines;
+            const auto last_line = std::min(count, first_line + m_chunk_lines);
+
+            try
+            {
+                auto &buffer = m_buffers[b];
+                buffer.resize(std::max(buffer.size(), m_chunk_lines * MAX_LINE));
+
+                char *out = buffer.data();
+
+                for (auto i = first_line; i < last_line; ++i)
+                {
+                    out = format(i, out);
+                }
+
+                m_lengths[b] = static_cast<std::size_t>(out - buffer.data());
+            }
+            catch (const std::exception &)
+            {
+                m_lengths[b] = FAILED;
+            } });
+
+        for (auto b = 0u; b < batch && good(); ++b)
+        {
+            if (m_lengths[b] == FAILED)
+            {
+                m_os.setstate(std::ios::badbit);
+
+                break;
+            }
+
+            m_os.write(m_buffers[b].data(), static_cast<std::streamsize>(m_lengths[b]));
+        }
+    }
+}
@@ -2,17 +2,259 @@
 
 #include <MazeBuilder/grid_interface.h>
 #include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
+#include <MazeBuilder/mesh.h>
 #include <MazeBuilder/randomizer.h>
-#include <MazeBuilder/enums.h>
 
-#include <tuple>
-#include <vector>
+#include <algorithm>
+#include <array>
 #include <cstdint>
-#include <string_view>
+#include <exception>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace mazes;
 
-/// @brief Generate 3D mesh data from the grid for Wavefront object file output
+namespace
+{
+    // Walls sit on the same lattice as the text from stringify: a cell spans 6 columns and 2 lines
+    constexpr int CELL_SPAN = 6;
+
+    constexpr int ROW_SPAN = 2;
+
+    constexpr std::uint8_t SOUTH_BIT = static_cast<std::uint8_t>(1u << static_cast<unsigned int>(Direction::SOUTH));
+
+    constexpr std::uint8_t EAST_BIT = static_cast<std::uint8_t>(1u << static_cast<unsigned int>(Direction::EAST));
+
+    // One unit block per wall position, x runs down the lines, y across the columns, z up the levels
+    class wall_volume
+    {
+    public:
+        explicit wall_volume(const grid_operations &ops)
+        {
+            auto [rows, columns, levels] = ops.get_dimensions();
+
+            const auto &masks = ops.get_link_masks();
+
+            m_dims = {static_cast<int>(rows) * ROW_SPAN + 1, static_cast<int>(columns) * CELL_SPAN + 1, static_cast<int>(levels)};
+            m_solid.assign(static_cast<size_t>(m_dims[0]) * static_cast<size_t>(m_dims[1]) * static_cast<size_t>(m_dims[2]), 0);
+
+            const int plane = static_cast<int>(rows * columns);
+
+            for (auto z = 0; z < m_dims[2]; ++z)
+            {
+                for (auto x = 0; x < m_dims[0]; ++x)
+                {
+                    auto *line = m_solid.data() + offset(x, 0, z);
+
+                    if (x % ROW_SPAN == 0)
+                    {
+                        // Corners, then the south walls of the row above, the top border has no row above
+                        const int above = x / ROW_SPAN - 1;
+
+                        for (auto y = 0; y < m_dims[1]; ++y)
+                        {
+                            const bool corner = y % CELL_SPAN == 0;
+                            const bool open = !corner && above >= 0 && (masks.get(z * plane + above * static_cast<int>(columns) + y / CELL_SPAN) & SOUTH_BIT) != 0;
+
+                            line[y] = open ? 0 : 1;
+                        }
+                    }
+                    else
+                    {
+                        // The west border, then the east wall of every cell
+                        const int first = z * plane + (x / ROW_SPAN) * static_cast<int>(columns);
+
+                        line[0] = 1;
+
+                        for (auto c = 0; c < static_cast<int>(columns); ++c)
+                        {
+                            line[(c + 1) * CELL_SPAN] = (masks.get(first + c) & EAST_BIT) != 0 ? 0 : 1;
+                        }
+                    }
+                }
+            }
+        }
+
+        const std::array<int, 3> &dims() const noexcept { return m_dims; }
+
+        bool solid(const std::array<int, 3> &p) const noexcept
+        {
+            if (p[0] < 0 || p[1] < 0 || p[2] < 0 || p[0] >= m_dims[0] || p[1] >= m_dims[1] || p[2] >= m_dims[2])
+            {
+                return false;
+            }
+
+            return m_solid[offset(p[0], p[1], p[2])] != 0;
+        }
+
+    private:
+        size_t offset(int x, int y, int z) const noexcept
+        {
+            return (static_cast<size_t>(z) * static_cast<size_t>(m_dims[0]) + static_cast<size_t>(x)) * static_cast<size_t>(m_dims[1]) + static_cast<size_t>(y);
+        }
+
+        std::array<int, 3> m_dims{};
+
+        std::vector<std::uint8_t> m_solid;
+    };
+
+    // Collects triangles, every lattice point becomes at most one vertex
+    class mesh_builder
+    {
+    public:
+        explicit mesh_builder(const std::array<int, 3> &dims) noexcept
+            : m_stride_y{static_cast<std::uint64_t>(dims[1]) + 1}, m_stride_z{static_cast<std::uint64_t>(dims[2]) + 1}
+        {
+        }
+
+        // Corners are in counter-clockwise order seen from outside the wall
+        void quad(const std::array<std::array<int, 3>, 4> &corners)
+        {
+            std::array<std::uint32_t, 4> ids{};
+
+            for (auto i = 0u; i < corners.size(); ++i)
+            {
+                ids[i] = vertex(corners[i]);
+            }
+
+            m_mesh.add_triangle(ids[0], ids[1], ids[2]);
+            m_mesh.add_triangle(ids[0], ids[2], ids[3]);
+        }
+
+        mesh &result() noexcept { return m_mesh; }
+
+    private:
+        std::uint32_t vertex(const std::array<int, 3> &p)
+        {
+            const auto key = (static_cast<std::uint64_t>(p[0]) * m_stride_y + static_cast<std::uint64_t>(p[1])) * m_stride_z + static_cast<std::uint64_t>(p[2]);
+
+            auto [it, inserted] = m_ids.try_emplace(key, static_cast<std::uint32_t>(m_mesh.vertex_count()));
+
+            if (inserted)
+            {
+                m_mesh.add_vertex(p[0], p[1], p[2]);
+            }
+
+            return it->second;
+        }
+
+        std::uint64_t m_stride_y;
+
+        std::uint64_t m_stride_z;
+
+        std::unordered_map<std::uint64_t, std::uint32_t> m_ids;
+
+        mesh m_mesh;
+    };
+
+    // Sweep a plane along each axis, keep only faces between a wall and open space,
+    // then grow each face into the largest rectangle of faces pointing the same way
+    void greedy_mesh(const wall_volume &volume, mesh_builder &builder)
+    {
+        const auto &dims = volume.dims();
+
+        std::vector<std::int8_t> mask;
+
+        for (auto d = 0; d < 3; ++d)
+        {
+            const int u = (d + 1) % 3, v = (d + 2) % 3;
+            const int du = dims[static_cast<size_t>(u)], dv = dims[static_cast<size_t>(v)];
+
+            mask.assign(static_cast<size_t>(du) * static_cast<size_t>(dv), 0);
+
+            for (auto s = 0; s <= dims[static_cast<size_t>(d)]; ++s)
+            {
+                std::array<int, 3> behind{}, ahead{};
+                behind[static_cast<size_t>(d)] = s - 1;
+                ahead[static_cast<size_t>(d)] = s;
+
+                for (auto j = 0; j < dv; ++j)
+                {
+                    behind[static_cast<size_t>(v)] = ahead[static_cast<size_t>(v)] = j;
+
+                    for (auto i = 0; i < du; ++i)
+                    {
+                        behind[static_cast<size_t>(u)] = ahead[static_cast<size_t>(u)] = i;
+
+                        const bool a = volume.solid(behind), b = volume.solid(ahead);
+
+                        mask[static_cast<size_t>(j) * static_cast<size_t>(du) + static_cast<size_t>(i)] = static_cast<std::int8_t>(a == b ? 0 : (a ? 1 : -1));
+                    }
+                }
+
+                for (auto j = 0; j < dv; ++j)
+                {
+                    for (auto i = 0; i < du;)
+                    {
+                        auto *row = mask.data() + static_cast<size_t>(j) * static_cast<size_t>(du);
+                        const auto facing = row[i];
+
+                        if (facing == 0)
+                        {
+                            ++i;
+
+                            continue;
+                        }
+
+                        int w = 1;
+                        while (i + w < du && row[i + w] == facing)
+                        {
+                            ++w;
+                        }
+
+                        int h = 1;
+                        while (j + h < dv)
+                        {
+                            const auto *next = row + static_cast<size_t>(h) * static_cast<size_t>(du) + i;
+
+                            if (!std::all_of(next, next + w, [facing](auto m)
+                                             { return m == facing; }))
+                            {
+                                break;
+                            }
+
+                            ++h;
+                        }
+
+                        std::array<int, 3> p0{};
+                        p0[static_cast<size_t>(d)] = s;
+                        p0[static_cast<size_t>(u)] = i;
+                        p0[static_cast<size_t>(v)] = j;
+
+                        auto p1 = p0, p2 = p0, p3 = p0;
+                        p1[static_cast<size_t>(u)] += w;
+                        p2[static_cast<size_t>(u)] += w;
+                        p2[static_cast<size_t>(v)] += h;
+                        p3[static_cast<size_t>(v)] += h;
+
+                        // u cross v points along +d, so the face of a wall behind the plane keeps this order
+                        if (facing > 0)
+                        {
+                            builder.quad({p0, p1, p2, p3});
+                        }
+                        else
+                        {
+                            builder.quad({p0, p3, p2, p1});
+                        }
+
+                        for (auto l = 0; l < h; ++l)
+                        {
+                            std::fill_n(row + static_cast<size_t>(l) * static_cast<size_t>(du) + i, w, std::int8_t{0});
+                        }
+
+                        i += w;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// @brief Generate 3D mesh data from the links of the grid for Wavefront object file output
+/// @details Walls of every level are read from its link masks, stacked one unit per level
+/// @details Faces hidden between touching walls are dropped, the rest are merged into large rectangles with shared vertices
 /// @param g The grid interface
 /// @param rng Random number generator (unused but required by interface)
 /// @return True if successful, false otherwise
@@ -27,96 +269,33 @@ bool objectify::run(grid_interface *g, [[maybe_unused]] randomizer &rng) const n
         return false;
     }
 
-    // Get the grid operations to access dimensions and other methods
-    const auto &grid_ops = g->operations();
-    auto dimensions = grid_ops.get_dimensions();
-    if (get<0>(dimensions) == 0 || get<1>(dimensions) == 0 || get<2>(dimensions) == 0)
+    auto &grid_ops = g->operations();
+    auto [rows, columns, levels] = grid_ops.get_dimensions();
+    if (rows == 0 || columns == 0 || levels == 0)
     {
         // Handle invalid dimensions
         return false;
     }
 
-    // Get the string representation of the maze
-    std::string str = grid_ops.get_str();
-    if (str.empty())
+    if (static_cast<size_t>(grid_ops.get_link_masks().size()) != static_cast<size_t>(rows) * columns * levels)
     {
         return false;
     }
 
-    // Prepare data structures for vertices and faces
-    std::vector<std::tuple<int, int, int, int>> vertices;
-    std::vector<std::vector<std::uint32_t>> faces;
-
-    // Lambda to add a block (cube) at given position
-    auto add_block = [&vertices, &faces](int x, int y, int z, int w, int block_size)
+    try
     {
-        // Calculate the base index for the new vertices (OBJ format is 1-indexed)
-        std::uint32_t baseIndex = static_cast<std::uint32_t>(vertices.size() + 1);
-
-        // Define the 8 vertices of the cube
-        vertices.emplace_back(x, y, z, w);
-        vertices.emplace_back(x + block_size, y, z, w);
-        vertices.emplace_back(x + block_size, y + block_size, z, w);
-        vertices.emplace_back(x, y + block_size, z, w);
-        vertices.emplace_back(x, y, z + block_size, w);
-        vertices.emplace_back(x + block_size, y, z + block_size, w);
-        vertices.emplace_back(x + block_size, y + block_size, z + block_size, w);
-        vertices.emplace_back(x, y + block_size, z + block_size, w);
-
-        // Define faces using the vertices above (12 triangles for 6 faces of a cube)
-        // Bottom face (z=0)
-        faces.emplace_back(std::vector<std::uint32_t>{baseIndex, baseIndex + 1, baseIndex + 2});
-        faces.emplace_back(std::vector<std::uint32_t>{baseIndex, baseIndex + 2, baseIndex + 3});
-        // Top face (z=block_size)
-        faces.emplace_back(std::vector<std::uint32_t>{baseIndex + 4, baseIndex + 6, baseIndex + 5});
-        faces.emplace_back(std::vector<std::uint32_t>{baseIndex + 4, baseIndex + 7, baseIndex + 6});
-        // Left face (x=0)
-        faces.emplace_back(std::vector<std::uint32_t>{baseIndex, baseIndex + 3, baseIndex + 7});
-        faces.emplace_back(std::vector<std::uint32_t>{baseIndex, baseIndex + 7, baseIndex + 4});
-        // Right face (x=block_size)
-        faces.emplace_back(std::vector<std::uint32_t>{baseIndex + 1, baseIndex + 5, baseIndex + 6});
-        faces.emplace_back(std::vector<std::uint32_t>{baseIndex + 1, baseIndex + 6, baseIndex + 2});
-        // Front face (y=block_size)
-        faces.emplace_back(std::vector<std::uint32_t>{baseIndex + 3, baseIndex + 2, baseIndex + 6});
-        faces.emplace_back(std::vector<std::uint32_t>{baseIndex + 3, baseIndex + 6, baseIndex + 7});
-        // Back face (y=0)
-        faces.emplace_back(std::vector<std::uint32_t>{baseIndex, baseIndex + 4, baseIndex + 5});
-        faces.emplace_back(std::vector<std::uint32_t>{baseIndex, baseIndex + 5, baseIndex + 1});
-    };
+        const wall_volume volume{grid_ops};
 
-    // Parse the string representation and create 3D blocks for walls
-    int row_x = 0;
-    int col_z = 0;
+        mesh_builder builder{volume.dims()};
 
-    std::string_view sv(str);
-    for (size_t i = 0; i < sv.size(); ++i)
-    {
-        if (sv[i] == '\n')
-        {
-            row_x++;
-            col_z = 0;
-            continue;
-        }
+        greedy_mesh(volume, builder);
 
-        // Create blocks for wall characters
-        if (sv[i] == static_cast<char>(barriers::CORNER) ||
-            sv[i] == static_cast<char>(barriers::HORIZONTAL) ||
-            sv[i] == static_cast<char>(barriers::VERTICAL))
-        {
-            static constexpr auto block_size = 1;
-            for (auto h = 0; h < static_cast<int>(std::get<2>(dimensions)); ++h)
-            {
-                add_block(row_x, col_z, h, 0, block_size); // w=0 for now, could use block_id from config
-            }
-        }
-        col_z++;
+        grid_ops.set_mesh(std::move(builder.result()));
+    }
+    catch (const std::exception &)
+    {
+        return false;
     }
-
-    // Store the generated vertices and faces in the grid operations
-    // Need to cast to non-const to call the setter methods
-    auto &mutable_grid_ops = const_cast<grid_operations &>(grid_ops);
-    mutable_grid_ops.set_vertices(vertices);
-    mutable_grid_ops.set_faces(faces);
 
     return true;
 } // run
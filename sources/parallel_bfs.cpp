@@ -0,0 +1,280 @@
+#include <MazeBuilder/parallel_bfs.h>
+
+#include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
+#include <MazeBuilder/worker_team.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <thread>
+
+using namespace mazes;
+
+namespace
+{
+    using offsets_t = std::array<std::int32_t, static_cast<size_t>(Direction::COUNT)>;
+
+    // First item of part b when count items are split into parts
+    size_t split(size_t count, size_t b, size_t parts) noexcept
+    {
+        return static_cast<size_t>(static_cast<std::uint64_t>(count) * b / parts);
+    }
+
+    // Expand part of a top-down frontier, claiming cells atomically when other threads expand the same level
+    template <bool Shared>
+    std::uint64_t expand(const link_masks &masks, const offsets_t &offsets, const std::int32_t *first, const std::int32_t *last, std::int32_t next_distance, std::vector<std::int32_t> &dist, std::vector<std::int32_t> &found)
+    {
+        std::uint64_t links = 0;
+
+        for (; first != last; ++first)
+        {
+            const auto current = *first;
+
+            for (auto bits = static_cast<unsigned int>(masks.get(current)); bits != 0; bits &= bits - 1)
+            {
+                const auto neighbor = current + offsets[static_cast<size_t>(std::countr_zero(bits))];
+                auto &d = dist[static_cast<size_t>(neighbor)];
+
+                if constexpr (Shared)
+                {
+                    std::atomic_ref<std::int32_t> claim{d};
+
+                    auto expected = std::int32_t{-1};
+
+                    if (claim.load(std::memory_order_relaxed) >= 0 || !claim.compare_exchange_strong(expected, next_distance, std::memory_order_relaxed))
+                    {
+                        continue;
+                    }
+                }
+                else
+                {
+                    if (d >= 0)
+                    {
+                        continue;
+                    }
+
+                    d = next_distance;
+                }
+
+                found.push_back(neighbor);
+                links += static_cast<std::uint64_t>(std::popcount(static_cast<unsigned int>(masks.get(neighbor))));
+            }
+        }
+
+        return links;
+    }
+} // namespace
+
+/// @brief Search on several threads
+/// @param threads
+/// @param grain
+parallel_bfs::parallel_bfs(unsigned int threads, std::size_t grain) noexcept
+    : m_threads{threads}, m_grain{(grain == 0) ? GRAIN : grain}, m_bottom_up_levels{0}, m_frontier{}, m_next{}, m_locals{}, m_local_links{}, m_frontier_bits{}, m_next_bits{}, m_team{}
+{
+}
+
+/// @brief Stop the threads of the search
+parallel_bfs::~parallel_bfs() = default;
+
+/// @brief Expand level by level, choosing top-down or bottom-up for each level
+/// @param ops
+/// @param root_index
+/// @param max_distance
+/// @return
+std::vector<std::int32_t> parallel_bfs::run(const grid_operations &ops, std::int32_t root_index, std::int32_t max_distance)
+{
+    const auto &masks = ops.get_link_masks();
+
+    const auto total = static_cast<size_t>(masks.size());
+
+    std::vector<std::int32_t> dist(total, -1);
+
+    m_bottom_up_levels = 0;
+
+    if (root_index < 0 || static_cast<size_t>(root_index) >= total)
+    {
+        return dist;
+    }
+
+    const auto threads = (m_threads == 0) ? std::max(1u, std::thread::hardware_concurrency()) : m_threads;
+
+    auto [rows, columns, levels] = ops.get_dimensions();
+
+    // A link only exists toward a neighbor inside the grid, so the offsets need no bounds checks
+    const auto plane = static_cast<std::int32_t>(rows * columns);
+    const offsets_t offsets{-static_cast<std::int32_t>(columns), static_cast<std::int32_t>(columns), 1, -1, plane, -plane};
+
+    auto links_of = [&masks](size_t cell)
+    {
+        return static_cast<std::uint64_t>(std::popcount(static_cast<unsigned int>(masks.get(static_cast<int>(cell)))));
+    };
+
+    // Links out of cells not reached yet, each passage is counted from both of its cells
+    std::uint64_t unexplored_links = 0;
+
+    for (size_t cell = 0; cell < total; ++cell)
+    {
+        unexplored_links += links_of(cell);
+    }
+
+    const auto words = (total + 63) / 64;
+
+    dist[static_cast<size_t>(root_index)] = 0;
+
+    m_frontier.assign(1, root_index);
+
+    std::uint64_t frontier_links = links_of(static_cast<size_t>(root_index));
+    size_t frontier_count = 1;
+
+    unexplored_links -= frontier_links;
+
+    bool bottom_up = false;
+
+    for (std::int32_t level = 0; frontier_count > 0 && level < max_distance; ++level)
+    {
+        if (!bottom_up && frontier_links > unexplored_links / ALPHA && frontier_count * BETA >= total)
+        {
+            // Many frontier links left to check, let the unvisited cells look for a parent instead
+            m_frontier_bits.assign(words, 0);
+
+            for (const auto cell : m_frontier)
+            {
+                m_frontier_bits[static_cast<size_t>(cell) / 64] |= std::uint64_t{1} << (static_cast<unsigned int>(cell) % 64);
+            }
+
+            bottom_up = true;
+        }
+        else if (bottom_up && frontier_count * BETA < total)
+        {
+            m_frontier.clear();
+
+            for (size_t w = 0; w < words; ++w)
+            {
+                for (auto bits = m_frontier_bits[w]; bits != 0; bits &= bits - 1)
+                {
+                    m_frontier.push_back(static_cast<std::int32_t>(w * 64 + static_cast<size_t>(std::countr_zero(bits))));
+                }
+            }
+
+            bottom_up = false;
+        }
+
+        const auto next_distance = level + 1;
+
+        if (bottom_up)
+        {
+            const auto parts = static_cast<size_t>(std::min<std::uint64_t>(threads, words));
+
+            m_next_bits.resize(words);
+            m_local_links.assign(parts * 2, 0);
+
+            // Parts own whole words of the next bitmap, and only write distances of their own cells
+            team(threads).for_each(parts, [&](size_t b)
+                                   {
+                std::uint64_t found = 0, links = 0;
+
+                for (auto w = split(words, b, parts); w < split(words, b + 1, parts); ++w)
+                {
+                    std::uint64_t next_word = 0;
+
+                    for (size_t cell = w * 64; cell < std::min(total, w * 64 + 64); ++cell)
+                    {
+                        if (dist[cell] >= 0)
+                        {
+                            continue;
+                        }
+
+                        for (auto bits = static_cast<unsigned int>(masks.get(static_cast<int>(cell))); bits != 0; bits &= bits - 1)
+                        {
+                            const auto neighbor = static_cast<size_t>(static_cast<std::int32_t>(cell) + offsets[static_cast<size_t>(std::countr_zero(bits))]);
+
+                            if ((m_frontier_bits[neighbor / 64] >> (neighbor % 64)) & 1u)
+                            {
+                                dist[cell] = next_distance;
+                                next_word |= std::uint64_t{1} << (cell % 64);
+                                ++found;
+                                links += links_of(cell);
+
+                                break;
+                            }
+                        }
+                    }
+
+                    m_next_bits[w] = next_word;
+                }
+
+                m_local_links[b * 2] = found;
+                m_local_links[b * 2 + 1] = links; });
+
+            frontier_count = 0;
+            frontier_links = 0;
+
+            for (size_t b = 0; b < parts; ++b)
+            {
+                frontier_count += static_cast<size_t>(m_local_links[b * 2]);
+                frontier_links += m_local_links[b * 2 + 1];
+            }
+
+            m_frontier_bits.swap(m_next_bits);
+
+            ++m_bottom_up_levels;
+        }
+        else
+        {
+            // Small frontiers are not worth waking other threads for
+            const auto parts = std::max<size_t>(1, std::min<size_t>(threads, m_frontier.size() / m_grain));
+
+            m_locals.resize(std::max(m_locals.size(), parts));
+            m_local_links.assign(parts, 0);
+
+            if (parts == 1)
+            {
+                m_next.clear();
+
+                frontier_links = expand<false>(masks, offsets, m_frontier.data(), m_frontier.data() + m_frontier.size(), next_distance, dist, m_next);
+            }
+            else
+            {
+                team(threads).for_each(parts, [&](size_t b)
+                                       {
+                    auto &found = m_locals[b];
+                    found.clear();
+
+                    m_local_links[b] = expand<true>(masks, offsets, m_frontier.data() + split(m_frontier.size(), b, parts), m_frontier.data() + split(m_frontier.size(), b + 1, parts), next_distance, dist, found); });
+
+                // Gather the local queues in band order
+                m_next.clear();
+                frontier_links = 0;
+
+                for (size_t b = 0; b < parts; ++b)
+                {
+                    m_next.insert(m_next.end(), m_locals[b].cbegin(), m_locals[b].cend());
+                    frontier_links += m_local_links[b];
+                }
+            }
+
+            m_frontier.swap(m_next);
+
+            frontier_count = m_frontier.size();
+        }
+
+        unexplored_links -= frontier_links;
+    }
+
+    return dist;
+}
+
+/// @brief Get the threads of the search, they are started the first time a level is expanded in parallel
+/// @param threads
+/// @return
+worker_team &parallel_bfs::team(unsigned int threads)
+{
+    if (!m_team)
+    {
+        m_team = std::make_unique<worker_team>(threads);
+    }
+
+    return *m_team;
+}
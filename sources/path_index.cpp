@@ -0,0 +1,241 @@
+#include <MazeBuilder/path_index.h>
+
+#include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <utility>
+
+using namespace mazes;
+
+/// @brief Walk the tree depth-first from the root, then index the depths of the walk
+/// @param ops
+/// @param root_index
+path_index::path_index(const grid_operations &ops, std::int32_t root_index)
+    : m_parent{}, m_depth{}, m_position{}, m_order{}, m_block_masks{}, m_sparse{}, m_blocks{0}
+{
+    const auto &masks = ops.get_link_masks();
+
+    const auto total = static_cast<std::size_t>(masks.size());
+
+    m_parent.assign(total, -1);
+    m_depth.assign(total, -1);
+    m_position.assign(total, -1);
+
+    if (root_index < 0 || static_cast<std::size_t>(root_index) >= total)
+    {
+        return;
+    }
+
+    auto [rows, columns, levels] = ops.get_dimensions();
+
+    // A link only exists toward a neighbor inside the grid, so the offsets need no bounds checks
+    const auto plane = static_cast<std::int32_t>(rows * columns);
+    const std::array<std::int32_t, static_cast<std::size_t>(Direction::COUNT)> offsets{-static_cast<std::int32_t>(columns), static_cast<std::int32_t>(columns), 1, -1, plane, -plane};
+
+    // Cells are numbered when popped, so every subtree is a contiguous run of the order
+    m_order.reserve(total);
+
+    std::vector<std::int32_t> stack;
+    stack.push_back(root_index);
+    m_depth[static_cast<std::size_t>(root_index)] = 0;
+
+    while (!stack.empty())
+    {
+        const auto current = stack.back();
+        stack.pop_back();
+
+        m_position[static_cast<std::size_t>(current)] = static_cast<std::int32_t>(m_order.size());
+        m_order.push_back(current);
+
+        for (auto bits = static_cast<unsigned int>(masks.get(current)); bits != 0; bits &= bits - 1)
+        {
+            const auto neighbor = current + offsets[static_cast<std::size_t>(std::countr_zero(bits))];
+
+            if (m_depth[static_cast<std::size_t>(neighbor)] < 0)
+            {
+                m_depth[static_cast<std::size_t>(neighbor)] = m_depth[static_cast<std::size_t>(current)] + 1;
+                m_parent[static_cast<std::size_t>(neighbor)] = current;
+                stack.push_back(neighbor);
+            }
+        }
+    }
+
+    const auto count = m_order.size();
+
+    // Inside a block, keep the positions whose depth is below every later position so far
+    m_block_masks.resize(count);
+
+    std::uint64_t stack_mask = 0;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto block_start = i / BLOCK * BLOCK;
+
+        if (i == block_start)
+        {
+            stack_mask = 0;
+        }
+
+        const auto depth = m_depth[static_cast<std::size_t>(m_order[i])];
+
+        while (stack_mask != 0 && m_depth[static_cast<std::size_t>(m_order[block_start + 63 - static_cast<std::size_t>(std::countl_zero(stack_mask))])] >= depth)
+        {
+            stack_mask &= ~(std::uint64_t{1} << (63 - std::countl_zero(stack_mask)));
+        }
+
+        stack_mask |= std::uint64_t{1} << (i - block_start);
+        m_block_masks[i] = stack_mask;
+    }
+
+    // Sparse table over the shallowest position of each block
+    m_blocks = (count + BLOCK - 1) / BLOCK;
+
+    const auto table_levels = static_cast<std::size_t>(std::bit_width(m_blocks));
+
+    m_sparse.resize(table_levels * m_blocks);
+
+    for (std::size_t b = 0; b < m_blocks; ++b)
+    {
+        m_sparse[b] = static_cast<std::int32_t>(shallowest_in_block(b * BLOCK, std::min(count, b * BLOCK + BLOCK) - 1));
+    }
+
+    for (std::size_t k = 1; k < table_levels; ++k)
+    {
+        const auto half = std::size_t{1} << (k - 1);
+
+        for (std::size_t b = 0; b + (std::size_t{1} << k) <= m_blocks; ++b)
+        {
+            const auto left = static_cast<std::size_t>(m_sparse[(k - 1) * m_blocks + b]);
+            const auto right = static_cast<std::size_t>(m_sparse[(k - 1) * m_blocks + b + half]);
+
+            m_sparse[k * m_blocks + b] = static_cast<std::int32_t>(shallower(left, right));
+        }
+    }
+}
+
+std::size_t path_index::shallower(std::size_t i, std::size_t j) const noexcept
+{
+    return (m_depth[static_cast<std::size_t>(m_order[j])] < m_depth[static_cast<std::size_t>(m_order[i])]) ? j : i;
+}
+
+/// @brief The lowest kept position at or after first is the minimum up to last
+/// @param first
+/// @param last
+/// @return
+std::size_t path_index::shallowest_in_block(std::size_t first, std::size_t last) const noexcept
+{
+    const auto block_start = first / BLOCK * BLOCK;
+
+    const auto kept = m_block_masks[last] & (~std::uint64_t{0} << (first - block_start));
+
+    return block_start + static_cast<std::size_t>(std::countr_zero(kept));
+}
+
+std::size_t path_index::shallowest(std::size_t first, std::size_t last) const noexcept
+{
+    const auto first_block = first / BLOCK, last_block = last / BLOCK;
+
+    if (first_block == last_block)
+    {
+        return shallowest_in_block(first, last);
+    }
+
+    auto best = shallower(shallowest_in_block(first, first_block * BLOCK + BLOCK - 1), shallowest_in_block(last_block * BLOCK, last));
+
+    if (first_block + 1 < last_block)
+    {
+        // Two overlapping runs of blocks cover the blocks in between
+        const auto span = last_block - first_block - 1;
+        const auto k = static_cast<std::size_t>(std::bit_width(span)) - 1;
+
+        best = shallower(best, static_cast<std::size_t>(m_sparse[k * m_blocks + first_block + 1]));
+        best = shallower(best, static_cast<std::size_t>(m_sparse[k * m_blocks + last_block - (std::size_t{1} << k)]));
+    }
+
+    return best;
+}
+
+/// @brief The shallowest cell strictly after a and up to b in the order is a child of the ancestor
+/// @param a
+/// @param b
+/// @return
+std::int32_t path_index::lowest_common_ancestor(std::int32_t a, std::int32_t b) const noexcept
+{
+    if (!contains(a) || !contains(b))
+    {
+        return -1;
+    }
+
+    if (a == b)
+    {
+        return a;
+    }
+
+    auto first = static_cast<std::size_t>(m_position[static_cast<std::size_t>(a)]);
+    auto last = static_cast<std::size_t>(m_position[static_cast<std::size_t>(b)]);
+
+    if (first > last)
+    {
+        std::swap(first, last);
+    }
+
+    return m_parent[static_cast<std::size_t>(m_order[shallowest(first + 1, last)])];
+}
+
+std::int32_t path_index::distance(std::int32_t a, std::int32_t b) const noexcept
+{
+    const auto ancestor = lowest_common_ancestor(a, b);
+
+    if (ancestor < 0)
+    {
+        return -1;
+    }
+
+    return m_depth[static_cast<std::size_t>(a)] + m_depth[static_cast<std::size_t>(b)] - 2 * m_depth[static_cast<std::size_t>(ancestor)];
+}
+
+/// @brief Climb from both cells to their ancestor
+/// @param a
+/// @param b
+/// @param cells
+/// @return
+bool path_index::path(std::int32_t a, std::int32_t b, std::vector<std::int32_t> &cells) const
+{
+    cells.clear();
+
+    const auto ancestor = lowest_common_ancestor(a, b);
+
+    if (ancestor < 0)
+    {
+        return false;
+    }
+
+    cells.reserve(static_cast<std::size_t>(distance(a, b)) + 1);
+
+    for (auto step = a; step != ancestor; step = m_parent[static_cast<std::size_t>(step)])
+    {
+        cells.push_back(step);
+    }
+
+    cells.push_back(ancestor);
+
+    // Climb from b after the ancestor, then turn that half around
+    const auto turn = cells.size();
+
+    for (auto step = b; step != ancestor; step = m_parent[static_cast<std::size_t>(step)])
+    {
+        cells.push_back(step);
+    }
+
+    std::reverse(cells.begin() + static_cast<std::ptrdiff_t>(turn), cells.end());
+
+    return true;
+}
+
+bool path_index::contains(std::int32_t index) const noexcept
+{
+    return index >= 0 && static_cast<std::size_t>(index) < m_position.size() && m_position[static_cast<std::size_t>(index)] >= 0;
+}
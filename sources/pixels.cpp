@@ -1,79 +1,247 @@
 #include <MazeBuilder/pixels.h>
 
 #include <MazeBuilder/grid_interface.h>
+#include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
 #include <MazeBuilder/randomizer.h>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <string>
+#include <utility>
+
 using namespace mazes;
 
-/// @brief Provide a string representation of the grid
+namespace
+{
+    // Pixels are handled as 32-bit words holding the RGBA bytes in memory order
+    constexpr std::uint32_t WALL_PIXEL = std::bit_cast<std::uint32_t>(pixels::WALL_COLOR);
+
+    constexpr std::uint32_t FLOOR_PIXEL = std::bit_cast<std::uint32_t>(pixels::FLOOR_COLOR);
+
+    // Background colors are 0xRRGGBB, pixels are opaque
+    std::uint32_t to_pixel(std::uint32_t color) noexcept
+    {
+        return std::bit_cast<std::uint32_t>(std::array<std::uint8_t, pixels::CHANNELS>{static_cast<std::uint8_t>(color >> 16), static_cast<std::uint8_t>(color >> 8), static_cast<std::uint8_t>(color), 255});
+    }
+
+    constexpr unsigned int EAST_SHIFT = static_cast<unsigned int>(Direction::EAST);
+
+    constexpr unsigned int SOUTH_SHIFT = static_cast<unsigned int>(Direction::SOUTH);
+
+    // Image writers take int dimensions and strides, so those bound the image
+    bool fits_image(std::uint64_t width, std::uint64_t height) noexcept
+    {
+        static constexpr std::uint64_t INT_LIMIT = static_cast<std::uint64_t>(std::numeric_limits<int>::max());
+
+        return width * pixels::CHANNELS <= INT_LIMIT && height <= INT_LIMIT && width * height * pixels::CHANNELS <= std::numeric_limits<size_t>::max() / 2;
+    }
+
+    // Builds each distinct scanline once and hands it to emit with how many times it repeats
+    // Lines are filled span by span, a cell or a wall at a time, so there is no branch per pixel
+    template <typename Emit>
+    bool rasterize(const grid_interface &g, unsigned int cell_size, unsigned int wall_size, std::uint64_t width, Emit &&emit)
+    {
+        auto [rows, columns, levels] = g.operations().get_dimensions();
+
+        const auto &masks = g.operations().get_link_masks();
+
+        std::vector<std::uint32_t> line(static_cast<size_t>(width));
+
+        // The floor of every cell in the current row, passages take the color of the cell they leave
+        std::vector<std::uint32_t> floors(columns, FLOOR_PIXEL);
+
+        const bool colored = g.has_background_colors();
+
+        // Top border
+        std::fill_n(line.data(), line.size(), WALL_PIXEL);
+
+        if (!emit(line.data(), wall_size))
+        {
+
+            return false;
+        }
+
+        for (auto r = 0u; r < rows; ++r)
+        {
+            const auto first = static_cast<int>(static_cast<std::int64_t>(r) * columns);
+
+            if (colored)
+            {
+                for (auto c = 0u; c < columns; ++c)
+                {
+                    floors[c] = to_pixel(g.background_color_at(first + static_cast<int>(c)));
+                }
+            }
+
+            // Open cells, each followed by its east wall or passage
+            auto *out = std::fill_n(line.data(), wall_size, WALL_PIXEL);
+            for (auto c = 0u; c < columns; ++c)
+            {
+                // Indexed by the link bit rather than branched on, links in a maze are close to random
+                const std::uint32_t passage[2]{WALL_PIXEL, floors[c]};
+
+                out = std::fill_n(out, cell_size, floors[c]);
+                out = std::fill_n(out, wall_size, passage[(masks.get(first + static_cast<int>(c)) >> EAST_SHIFT) & 1u]);
+            }
+
+            if (!emit(line.data(), cell_size))
+            {
+
+                return false;
+            }
+
+            // South walls or passages, with a corner post after each
+            out = std::fill_n(line.data(), wall_size, WALL_PIXEL);
+            for (auto c = 0u; c < columns; ++c)
+            {
+                const std::uint32_t passage[2]{WALL_PIXEL, floors[c]};
+
+                out = std::fill_n(out, cell_size, passage[(masks.get(first + static_cast<int>(c)) >> SOUTH_SHIFT) & 1u]);
+                out = std::fill_n(out, wall_size, WALL_PIXEL);
+            }
+
+            if (!emit(line.data(), wall_size))
+            {
+
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Rasterizes the whole image into a buffer of width * height pixels
+    bool rasterize_into(const grid_interface &g, unsigned int cell_size, unsigned int wall_size, std::uint64_t width, std::uint8_t *dest)
+    {
+        const auto line_bytes = static_cast<size_t>(width) * pixels::CHANNELS;
+
+        return rasterize(g, cell_size, wall_size, width, [&dest, line_bytes](const std::uint32_t *line, unsigned int repeat)
+                         {
+            for (auto i = 0u; i < repeat; ++i, dest += line_bytes)
+            {
+                std::memcpy(dest, line, line_bytes);
+            }
+
+            return true; });
+    }
+} // namespace
+
+/// @brief Rasterize the grid and keep the RGBA bytes as the grid string
 /// @param g
 /// @param rng
 /// @return
-bool pixels::run([[maybe_unused]] grid_interface *g, [[maybe_unused]] randomizer &rng) const noexcept
+bool pixels::run(grid_interface *g, [[maybe_unused]] randomizer &rng) const noexcept
 {
-    return false;
-    /*  void string_view_utils::pixels(const std::unique_ptr<maze>&m,
-          std::vector<std::tuple<int, int, int, int>>&vertices,
-          std::vector<std::vector<std::uint32_t>>&faces,
-          std::string_view sv) noexcept {
-          using namespace std;*/
-
-    //    if (!m) {
-    //        // Handle null maze pointer
-    //        return;
-    //    }
-
-    //    auto dimensions = m->get_dimensions();
-    //    if (get<0>(dimensions) == 0 || get<1>(dimensions) == 0 || get<2>(dimensions) == 0) {
-    //        // Handle invalid dimensions
-    //        return;
-    //    }
-
-    //    auto add_block = [&vertices, &faces](int x, int y, int z, int w, int block_size) {
-    //        // Calculate the base index for the new vertices
-    //        std::uint32_t baseIndex = static_cast<std::uint32_t>(vertices.size() + 1);
-    //        // Define the 8 vertices of the cube
-    //        vertices.emplace_back(x, y, z, w);
-    //        vertices.emplace_back(x + block_size, y, z, w);
-    //        vertices.emplace_back(x + block_size, y + block_size, z, w);
-    //        vertices.emplace_back(x, y + block_size, z, w);
-    //        vertices.emplace_back(x, y, z + block_size, w);
-    //        vertices.emplace_back(x + block_size, y, z + block_size, w);
-    //        vertices.emplace_back(x + block_size, y + block_size, z + block_size, w);
-    //        vertices.emplace_back(x, y + block_size, z + block_size, w);
-
-    //        // Define faces using the vertices above (12 triangles for 6 faces)
-    //        faces.emplace_back(std::initializer_list<std::uint32_t>{baseIndex, baseIndex + 1, baseIndex + 2});
-    //        faces.emplace_back(std::initializer_list<std::uint32_t>{baseIndex, baseIndex + 2, baseIndex + 3});
-    //        faces.emplace_back(std::initializer_list<std::uint32_t>{baseIndex + 4, baseIndex + 6, baseIndex + 5});
-    //        faces.emplace_back(std::initializer_list<std::uint32_t>{baseIndex + 4, baseIndex + 7, baseIndex + 6});
-    //        faces.emplace_back(std::initializer_list<std::uint32_t>{baseIndex, baseIndex + 3, baseIndex + 7});
-    //        faces.emplace_back(std::initializer_list<std::uint32_t>{baseIndex, baseIndex + 7, baseIndex + 4});
-    //        faces.emplace_back(std::initializer_list<std::uint32_t>{baseIndex + 1, baseIndex + 5, baseIndex + 6});
-    //        faces.emplace_back(std::initializer_list<std::uint32_t>{baseIndex + 1, baseIndex + 6, baseIndex + 2});
-    //        faces.emplace_back(std::initializer_list<std::uint32_t>{baseIndex + 3, baseIndex + 2, baseIndex + 6});
-    //        faces.emplace_back(std::initializer_list<std::uint32_t>{baseIndex + 3, baseIndex + 6, baseIndex + 7});
-    //        faces.emplace_back(std::initializer_list<std::uint32_t>{baseIndex, baseIndex + 4, baseIndex + 5});
-    //        faces.emplace_back(std::initializer_list<std::uint32_t>{baseIndex, baseIndex + 5, baseIndex + 1});
-    //        };
-
-    //    int row_x = 0;
-
-    //    int col_z = 0;
-    //    for (size_t i = 0; i < sv.size(); ++i) {
-    //        if (sv[i] == '\n') {
-    //            row_x++;
-    //            col_z = 0;
-    //            continue;
-    //        }
-
-    //        if (sv[i] == CORNER || sv[i] == BARRIER1 || sv[i] == BARRIER2) {
-    //            static constexpr auto block_size = 1;
-    //            for (auto h = 0; h < std::get<2>(dimensions); ++h) {
-    //                add_block(row_x, col_z, h, m->get_block_id(), block_size);
-    //            }
-    //        }
-    //        col_z++;
-    //    }
-    //}
+
+    if (!g)
+    {
+
+        return false;
+    }
+
+    auto &&ops = g->operations();
+
+    auto [rows, columns, levels] = ops.get_dimensions();
+
+    const auto w = width(columns), h = height(rows);
+
+    if (!fits_image(w, h))
+    {
+
+        return false;
+    }
+
+    try
+    {
+        std::string result(static_cast<size_t>(w * h * CHANNELS), '\0');
+
+        if (!rasterize_into(*g, m_cell_size, m_wall_size, w, reinterpret_cast<std::uint8_t *>(result.data())))
+        {
+
+            return false;
+        }
+
+        ops.set_str(std::move(result));
+    }
+    catch (const std::exception &)
+    {
+
+        return false;
+    }
+
+    return true;
 } // run
+
+/// @brief Rasterize the grid into a buffer of RGBA bytes
+/// @param g
+/// @param rgba
+/// @return
+bool pixels::run(const grid_interface *g, std::vector<std::uint8_t> &rgba) const
+{
+
+    if (!g)
+    {
+
+        return false;
+    }
+
+    auto [rows, columns, levels] = g->operations().get_dimensions();
+
+    const auto w = width(columns), h = height(rows);
+
+    if (!fits_image(w, h))
+    {
+
+        return false;
+    }
+
+    rgba.resize(static_cast<size_t>(w * h * CHANNELS));
+
+    return rasterize_into(*g, m_cell_size, m_wall_size, w, rgba.data());
+}
+
+/// @brief Rasterize the grid one scanline at a time
+/// @param g
+/// @param sink
+/// @return
+bool pixels::run(const grid_interface *g, const scanline_sink &sink) const
+{
+
+    if (!g || !sink)
+    {
+
+        return false;
+    }
+
+    auto [rows, columns, levels] = g->operations().get_dimensions();
+
+    const auto w = width(columns), h = height(rows);
+
+    if (!fits_image(w, h))
+    {
+
+        return false;
+    }
+
+    const auto line_bytes = static_cast<size_t>(w) * CHANNELS;
+
+    return rasterize(*g, m_cell_size, m_wall_size, w, [&sink, line_bytes](const std::uint32_t *line, unsigned int repeat)
+                     {
+        const std::span<const std::uint8_t> scanline{reinterpret_cast<const std::uint8_t *>(line), line_bytes};
+
+        for (auto i = 0u; i < repeat; ++i)
+        {
+            if (!sink(scanline))
+            {
+
+                return false;
+            }
+        }
+
+        return true; });
+}
@@ -0,0 +1,99 @@
+#include <MazeBuilder/ply_writer.h>
+
+#include <MazeBuilder/buildinfo.h>
+#include <MazeBuilder/mesh.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <span>
+#include <string>
+
+using namespace mazes;
+
+namespace
+{
+    // A uchar count of 3, then three uint indices
+    constexpr std::size_t FACE_BYTES = 1 + 3 * sizeof(std::uint32_t);
+
+    // Faces packed per block
+    constexpr std::size_t BLOCK_FACES = std::size_t{1} << 16;
+
+    void put_u32(std::uint8_t *out, std::uint32_t value) noexcept
+    {
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            std::memcpy(out, &value, sizeof(value));
+        }
+        else
+        {
+            out[0] = static_cast<std::uint8_t>(value);
+            out[1] = static_cast<std::uint8_t>(value >> 8);
+            out[2] = static_cast<std::uint8_t>(value >> 16);
+            out[3] = static_cast<std::uint8_t>(value >> 24);
+        }
+    }
+} // namespace
+
+/// @brief Write to a stream
+/// @param os
+ply_writer::ply_writer(std::ostream &os) noexcept
+    : m_os{os}, m_block{}
+{
+}
+
+/// @brief Write the header, then every vertex and face
+/// @param m
+/// @return
+bool ply_writer::write(const mesh &m)
+{
+    std::string header = "ply\nformat binary_little_endian 1.0\n";
+    header += "comment Generated by MazeBuilder " + buildinfo::Version + "\n";
+    header += "element vertex " + std::to_string(m.vertex_count()) + "\nproperty int x\nproperty int y\nproperty int z\n";
+    header += "element face " + std::to_string(m.triangle_count()) + "\nproperty list uchar uint vertex_indices\nend_header\n";
+
+    m_os.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    const auto positions = m.positions();
+
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        // Vertex records are exactly the position buffer
+        m_os.write(reinterpret_cast<const char *>(positions.data()), static_cast<std::streamsize>(positions.size_bytes()));
+    }
+    else
+    {
+        std::uint8_t bytes[4]{};
+
+        for (const auto p : positions)
+        {
+            put_u32(bytes, static_cast<std::uint32_t>(p));
+            m_os.write(reinterpret_cast<const char *>(bytes), 4);
+        }
+    }
+
+    const auto indices = m.indices();
+
+    m_block.resize(std::min(m.triangle_count(), BLOCK_FACES) * FACE_BYTES);
+
+    for (std::size_t first = 0; first < m.triangle_count() && good(); first += BLOCK_FACES)
+    {
+        const auto count = std::min(BLOCK_FACES, m.triangle_count() - first);
+
+        auto *out = m_block.data();
+
+        for (std::size_t t = first; t < first + count; ++t, out += FACE_BYTES)
+        {
+            out[0] = 3;
+            put_u32(out + 1, indices[t * 3]);
+            put_u32(out + 5, indices[t * 3 + 1]);
+            put_u32(out + 9, indices[t * 3 + 2]);
+        }
+
+        m_os.write(reinterpret_cast<const char *>(m_block.data()), static_cast<std::streamsize>(count * FACE_BYTES));
+    }
+
+    m_os.flush();
+
+    return good();
+}
@@ -0,0 +1,662 @@
+#include <MazeBuilder/png_writer.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <exception>
+#include <limits>
+
+using namespace mazes;
+
+namespace
+{
+    constexpr std::uint8_t PNG_SIGNATURE[8]{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+    // Deflate with a 32 KiB window and no preset dictionary, FLEVEL says the fastest compressor was used
+    constexpr std::uint8_t ZLIB_HEADER[2]{0x78, 0x01};
+
+    // An empty stored block that is the last block of the stream
+    constexpr std::uint8_t FINAL_BLOCK[5]{0x01, 0x00, 0x00, 0xFF, 0xFF};
+
+    // An empty stored block that is not the last, after its header bits and the padding to a byte boundary
+    constexpr std::uint8_t SYNC_FLUSH[4]{0x00, 0x00, 0xFF, 0xFF};
+
+    // Bands are sized to about this many bytes of pixels unless asked otherwise
+    constexpr size_t DEFAULT_BAND_BYTES = 1u << 20;
+
+    // Chunk lengths are limited to 2^31 - 1, so large bands are split over several IDAT chunks
+    constexpr size_t MAX_CHUNK_BYTES = 1u << 30;
+
+    constexpr std::uint32_t ADLER_BASE = 65521;
+
+    std::uint32_t adler32(std::span<const std::uint8_t> data) noexcept
+    {
+        // The most bytes that can be summed before the 32-bit sums could overflow
+        static constexpr size_t NMAX = 5552;
+
+        std::uint32_t a = 1, b = 0;
+
+        for (size_t i = 0; i < data.size();)
+        {
+            const auto end = std::min(data.size(), i + NMAX);
+
+            for (; i < end; ++i)
+            {
+                a += data[i];
+                b += a;
+            }
+
+            a %= ADLER_BASE;
+            b %= ADLER_BASE;
+        }
+
+        return (b << 16) | a;
+    }
+
+    // Checksum of two pieces of data from the checksums of each piece, as in zlib's adler32_combine
+    std::uint32_t adler32_combine(std::uint32_t first, std::uint32_t second, std::uint64_t second_length) noexcept
+    {
+        const auto rem = static_cast<std::uint32_t>(second_length % ADLER_BASE);
+
+        std::uint32_t a = first & 0xFFFF;
+        std::uint32_t b = static_cast<std::uint32_t>((static_cast<std::uint64_t>(rem) * a) % ADLER_BASE);
+
+        a += (second & 0xFFFF) + ADLER_BASE - 1;
+        b += ((first >> 16) & 0xFFFF) + ((second >> 16) & 0xFFFF) + ADLER_BASE - rem;
+
+        if (a >= ADLER_BASE)
+        {
+            a -= ADLER_BASE;
+        }
+        if (a >= ADLER_BASE)
+        {
+            a -= ADLER_BASE;
+        }
+        if (b >= (ADLER_BASE << 1))
+        {
+            b -= (ADLER_BASE << 1);
+        }
+        if (b >= ADLER_BASE)
+        {
+            b -= ADLER_BASE;
+        }
+
+        return (b << 16) | a;
+    }
+
+    constexpr std::array<std::uint32_t, 256> make_crc_table() noexcept
+    {
+        std::array<std::uint32_t, 256> table{};
+
+        for (std::uint32_t n = 0; n < 256; ++n)
+        {
+            auto c = n;
+
+            for (auto k = 0; k < 8; ++k)
+            {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+
+            table[n] = c;
+        }
+
+        return table;
+    }
+
+    constexpr auto CRC_TABLE = make_crc_table();
+
+    std::uint32_t crc32(std::uint32_t crc, std::span<const std::uint8_t> data) noexcept
+    {
+        crc = ~crc;
+
+        for (auto byte : data)
+        {
+            crc = CRC_TABLE[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+        }
+
+        return ~crc;
+    }
+
+    void put_u32(std::uint8_t *out, std::uint32_t value) noexcept
+    {
+        out[0] = static_cast<std::uint8_t>(value >> 24);
+        out[1] = static_cast<std::uint8_t>(value >> 16);
+        out[2] = static_cast<std::uint8_t>(value >> 8);
+        out[3] = static_cast<std::uint8_t>(value);
+    }
+
+    // Writes deflate bit fields, least significant bit first
+    class bit_writer
+    {
+    public:
+        explicit bit_writer(std::vector<std::uint8_t> &out) noexcept
+            : m_out{out}, m_bits{0}, m_count{0}
+        {
+        }
+
+        void put(std::uint32_t value, unsigned int count)
+        {
+            m_bits |= static_cast<std::uint64_t>(value) << m_count;
+            m_count += count;
+
+            while (m_count >= 8)
+            {
+                m_out.push_back(static_cast<std::uint8_t>(m_bits));
+                m_bits >>= 8;
+                m_count -= 8;
+            }
+        }
+
+        void align()
+        {
+            if (m_count > 0)
+            {
+                put(0, 8 - m_count);
+            }
+        }
+
+    private:
+        std::vector<std::uint8_t> &m_out;
+
+        std::uint64_t m_bits;
+
+        unsigned int m_count;
+    };
+
+    struct huffman_code
+    {
+        std::uint16_t bits;
+
+        std::uint8_t length;
+    };
+
+    // Huffman codes are sent most significant bit first, so they are stored reversed
+    constexpr std::uint16_t reverse_bits(unsigned int code, unsigned int length) noexcept
+    {
+        unsigned int reversed = 0;
+
+        for (auto i = 0u; i < length; ++i, code >>= 1)
+        {
+            reversed = (reversed << 1) | (code & 1u);
+        }
+
+        return static_cast<std::uint16_t>(reversed);
+    }
+
+    // The fixed literal and length codes of RFC 1951, section 3.2.6
+    constexpr std::array<huffman_code, 288> make_literal_codes() noexcept
+    {
+        std::array<huffman_code, 288> codes{};
+
+        for (auto n = 0u; n < 288; ++n)
+        {
+            if (n <= 143)
+            {
+                codes[n] = {reverse_bits(0x30 + n, 8), 8};
+            }
+            else if (n <= 255)
+            {
+                codes[n] = {reverse_bits(0x190 + n - 144, 9), 9};
+            }
+            else if (n <= 279)
+            {
+                codes[n] = {reverse_bits(n - 256, 7), 7};
+            }
+            else
+            {
+                codes[n] = {reverse_bits(0xC0 + n - 280, 8), 8};
+            }
+        }
+
+        return codes;
+    }
+
+    constexpr auto LITERAL_CODES = make_literal_codes();
+
+    constexpr std::uint16_t LENGTH_BASE[29]{3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+
+    constexpr std::uint8_t LENGTH_EXTRA[29]{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+    constexpr std::uint16_t DISTANCE_BASE[30]{1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+
+    constexpr std::uint8_t DISTANCE_EXTRA[30]{0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    constexpr unsigned int MIN_MATCH = 3, MAX_MATCH = 258;
+
+    constexpr std::int64_t WINDOW_SIZE = 32768;
+
+    constexpr unsigned int HASH_BITS = 15;
+
+    // Longer chains find slightly better matches, maze images mostly repeat at a short distance
+    constexpr unsigned int MAX_CHAIN = 32;
+
+    // Maps a match length to its index in LENGTH_BASE
+    constexpr std::array<std::uint8_t, MAX_MATCH + 1> make_length_symbols() noexcept
+    {
+        std::array<std::uint8_t, MAX_MATCH + 1> symbols{};
+
+        for (auto s = 0u; s < 29; ++s)
+        {
+            const auto last = (s + 1 < 29) ? LENGTH_BASE[s + 1] : MAX_MATCH + 1;
+
+            for (auto len = static_cast<unsigned int>(LENGTH_BASE[s]); len < last; ++len)
+            {
+                symbols[len] = static_cast<std::uint8_t>(s);
+            }
+        }
+
+        return symbols;
+    }
+
+    constexpr auto LENGTH_SYMBOLS = make_length_symbols();
+
+    unsigned int distance_symbol(unsigned int distance) noexcept
+    {
+        return static_cast<unsigned int>(std::upper_bound(std::begin(DISTANCE_BASE), std::end(DISTANCE_BASE), distance) - std::begin(DISTANCE_BASE)) - 1;
+    }
+
+    std::uint32_t hash3(const std::uint8_t *p) noexcept
+    {
+        const std::uint32_t v = p[0] | (static_cast<std::uint32_t>(p[1]) << 8) | (static_cast<std::uint32_t>(p[2]) << 16);
+
+        return (v * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    // Compresses data as one fixed-code block, then a sync flush so the output ends on a byte boundary
+    // Nothing refers back before the start of data, so the output can follow any other band
+    void deflate_band(std::span<const std::uint8_t> data, std::vector<std::uint8_t> &out)
+    {
+        bit_writer w{out};
+
+        // Not the final block, fixed Huffman codes
+        w.put(0, 1);
+        w.put(1, 2);
+
+        auto put_symbol = [&w](unsigned int symbol)
+        {
+            w.put(LITERAL_CODES[symbol].bits, LITERAL_CODES[symbol].length);
+        };
+
+        std::vector<std::int64_t> head(size_t{1} << HASH_BITS, -1);
+        std::vector<std::int64_t> prev(static_cast<size_t>(WINDOW_SIZE), -1);
+
+        const auto n = static_cast<std::int64_t>(data.size());
+        const auto *bytes = data.data();
+
+        auto insert = [&head, &prev, bytes, n](std::int64_t pos)
+        {
+            if (pos + MIN_MATCH <= n)
+            {
+                auto &h = head[hash3(bytes + pos)];
+                prev[static_cast<size_t>(pos & (WINDOW_SIZE - 1))] = h;
+                h = pos;
+            }
+        };
+
+        for (std::int64_t i = 0; i < n;)
+        {
+            unsigned int best_length = 0, best_distance = 0;
+
+            if (i + MIN_MATCH <= n)
+            {
+                const auto limit = static_cast<unsigned int>(std::min<std::int64_t>(MAX_MATCH, n - i));
+
+                auto candidate = head[hash3(bytes + i)];
+
+                for (auto chain = 0u; candidate >= 0 && i - candidate <= WINDOW_SIZE && chain < MAX_CHAIN; ++chain)
+                {
+                    const auto *a = bytes + candidate;
+                    const auto *b = bytes + i;
+
+                    if (a[best_length] == b[best_length])
+                    {
+                        auto length = 0u;
+                        while (length < limit && a[length] == b[length])
+                        {
+                            ++length;
+                        }
+
+                        if (length > best_length)
+                        {
+                            best_length = length;
+                            best_distance = static_cast<unsigned int>(i - candidate);
+
+                            if (length == limit)
+                            {
+                                break;
+                            }
+                        }
+                    }
+
+                    const auto next = prev[static_cast<size_t>(candidate & (WINDOW_SIZE - 1))];
+
+                    if (next >= candidate)
+                    {
+                        break;
+                    }
+
+                    candidate = next;
+                }
+            }
+
+            if (best_length >= MIN_MATCH)
+            {
+                const auto ls = LENGTH_SYMBOLS[best_length];
+                put_symbol(257 + ls);
+                w.put(best_length - LENGTH_BASE[ls], LENGTH_EXTRA[ls]);
+
+                const auto ds = distance_symbol(best_distance);
+                w.put(reverse_bits(ds, 5), 5);
+                w.put(best_distance - DISTANCE_BASE[ds], DISTANCE_EXTRA[ds]);
+
+                for (auto k = 0u; k < best_length; ++k)
+                {
+                    insert(i + k);
+                }
+
+                i += best_length;
+            }
+            else
+            {
+                put_symbol(bytes[i]);
+                insert(i);
+                ++i;
+            }
+        }
+
+        // End of block
+        put_symbol(256);
+
+        // Empty stored block, not final
+        w.put(0, 3);
+        w.align();
+        out.insert(out.end(), std::begin(SYNC_FLUSH), std::end(SYNC_FLUSH));
+    }
+
+    std::uint8_t paeth(int a, int b, int c) noexcept
+    {
+        const auto p = a + b - c;
+        const auto pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+
+        return static_cast<std::uint8_t>((pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c);
+    }
+
+    // Filters one row with each PNG filter and keeps the one with the smallest sum of signed bytes
+    // up is the unfiltered row above, or nullptr on the first row of the image
+    void filter_row(const std::uint8_t *row, const std::uint8_t *up, size_t row_bytes, unsigned int bpp, std::uint8_t *out, std::vector<std::uint8_t> &scratch)
+    {
+        scratch.resize(row_bytes);
+
+        std::uint64_t best_cost = std::numeric_limits<std::uint64_t>::max();
+
+        for (std::uint8_t type = 0; type < 5; ++type)
+        {
+            // Without a row above, Up is the same as None and Paeth the same as Sub
+            if (!up && (type == 2 || type == 4))
+            {
+                continue;
+            }
+
+            std::uint64_t cost = 0;
+
+            for (size_t x = 0; x < row_bytes; ++x)
+            {
+                const int a = (x >= bpp) ? row[x - bpp] : 0;
+                const int b = up ? up[x] : 0;
+                const int c = (up && x >= bpp) ? up[x - bpp] : 0;
+
+                std::uint8_t predicted = 0;
+                switch (type)
+                {
+                case 1:
+                    predicted = static_cast<std::uint8_t>(a);
+                    break;
+                case 2:
+                    predicted = static_cast<std::uint8_t>(b);
+                    break;
+                case 3:
+                    predicted = static_cast<std::uint8_t>((a + b) / 2);
+                    break;
+                case 4:
+                    predicted = paeth(a, b, c);
+                    break;
+                default:
+                    break;
+                }
+
+                const auto filtered = static_cast<std::uint8_t>(row[x] - predicted);
+                scratch[x] = filtered;
+                cost += static_cast<std::uint64_t>(std::abs(static_cast<int>(static_cast<std::int8_t>(filtered))));
+            }
+
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                out[0] = type;
+                std::copy(scratch.begin(), scratch.end(), out + 1);
+            }
+        }
+    }
+} // namespace
+
+/// @brief Start a PNG on a stream
+/// @param os
+/// @param width
+/// @param height
+/// @param channels
+/// @param threads
+/// @param band_rows
+png_writer::png_writer(std::ostream &os, unsigned int width, unsigned int height, unsigned int channels, unsigned int threads, unsigned int band_rows)
+    : m_os{os}, m_height{height}, m_channels{channels}, m_team{threads}, m_band_rows{band_rows}, m_row_bytes{static_cast<size_t>(width) * channels}, m_rows_written{0}, m_bands_written{0}, m_adler{1}, m_good{true}, m_finished{false}
+{
+    static constexpr std::uint8_t COLOR_TYPES[5]{0, 0, 4, 2, 6};
+
+    static constexpr auto PNG_LIMIT = static_cast<std::uint64_t>(std::numeric_limits<std::int32_t>::max());
+
+    if (width == 0 || height == 0 || channels == 0 || channels > 4 || width > PNG_LIMIT || height > PNG_LIMIT || m_row_bytes + 1 > PNG_LIMIT)
+    {
+        m_good = false;
+
+        return;
+    }
+
+    if (m_band_rows == 0)
+    {
+        m_band_rows = static_cast<unsigned int>(std::max<size_t>(1, DEFAULT_BAND_BYTES / m_row_bytes));
+    }
+
+    m_band_rows = std::min(m_band_rows, m_height);
+
+    m_os.write(reinterpret_cast<const char *>(PNG_SIGNATURE), sizeof(PNG_SIGNATURE));
+
+    std::uint8_t header[13]{};
+    put_u32(header, width);
+    put_u32(header + 4, height);
+    // 8 bits per channel, deflate, adaptive filtering, not interlaced
+    header[8] = 8;
+    header[9] = COLOR_TYPES[channels];
+
+    write_chunk("IHDR", header);
+}
+
+/// @brief Add the next scanline
+/// @param scanline
+/// @return
+bool png_writer::write_row(std::span<const std::uint8_t> scanline)
+{
+
+    if (scanline.size() != m_row_bytes)
+    {
+        m_good = false;
+    }
+
+    return write_rows(scanline);
+}
+
+/// @brief Add the next scanlines
+/// @param rows
+/// @return
+bool png_writer::write_rows(std::span<const std::uint8_t> rows)
+{
+
+    if (!good() || m_finished || rows.size() % m_row_bytes != 0 || rows.size() / m_row_bytes > m_height - m_rows_written)
+    {
+        m_good = false;
+
+        return false;
+    }
+
+    m_rows_written += static_cast<unsigned int>(rows.size() / m_row_bytes);
+
+    const auto batch_bytes = static_cast<size_t>(m_band_rows) * m_team.size() * m_row_bytes;
+
+    while (!rows.empty())
+    {
+        const auto take = std::min(rows.size(), batch_bytes - m_pending.size());
+
+        m_pending.insert(m_pending.end(), rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(take));
+        rows = rows.subspan(take);
+
+        if (m_pending.size() == batch_bytes)
+        {
+            flush_batch();
+        }
+    }
+
+    return good();
+}
+
+/// @brief Compress the remaining rows and end the image
+/// @return
+bool png_writer::finish()
+{
+
+    if (!good() || m_finished)
+    {
+
+        return false;
+    }
+
+    if (!m_pending.empty())
+    {
+        flush_batch();
+    }
+
+    if (m_rows_written != m_height)
+    {
+        m_good = false;
+
+        return false;
+    }
+
+    std::uint8_t tail[sizeof(FINAL_BLOCK) + 4]{};
+    std::copy(std::begin(FINAL_BLOCK), std::end(FINAL_BLOCK), tail);
+    put_u32(tail + sizeof(FINAL_BLOCK), m_adler);
+
+    write_chunk("IDAT", tail);
+    write_chunk("IEND", {});
+
+    m_finished = true;
+
+    m_os.flush();
+
+    return good();
+}
+
+/// @brief Filter and deflate the pending rows band by band in parallel, then write them in order
+void png_writer::flush_batch()
+{
+    const auto rows = static_cast<unsigned int>(m_pending.size() / m_row_bytes);
+    const auto bands = (rows + m_band_rows - 1) / m_band_rows;
+
+    std::vector<std::vector<std::uint8_t>> compressed(bands);
+    std::vector<std::uint32_t> adlers(bands, 1);
+    std::vector<std::uint64_t> lengths(bands, 0);
+    std::vector<char> failed(bands, 0);
+
+    const auto first_band = m_bands_written;
+
+    auto compress = [&](unsigned int b)
+    {
+        const auto first_row = b * m_band_rows, last_row = std::min(rows, first_row + m_band_rows);
+
+        std::vector<std::uint8_t> filtered((last_row - first_row) * (m_row_bytes + 1));
+        std::vector<std::uint8_t> scratch;
+
+        for (auto r = first_row; r < last_row; ++r)
+        {
+            const auto *row = m_pending.data() + r * m_row_bytes;
+            const auto *up = (r > 0) ? row - m_row_bytes : (m_previous.empty() ? nullptr : m_previous.data());
+
+            filter_row(row, up, m_row_bytes, m_channels, filtered.data() + (r - first_row) * (m_row_bytes + 1), scratch);
+        }
+
+        auto &out = compressed[b];
+        out.reserve(filtered.size() / 4 + 64);
+
+        if (first_band + b == 0)
+        {
+            out.insert(out.end(), std::begin(ZLIB_HEADER), std::end(ZLIB_HEADER));
+        }
+
+        deflate_band(filtered, out);
+
+        adlers[b] = adler32(filtered);
+        lengths[b] = filtered.size();
+    };
+
+    m_team.for_each(bands, [&](size_t b)
+                    {
+        try
+        {
+            compress(static_cast<unsigned int>(b));
+        }
+        catch (const std::exception &)
+        {
+            failed[b] = 1;
+        } });
+
+    for (auto b = 0u; b < bands && good(); ++b)
+    {
+        if (failed[b])
+        {
+            m_good = false;
+
+            break;
+        }
+
+        std::span<const std::uint8_t> data{compressed[b]};
+
+        while (!data.empty())
+        {
+            const auto piece = std::min(data.size(), MAX_CHUNK_BYTES);
+
+            write_chunk("IDAT", data.first(piece));
+            data = data.subspan(piece);
+        }
+
+        m_adler = adler32_combine(m_adler, adlers[b], lengths[b]);
+    }
+
+    m_bands_written += bands;
+
+    m_previous.assign(m_pending.end() - static_cast<std::ptrdiff_t>(m_row_bytes), m_pending.end());
+    m_pending.clear();
+}
+
+/// @brief Write a chunk with its length and checksum
+/// @param type Four letter chunk type
+/// @param data
+void png_writer::write_chunk(const char *type, std::span<const std::uint8_t> data)
+{
+    std::uint8_t length[4]{}, type_bytes[4]{}, crc[4]{};
+
+    put_u32(length, static_cast<std::uint32_t>(data.size()));
+    std::copy(type, type + 4, type_bytes);
+    put_u32(crc, crc32(crc32(0, type_bytes), data));
+
+    m_os.write(reinterpret_cast<const char *>(length), sizeof(length));
+    m_os.write(reinterpret_cast<const char *>(type_bytes), sizeof(type_bytes));
+    m_os.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    m_os.write(reinterpret_cast<const char *>(crc), sizeof(crc));
+}
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <functional>
 #include <random>
+#include <utility>
 
 using namespace mazes;
 
@@ -14,30 +15,66 @@ private:
     std::mt19937 rng_device;
 
 public:
-    randomizer_impl() : rng_device{std::random_device{}()} {}
-
-    template <typename Number = std::int32_t>
-    Number get_range(Number low, Number high) noexcept
+    randomizer_impl() : rng_device{}
     {
 
-        std::uniform_int_distribution<Number> dist{low, high};
-
-        return dist(rng_device);
+        seed();
     }
 
     /// @brief Generates a random integer within a specified range.
-    /// @param low defaults to 0
-    /// @param high defaults to 1
-    /// @param count defaults to 1
+    /// @details Bounded with the same specified mapping as the inline engine, not std::uniform_int_distribution
+    /// @param low
+    /// @param high
     /// @return A random integer within the specified range.
     int get_int(int low, int high) noexcept
     {
 
-        return get_range(low, high);
+        return to_bounded_int([this]()
+                              { return get_bits(); }, low, high);
+    }
+
+    /// @brief Get the next 64 random bits
+    /// @return
+    std::uint64_t get_bits() noexcept
+    {
+
+        return static_cast<std::uint64_t>(rng_device()) << 32 | rng_device();
+    }
+
+    void seed() noexcept
+    {
+
+        std::random_device rd;
+        std::array<int, std::mt19937::state_size> seed_data;
+        std::generate(seed_data.begin(), seed_data.end(), std::ref(rd));
+        std::seed_seq seq(seed_data.begin(), seed_data.end());
+
+        rng_device.seed(seq);
+    }
+
+    void seed(unsigned long long seed) noexcept
+    {
+
+        // Both halves of the seed matter, seed_seq is fully specified by the standard
+        std::seed_seq seq{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+
+        rng_device.seed(seq);
+    }
+};
+
+namespace
+{
+    // Seed for the inline engine, two draws so all 64 bits vary
+    std::uint64_t seed_from_device()
+    {
+        std::random_device rd;
+
+        return static_cast<std::uint64_t>(rd()) << 32 | rd();
     }
 
     // Generate a vector of integers within the specified range
-    std::vector<int> get_vector_ints(int low, int high, int count) noexcept
+    template <typename Draw>
+    std::vector<int> shuffled_ints(int low, int high, int count, Draw &&draw) noexcept
     {
         // Handle invalid ranges
         if (low > high || count <= 0)
@@ -53,39 +90,44 @@ public:
         for (int i = 0; i < count; ++i)
         {
 
-            numbers.emplace_back(get_range(low, high));
+            numbers.emplace_back(draw(low, high));
         }
 
-        // Shuffle the vector using the random number generator
-        std::shuffle(numbers.begin(), numbers.end(), rng_device);
+        // Fisher-Yates with the same bounded draws, std::shuffle differs between standard libraries
+        for (auto i = count - 1; i > 0; --i)
+        {
+
+            std::swap(numbers[static_cast<size_t>(i)], numbers[static_cast<size_t>(draw(0, i))]);
+        }
 
         return numbers;
     }
+} // namespace
 
-    void seed() noexcept
-    {
-
-        std::random_device rd;
-        std::array<int, std::mt19937::state_size> seed_data;
-        std::generate(seed_data.begin(), seed_data.end(), std::ref(rd));
-        std::seed_seq seq(seed_data.begin(), seed_data.end());
+// Default constructor
+randomizer::randomizer() : randomizer::randomizer(rng_engine::XOSHIRO256SS) {}
 
-        rng_device.seed(seq);
-    }
+/// @brief
+/// @param engine
+randomizer::randomizer(rng_engine engine)
+    : m_engine_id{engine}, m_engine{}, m_impl{}
+{
 
-    void seed(unsigned long long seed) noexcept
+    if (engine == rng_engine::MT19937)
     {
 
-        rng_device.seed(static_cast<std::mt19937::result_type>(seed));
+        m_impl = std::make_unique<randomizer_impl>();
     }
-};
+    else
+    {
 
-// Default constructor
-randomizer::randomizer() : m_impl{std::make_unique<randomizer_impl>()} {}
+        m_engine.seed(seed_from_device());
+    }
+}
 
 // Copy constructor
 randomizer::randomizer(const randomizer &other)
-    : m_impl{std::make_unique<randomizer_impl>(*other.m_impl)}
+    : m_engine_id{other.m_engine_id}, m_engine{other.m_engine}, m_impl{other.m_impl ? std::make_unique<randomizer_impl>(*other.m_impl) : nullptr}
 {
 }
 
@@ -99,14 +141,16 @@ randomizer &randomizer::operator=(const randomizer &other)
         return *this;
     }
 
-    m_impl = std::make_unique<randomizer_impl>(*other.m_impl);
+    m_engine_id = other.m_engine_id;
+    m_engine = other.m_engine;
+    m_impl = other.m_impl ? std::make_unique<randomizer_impl>(*other.m_impl) : nullptr;
 
     return *this;
 }
 
 // Move constructor
 randomizer::randomizer(randomizer &&other) noexcept
-    : m_impl{std::move(other.m_impl)}
+    : m_engine_id{other.m_engine_id}, m_engine{other.m_engine}, m_impl{std::move(other.m_impl)}
 {
 }
 
@@ -120,6 +164,8 @@ randomizer &randomizer::operator=(randomizer &&other) noexcept
         return *this;
     }
 
+    m_engine_id = other.m_engine_id;
+    m_engine = other.m_engine;
     m_impl = std::move(other.m_impl);
 
     return *this;
@@ -129,12 +175,12 @@ randomizer &randomizer::operator=(randomizer &&other) noexcept
 randomizer::~randomizer() = default;
 
 /// @brief Seeds the random number generator.
+/// @details Every seed, including 0, always gives the same sequence on every platform
 /// @param seed 0
 void randomizer::seed(unsigned long long seed) noexcept
 {
 
-    // Check if the seed is within the valid range
-    if (seed < std::numeric_limits<unsigned long long>::min() || seed > std::numeric_limits<unsigned long long>::max())
+    if (m_impl)
     {
 
         this->m_impl->seed(seed);
@@ -142,7 +188,7 @@ void randomizer::seed(unsigned long long seed) noexcept
         return;
     }
 
-    this->m_impl->seed();
+    m_engine.seed(static_cast<std::uint64_t>(seed));
 }
 
 /// @brief Generates a random integer within a specified range.
@@ -152,7 +198,13 @@ void randomizer::seed(unsigned long long seed) noexcept
 int randomizer::get_int(int low, int high) noexcept
 {
 
-    return this->m_impl->get_int(low, high);
+    if (m_impl)
+    {
+
+        return this->m_impl->get_int(low, high);
+    }
+
+    return to_bounded_int(m_engine, low, high);
 }
 
 /// @brief Generates a vector of ints
@@ -163,5 +215,94 @@ int randomizer::get_int(int low, int high) noexcept
 std::vector<int> randomizer::get_vector_ints(int low, int high, int count) noexcept
 {
 
-    return this->m_impl->get_vector_ints(low, high, count);
+    auto draw = [this](int l, int h)
+    { return get_int(l, h); };
+
+    return shuffled_ints(low, high, count, draw);
+}
+
+/// @brief
+/// @param bits
+void randomizer::fill(std::span<std::uint64_t> bits) noexcept
+{
+
+    if (m_impl)
+    {
+
+        std::generate(bits.begin(), bits.end(), [this]()
+                      { return m_impl->get_bits(); });
+
+        return;
+    }
+
+    for (auto &b : bits)
+    {
+        b = m_engine();
+    }
+}
+
+/// @brief
+/// @param values
+/// @param low
+/// @param high
+void randomizer::fill(std::span<int> values, int low, int high) noexcept
+{
+
+    if (m_impl)
+    {
+
+        std::generate(values.begin(), values.end(), [this, low, high]()
+                      { return m_impl->get_int(low, high); });
+
+        return;
+    }
+
+    for (auto &v : values)
+    {
+        v = to_bounded_int(m_engine, low, high);
+    }
+}
+
+/// @brief
+void randomizer::jump() noexcept
+{
+
+    if (m_impl)
+    {
+
+        m_impl->seed(m_impl->get_bits());
+
+        return;
+    }
+
+    m_engine.jump();
+}
+
+/// @brief
+/// @return
+randomizer randomizer::split()
+{
+
+    randomizer child{*this};
+
+    if (m_impl)
+    {
+
+        child.m_impl->seed(m_impl->get_bits());
+    }
+    else
+    {
+
+        child.m_engine.seed(m_engine());
+    }
+
+    return child;
+}
+
+/// @brief
+/// @return
+rng_engine randomizer::engine() const noexcept
+{
+
+    return m_engine_id;
 }
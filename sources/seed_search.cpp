@@ -0,0 +1,158 @@
+#include <MazeBuilder/seed_search.h>
+
+#include <MazeBuilder/algo_interface.h>
+#include <MazeBuilder/flat_grid.h>
+#include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
+#include <MazeBuilder/randomizer.h>
+#include <MazeBuilder/solver.h>
+#include <MazeBuilder/worker_team.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <stdexcept>
+#include <thread>
+
+using namespace mazes;
+
+/// @brief Search mazes made from a configuration
+/// @param config
+/// @param threads
+seed_search::seed_search(const configurator &config, unsigned int threads) noexcept
+    : m_config{config}, m_threads{(threads == 0) ? std::max(1u, std::thread::hardware_concurrency()) : threads}
+{
+}
+
+/// @brief Every thread carves candidates into its own grid, checks the cheap dead end count first, then solves
+/// @param first_seed
+/// @param last_seed
+/// @param goals
+/// @param max_matches
+/// @return
+std::vector<seed_search::match> seed_search::run(unsigned int first_seed, unsigned int last_seed, const targets &goals, std::size_t max_matches) const
+{
+    if (first_seed >= last_seed || max_matches == 0)
+    {
+        return {};
+    }
+
+    // A missing algorithm is reported before any thread starts, an empty result only ever means no seed matched
+    if (!configurator::make_algo_from_config(m_config).has_value())
+    {
+        throw std::invalid_argument("Seed search needs a maze algorithm in the configuration.");
+    }
+
+    std::atomic<std::uint64_t> next_seed{first_seed};
+    std::atomic<std::size_t> found{0};
+
+    // Set when a thread fails, the others stop taking seeds and the error is rethrown once all of them are done
+    std::atomic<bool> failed{false};
+
+    std::vector<std::vector<match>> per_thread(m_threads);
+
+    worker_team team{m_threads};
+
+    team.for_each(m_threads, [&](std::size_t t)
+                  {
+        try
+        {
+            auto algo = configurator::make_algo_from_config(m_config);
+
+            flat_grid g{m_config.rows(), m_config.columns(), m_config.levels()};
+
+            auto &masks = g.operations().get_link_masks();
+
+            const auto cells = static_cast<std::size_t>(masks.size());
+            const auto goal = (goals.goal_index < 0) ? static_cast<std::int32_t>(cells) - 1 : goals.goal_index;
+
+            randomizer rng{};
+            solver s;
+
+            while (found.load(std::memory_order_relaxed) < max_matches && !failed.load(std::memory_order_relaxed))
+            {
+                const auto seed = next_seed.fetch_add(1, std::memory_order_relaxed);
+
+                if (seed >= last_seed)
+                {
+                    break;
+                }
+
+                masks.clear();
+                rng.seed(seed);
+
+                if (!algo.value()->run(&g, rng))
+                {
+                    continue;
+                }
+
+                const auto &bytes = masks.data();
+
+                const auto dead_ends = std::count_if(bytes.cbegin(), bytes.cend(), [](std::uint8_t mask)
+                                                     { return std::popcount(static_cast<unsigned int>(mask)) == 1; });
+
+                const auto ratio = static_cast<double>(dead_ends) / static_cast<double>(cells);
+
+                if (ratio < goals.min_dead_end_ratio || ratio > goals.max_dead_end_ratio)
+                {
+                    continue;
+                }
+
+                const auto path = s.solve(g.operations(), goals.start_index, goal);
+
+                const auto length = static_cast<std::int32_t>(path.size()) - 1;
+
+                if (path.empty() || length < goals.min_solution_length || length > goals.max_solution_length)
+                {
+                    continue;
+                }
+
+                const auto score = static_cast<double>(path.size()) / static_cast<double>(cells) + ratio;
+
+                per_thread[t].push_back(match{static_cast<unsigned int>(seed), length, ratio, score});
+
+                found.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        catch (...)
+        {
+            failed.store(true, std::memory_order_relaxed);
+
+            throw;
+        } });
+
+    std::vector<match> matches;
+
+    for (const auto &local : per_thread)
+    {
+        matches.insert(matches.end(), local.cbegin(), local.cend());
+    }
+
+    // Seeds are handed out in order, so every seed below the last one taken has been checked
+    std::sort(matches.begin(), matches.end(), [](const match &a, const match &b)
+              { return a.seed < b.seed; });
+
+    if (matches.size() > max_matches)
+    {
+        matches.resize(max_matches);
+    }
+
+    std::stable_sort(matches.begin(), matches.end(), [](const match &a, const match &b)
+                     { return a.score > b.score; });
+
+    return matches;
+}
+
+std::string seed_search::to_json(const std::vector<match> &matches, int pretty_print)
+{
+    nlohmann::json j = nlohmann::json::array();
+
+    for (const auto &m : matches)
+    {
+        j.push_back({{"seed", m.seed}, {"solution_length", m.solution_length}, {"dead_end_ratio", m.dead_end_ratio}, {"score", m.score}});
+    }
+
+    return j.dump(pretty_print);
+}
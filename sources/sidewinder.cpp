@@ -1,16 +1,26 @@
 #include <MazeBuilder/sidewinder.h>
 
-#include <MazeBuilder/cell.h>
 #include <MazeBuilder/grid_interface.h>
 #include <MazeBuilder/grid_operations.h>
 #include <MazeBuilder/lab.h>
 #include <MazeBuilder/randomizer.h>
+#include <MazeBuilder/row_streams.h>
+
+#include <cstdint>
+#include <exception>
+#include <limits>
 
-#include <functional>
 #include <vector>
 
 using namespace mazes;
 
+/// @brief
+/// @param threads
+sidewinder::sidewinder(unsigned int threads) noexcept
+    : m_threads{threads}
+{
+}
+
 /// @brief Generates a perfect maze if done correctly (no loops) by using "runs" to carve east-west
 /// @details "Runs" are row-like passages that are carved by the sidewinder algorithm
 /// @param g the grid to generate the maze on, and manipulate the cells
@@ -27,17 +37,80 @@ bool sidewinder::run(grid_interface *g, randomizer &rng) const noexcept
         return false;
     }
 
-    const auto &grid_ops = g->operations();
+    auto &grid_ops = g->operations();
 
     auto [rows, columns, _] = grid_ops.get_dimensions();
 
-    // Iterator-based approach: process cells row by row without materializing all cells
-    // This is much more memory efficient for large grids
+    if (m_threads.has_value())
+    {
+        auto &masks = grid_ops.get_link_masks();
+
+        // Two draws from the shared randomizer key every row stream, the high and low halves of the seed
+        const auto seed = static_cast<std::uint64_t>(rng(0, numeric_limits<int>::max())) << 32 | static_cast<std::uint32_t>(rng(0, numeric_limits<int>::max()));
+
+        auto carve = [&masks, seed, columns](unsigned int first, unsigned int last)
+        {
+            for (auto row{first}; row < last; ++row)
+            {
+                row_stream stream{seed, 0u, row};
+
+                // A run is always the cells from run_start to the current column
+                auto run_start{0u};
+
+                for (auto col{0u}; col < columns; ++col)
+                {
+                    const auto cell_index = static_cast<int>(static_cast<std::int64_t>(row) * columns + col);
+
+                    bool at_eastern_boundary = (col == columns - 1);
+                    bool at_northern_boundary = (row == 0);
+
+                    bool should_close_out = at_eastern_boundary ||
+                                            (!at_northern_boundary && stream(0, 1) == 0);
+
+                    if (should_close_out)
+                    {
+                        if (!at_northern_boundary)
+                        {
+                            const auto random_col = run_start + static_cast<unsigned int>(stream(0, static_cast<int>(col - run_start)));
+
+                            // The row above the first row of a band belongs to another thread, it is linked back after the join
+                            masks.link(static_cast<int>(static_cast<std::int64_t>(row) * columns + random_col), Direction::NORTH, row != first);
+                        }
+
+                        run_start = col + 1;
+                    }
+                    else if (!at_eastern_boundary)
+                    {
+                        masks.link(cell_index, Direction::EAST, true);
+                    }
+                }
+            }
+        };
+
+        try
+        {
+            const auto firsts = for_each_row_band(rows, m_threads.value(), carve);
+
+            stitch_row_bands(masks, firsts, columns);
+        }
+        catch (const std::exception &)
+        {
+
+            return false;
+        }
+
+        return true;
+    }
+
+    // Index-based approach: process cells row by row without touching cell objects
+    // The run buffer is sized once and reused for every row
+    vector<int> run;
+    run.reserve(columns);
 
     for (unsigned int row = 0; row < rows; ++row)
     {
 
-        vector<shared_ptr<cell>> run; // Current run of cells
+        run.clear();
 
         for (unsigned int col = 0; col < columns; ++col)
         {
@@ -45,13 +118,8 @@ bool sidewinder::run(grid_interface *g, randomizer &rng) const noexcept
             // Calculate cell index for current position
             int cell_index = static_cast<int>(row * columns + col);
 
-            // Get cell (will be created lazily if it doesn't exist)
-            auto cell = grid_ops.search(cell_index);
-            if (!cell)
-                continue;
-
             // Add current cell to the run
-            run.push_back(cell);
+            run.push_back(cell_index);
 
             bool at_eastern_boundary = (col == columns - 1);
             bool at_northern_boundary = (row == 0);
@@ -61,23 +129,15 @@ bool sidewinder::run(grid_interface *g, randomizer &rng) const noexcept
             bool should_close_out = at_eastern_boundary ||
                                     (!at_northern_boundary && rng(0, 1) == 0);
 
-            if (should_close_out && !run.empty())
+            if (should_close_out)
             {
                 // Select a random cell from the run to connect northward
                 // (unless we're at the northern boundary)
                 if (!at_northern_boundary)
                 {
                     size_t random_index = rng(0, static_cast<int>(run.size()) - 1);
-                    auto random_cell = run[random_index];
 
-                    if (random_cell)
-                    {
-                        auto north_cell = grid_ops.get_north(random_cell);
-                        if (north_cell)
-                        {
-                            lab::link(random_cell, north_cell, true);
-                        }
-                    }
+                    lab::link(grid_ops, run[random_index], Direction::NORTH, true);
                 }
 
                 // Clear the run to start a new one
@@ -86,14 +146,7 @@ bool sidewinder::run(grid_interface *g, randomizer &rng) const noexcept
             else if (!at_eastern_boundary)
             {
                 // If not closing and not at eastern boundary, link east
-
-                auto east_cell = grid_ops.get_east(cell);
-
-                if (east_cell)
-                {
-
-                    lab::link(cell, east_cell, true);
-                }
+                lab::link(grid_ops, cell_index, Direction::EAST, true);
             }
         }
     }
@@ -0,0 +1,155 @@
+#include <MazeBuilder/solver.h>
+
+#include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+
+using namespace mazes;
+
+solver::solver() noexcept
+    : m_stamp{0}, m_visited{0}, m_marks{}, m_parents{}, m_distances{}, m_forward{}, m_backward{}, m_next{}, m_path{}
+{
+}
+
+/// @brief Expand the smaller frontier one level at a time, keep the shortest meeting of a level
+/// @param ops
+/// @param start_index
+/// @param goal_index
+/// @return
+std::span<const std::int32_t> solver::solve(const grid_operations &ops, std::int32_t start_index, std::int32_t goal_index)
+{
+    const auto &masks = ops.get_link_masks();
+
+    const auto total = static_cast<size_t>(masks.size());
+
+    m_path.clear();
+    m_visited = 0;
+
+    if (start_index < 0 || goal_index < 0 || static_cast<size_t>(start_index) >= total || static_cast<size_t>(goal_index) >= total)
+    {
+        return {};
+    }
+
+    if (m_marks.size() != total)
+    {
+        // First query on a grid of this size
+        m_marks.assign(total, 0);
+        m_parents.assign(total, -1);
+        m_distances.assign(total, 0);
+
+        for (auto *buffer : {&m_forward, &m_backward, &m_next, &m_path})
+        {
+            buffer->reserve(total);
+        }
+
+        m_stamp = 0;
+    }
+
+    if (m_stamp >= std::numeric_limits<std::uint32_t>::max() - 2)
+    {
+        std::fill(m_marks.begin(), m_marks.end(), 0u);
+
+        m_stamp = 0;
+    }
+
+    m_stamp += 2;
+
+    const auto forward_mark = m_stamp, backward_mark = m_stamp + 1;
+
+    if (start_index == goal_index)
+    {
+        m_path.push_back(start_index);
+
+        return m_path;
+    }
+
+    auto [rows, columns, levels] = ops.get_dimensions();
+
+    // A link only exists toward a neighbor inside the grid, so the offsets need no bounds checks
+    const auto plane = static_cast<std::int32_t>(rows * columns);
+    const std::array<std::int32_t, static_cast<size_t>(Direction::COUNT)> offsets{-static_cast<std::int32_t>(columns), static_cast<std::int32_t>(columns), 1, -1, plane, -plane};
+
+    for (const auto &[cell, mark] : {std::pair{start_index, forward_mark}, std::pair{goal_index, backward_mark}})
+    {
+        m_marks[static_cast<size_t>(cell)] = mark;
+        m_parents[static_cast<size_t>(cell)] = -1;
+        m_distances[static_cast<size_t>(cell)] = 0;
+    }
+
+    m_forward.assign(1, start_index);
+    m_backward.assign(1, goal_index);
+    m_visited = 2;
+
+    auto shortest = std::numeric_limits<std::int32_t>::max();
+
+    // The passage where the searches meet, one cell from each search
+    std::int32_t meet_forward = -1, meet_backward = -1;
+
+    while (!m_forward.empty() && !m_backward.empty() && meet_forward < 0)
+    {
+        const auto from_start = m_forward.size() <= m_backward.size();
+
+        auto &frontier = from_start ? m_forward : m_backward;
+
+        const auto own_mark = from_start ? forward_mark : backward_mark;
+        const auto other_mark = from_start ? backward_mark : forward_mark;
+
+        m_next.clear();
+
+        for (const auto current : frontier)
+        {
+            const auto next_distance = m_distances[static_cast<size_t>(current)] + 1;
+
+            for (auto bits = static_cast<unsigned int>(masks.get(current)); bits != 0; bits &= bits - 1)
+            {
+                const auto neighbor = current + offsets[static_cast<size_t>(std::countr_zero(bits))];
+                const auto n = static_cast<size_t>(neighbor);
+
+                if (m_marks[n] == other_mark)
+                {
+                    // Every meeting on this level is checked, on mazes with loops they can differ in length
+                    if (next_distance + m_distances[n] < shortest)
+                    {
+                        shortest = next_distance + m_distances[n];
+                        meet_forward = from_start ? current : neighbor;
+                        meet_backward = from_start ? neighbor : current;
+                    }
+                }
+                else if (m_marks[n] != own_mark)
+                {
+                    m_marks[n] = own_mark;
+                    m_parents[n] = current;
+                    m_distances[n] = next_distance;
+                    m_next.push_back(neighbor);
+                }
+            }
+        }
+
+        m_visited += m_next.size();
+
+        frontier.swap(m_next);
+    }
+
+    if (meet_forward < 0)
+    {
+        return {};
+    }
+
+    for (auto step = meet_forward; step != -1; step = m_parents[static_cast<size_t>(step)])
+    {
+        m_path.push_back(step);
+    }
+
+    std::reverse(m_path.begin(), m_path.end());
+
+    for (auto step = meet_backward; step != -1; step = m_parents[static_cast<size_t>(step)])
+    {
+        m_path.push_back(step);
+    }
+
+    return m_path;
+}
@@ -3,12 +3,271 @@
 #include <MazeBuilder/configurator.h>
 #include <MazeBuilder/grid_interface.h>
 #include <MazeBuilder/grid_operations.h>
+#include <MazeBuilder/link_masks.h>
 #include <MazeBuilder/randomizer.h>
-#include <MazeBuilder/string_utils.h>
+#include <MazeBuilder/row_streams.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <ostream>
+#include <utility>
 
 using namespace mazes;
 
+namespace
+{
+    // Cell contents are right-aligned in this many characters, then a wall or gap follows
+    constexpr auto MAX_CONTENT_LENGTH = 5u;
+
+    constexpr auto CELL_WIDTH = MAX_CONTENT_LENGTH + 1;
+
+    // Indexed by the link bit rather than branched on, links in a maze are close to random
+    constexpr char EAST_WALLS[2]{'|', ' '};
+
+    constexpr char SOUTH_WALLS[2][CELL_WIDTH + 1]{"-----+", "     +"};
+
+    constexpr unsigned int EAST_SHIFT = static_cast<unsigned int>(Direction::EAST);
+
+    constexpr unsigned int SOUTH_SHIFT = static_cast<unsigned int>(Direction::SOUTH);
+
+    // Characters in one line: the leading wall or corner, every cell, then the newline
+    constexpr size_t line_length(unsigned int columns) noexcept
+    {
+        return static_cast<size_t>(columns) * CELL_WIDTH + 2;
+    }
+
+    // Hands out slices of a character buffer, growing it only if contents overflow their cells
+    class text_writer
+    {
+    public:
+        explicit text_writer(std::string &buffer, size_t pos = 0) noexcept
+            : m_buffer{buffer}, m_pos{pos}
+        {
+        }
+
+        char *claim(size_t count)
+        {
+            if (m_pos + count > m_buffer.size())
+            {
+                m_buffer.resize(std::max(m_buffer.size() * 2, m_pos + count));
+            }
+
+            auto *out = m_buffer.data() + m_pos;
+            m_pos += count;
+
+            return out;
+        }
+
+        size_t size() const noexcept { return m_pos; }
+
+        void rewind() noexcept { m_pos = 0; }
+
+    private:
+        std::string &m_buffer;
+
+        size_t m_pos;
+    };
+
+    // Hands out a fixed slice of a shared buffer, for one band of rows rendered on its own thread
+    // Contents wider than their cells would run into the next band, that is only flagged
+    class slice_writer
+    {
+    public:
+        slice_writer(char *begin, size_t capacity) noexcept
+            : m_begin{begin}, m_capacity{capacity}, m_pos{0}, m_overflowed{false}
+        {
+        }
+
+        char *claim(size_t count)
+        {
+            if (m_overflowed || m_pos + count > m_capacity)
+            {
+                // Keep writing somewhere harmless, the band gets rendered again serially
+                m_overflowed = true;
+                m_scratch.resize(std::max(m_scratch.size(), count));
+
+                return m_scratch.data();
+            }
+
+            auto *out = m_begin + m_pos;
+            m_pos += count;
+
+            return out;
+        }
+
+        bool overflowed() const noexcept { return m_overflowed; }
+
+    private:
+        char *m_begin;
+
+        size_t m_capacity;
+
+        size_t m_pos;
+
+        bool m_overflowed;
+
+        std::string m_scratch;
+    };
+
+    template <typename Writer>
+    void write_top_border(Writer &w, unsigned int columns)
+    {
+        auto *out = w.claim(line_length(columns));
+
+        *out++ = '+';
+        for (auto c = 0u; c < columns; ++c, out += CELL_WIDTH)
+        {
+            std::memcpy(out, SOUTH_WALLS[0], CELL_WIDTH);
+        }
+        *out = '\n';
+    }
+
+    // Writes a wall line where cells show their contents
+    template <typename Writer>
+    void write_wall_line(Writer &w, const grid_interface &g, const link_masks &masks, int first, unsigned int columns)
+    {
+        *w.claim(1) = '|';
+
+        for (auto c = 0u; c < columns; ++c)
+        {
+            const auto index = first + static_cast<int>(c);
+
+            const std::string content = g.contents_at(index);
+
+            const auto length = content.length();
+
+            // Longer contents keep all their characters and push the rest of the line over
+            const auto padding = (length < MAX_CONTENT_LENGTH) ? MAX_CONTENT_LENGTH - length : 0;
+
+            auto *out = w.claim(padding + length + 1);
+
+            std::memset(out, ' ', padding);
+            std::memcpy(out + padding, content.data(), length);
+
+            // East wall, open only where a passage leads to the east neighbor
+            // The rightmost column has no east neighbor and always gets a wall
+            out[padding + length] = EAST_WALLS[(masks.get(index) >> EAST_SHIFT) & 1u];
+        }
+
+        *w.claim(1) = '\n';
+    }
+
+    // Writes a wall line of blank cells, the line length is known so it is claimed at once
+    template <typename Writer, typename MaskOf>
+    void write_blank_wall_line(Writer &w, unsigned int columns, MaskOf mask_of)
+    {
+        auto *out = w.claim(line_length(columns));
+
+        *out++ = '|';
+        for (auto c = 0u; c < columns; ++c, out += CELL_WIDTH)
+        {
+            std::memcpy(out, "     ", MAX_CONTENT_LENGTH);
+            out[MAX_CONTENT_LENGTH] = EAST_WALLS[(mask_of(c) >> EAST_SHIFT) & 1u];
+        }
+        *out = '\n';
+    }
+
+    // Writes the floor line under a row
+    template <typename Writer, typename MaskOf>
+    void write_floor_line(Writer &w, unsigned int columns, MaskOf mask_of)
+    {
+        auto *out = w.claim(line_length(columns));
+
+        *out++ = '+';
+        for (auto c = 0u; c < columns; ++c, out += CELL_WIDTH)
+        {
+            // South wall, open only where a passage leads to the south neighbor
+            std::memcpy(out, SOUTH_WALLS[(mask_of(c) >> SOUTH_SHIFT) & 1u], CELL_WIDTH);
+        }
+        *out = '\n';
+    }
+
+    // Writes the wall line then the floor line of one row of level 0
+    template <typename Writer>
+    void write_row(Writer &w, const grid_interface &g, const link_masks &masks, unsigned int row, unsigned int columns)
+    {
+        const auto first = static_cast<int>(static_cast<std::int64_t>(row) * columns);
+
+        auto mask_of = [&masks, first](unsigned int c)
+        {
+            return masks.get(first + static_cast<int>(c));
+        };
+
+        if (!g.has_contents())
+        {
+            write_blank_wall_line(w, columns, mask_of);
+        }
+        else
+        {
+            write_wall_line(w, g, masks, first, columns);
+        }
+
+        write_floor_line(w, columns, mask_of);
+    }
+
+    bool fits_cell_indices(unsigned int rows, unsigned int columns, unsigned int levels) noexcept
+    {
+        // Cell indices are 32-bit, so that is the only limit on what can be rendered
+        return static_cast<size_t>(rows) * columns * levels <= configurator::MAX_LARGE_CELLS;
+    }
+
+    // Renders every row in order, the buffer grows if contents overflow their cells
+    void render_serial(std::string &result, const grid_interface &g, const link_masks &masks, unsigned int rows, unsigned int columns)
+    {
+        text_writer w{result};
+
+        write_top_border(w, columns);
+
+        for (auto r = 0u; r < rows; ++r)
+        {
+            write_row(w, g, masks, r, columns);
+        }
+
+        result.resize(w.size());
+    }
+
+    // Renders bands of rows on separate threads into their own slices of the buffer
+    // Each row takes exactly two lines unless contents overflow, then false is returned
+    bool render_bands(std::string &result, const grid_interface &g, const link_masks &masks, unsigned int rows, unsigned int columns, unsigned int threads)
+    {
+        const auto line = line_length(columns);
+
+        text_writer border{result};
+
+        write_top_border(border, columns);
+
+        std::atomic<bool> overflowed{false};
+
+        for_each_row_band(rows, threads, [&](unsigned int first, unsigned int last)
+                          {
+            slice_writer w{result.data() + line * (1 + 2 * static_cast<size_t>(first)), 2 * line * (last - first)};
+
+            try
+            {
+                for (auto r = first; r < last && !w.overflowed(); ++r)
+                {
+                    write_row(w, g, masks, r, columns);
+                }
+            }
+            catch (const std::exception &)
+            {
+                overflowed.store(true, std::memory_order_relaxed);
+            }
+
+            if (w.overflowed())
+            {
+                overflowed.store(true, std::memory_order_relaxed);
+            } });
+
+        return !overflowed.load(std::memory_order_relaxed);
+    }
+} // namespace
+
 /// @brief Provide a string representation of the grid
+/// @details The output size is known from the dimensions, so it is written in one pass into a single buffer
+/// @details With threads, bands of rows are written into their slices of that buffer at the same time
 /// @param g
 /// @param rng
 /// @return
@@ -21,121 +280,124 @@ bool stringify::run(grid_interface *g, [[maybe_unused]] randomizer &rng) const n
         return false;
     }
 
-    std::string result{};
-    result.reserve(1024);
-
     auto &&ops = g->operations();
 
     auto [rows, columns, levels] = ops.get_dimensions();
 
-    static constexpr auto MAX_REASONABLE_CELLS = configurator::MAX_COLUMNS * configurator::MAX_ROWS * configurator::MAX_LEVELS + 1u;
+    if (!fits_cell_indices(rows, columns, levels))
+    {
+        ops.set_str("Grid too large to stringify reasonably.");
 
-    const size_t total_cells = static_cast<size_t>(rows) * static_cast<size_t>(columns) * static_cast<size_t>(levels);
+        return false;
+    }
 
-    if (total_cells > MAX_REASONABLE_CELLS)
+    try
+    {
+        // One top border, then a wall line and a floor line per row
+        std::string result(line_length(columns) * (2 * static_cast<size_t>(rows) + 1), '\0');
+
+        const auto &masks = ops.get_link_masks();
+
+        // Contents wider than a cell shift the rows after them, then only the serial layout works
+        if (!m_threads.has_value() || rows < 2 || !render_bands(result, *g, masks, rows, columns, m_threads.value()))
+        {
+            render_serial(result, *g, masks, rows, columns);
+        }
+
+        ops.set_str(std::move(result));
+    }
+    catch (const std::exception &)
+    {
+
+        return false;
+    }
+
+    return true;
+} // run
+
+/// @brief Stream the text of the grid, holding one row of text at a time
+/// @param g
+/// @param os
+/// @return False when the grid is missing or too large, or the stream fails
+bool stringify::run(grid_interface *g, std::ostream &os) const
+{
+
+    if (!g)
     {
-        ops.set_str("Grid too large to stringify reasonably.");
 
         return false;
     }
 
-    // Generate ASCII representation
-    // Top border
-    result = string_utils::concat(result, "+");
-    for (auto c = 0u; c < columns; ++c)
+    auto &&ops = g->operations();
+
+    auto [rows, columns, levels] = ops.get_dimensions();
+
+    if (!fits_cell_indices(rows, columns, levels))
     {
-        result = string_utils::concat(result, "-----+");
+
+        return false;
     }
-    result = string_utils::concat(result, "\n");
 
-    // For each row
-    for (auto r = 0u; r < rows; ++r)
+    // Rows are gathered up to about this many bytes before each write
+    static constexpr size_t CHUNK_BYTES = 1u << 16;
+
+    std::string chunk(std::max(CHUNK_BYTES, 2 * line_length(columns)), '\0');
+
+    text_writer w{chunk};
+
+    auto flush = [&os, &chunk, &w]()
     {
-        std::string top_line = "|";
-        std::string bottom_line = "+";
+        os.write(chunk.data(), static_cast<std::streamsize>(w.size()));
+        w.rewind();
+    };
 
-        for (auto c = 0u; c < columns; ++c)
+    write_top_border(w, columns);
+
+    const auto &masks = ops.get_link_masks();
+
+    for (auto r = 0u; r < rows && os; ++r)
+    {
+        write_row(w, *g, masks, r, columns);
+
+        if (w.size() >= CHUNK_BYTES)
         {
-            // Get cell on-demand (will be created lazily if needed)
-            if (auto cell_ptr = ops.search(r * columns + c); cell_ptr != nullptr)
-            {
-                std::string content = g->contents_of(cell_ptr);
+            flush();
+        }
+    }
 
-                static constexpr auto pad_content = [](std::string &str)
-                {
-                    static constexpr auto MAX_CONTENT_LENGTH = 5u;
+    flush();
 
-                    while (str.length() < MAX_CONTENT_LENGTH)
-                    {
-                        str = " " + str;
-                    }
-                };
-                
-                pad_content(content);
+    return static_cast<bool>(os);
+}
 
-                top_line = string_utils::concat(top_line, content);
+/// @brief Append the top border, drawn by the same writer as run
+/// @param columns
+/// @param out
+void stringify::render_top_border(unsigned int columns, std::string &out)
+{
+    text_writer w{out, out.size()};
 
-                // East wall - FIXED: Always add a wall, check if it should be open
-                if (auto east_neighbor = ops.get_east(cell_ptr); east_neighbor != nullptr)
-                {
-                    bool linked_east = false;
-
-                    for (const auto &[linked_cell, is_linked] : cell_ptr->get_links())
-                    {
-                        if (is_linked && linked_cell->get_index() == east_neighbor->get_index())
-                        {
-                            linked_east = true;
-                            break;
-                        }
-                    }
-
-                    top_line += linked_east ? " " : "|";
-                }
-                else
-                {
-                    // No east neighbor (rightmost column) - always add wall
-                    top_line += "|";
-                }
+    write_top_border(w, columns);
 
-                // South wall - FIXED: Always add bottom border for every cell
-                if (auto south_neighbor = ops.get_south(cell_ptr); south_neighbor != nullptr)
-                {
-                    bool linked_south = false;
-
-                    for (const auto &[linked_cell, is_linked] : cell_ptr->get_links())
-                    {
-                        if (is_linked && linked_cell->get_index() == south_neighbor->get_index())
-                        {
-                            linked_south = true;
-                            break;
-                        }
-                    }
-
-                    bottom_line += linked_south ? "     " : "-----";
-                }
-                else
-                {
-                    // No south neighbor (bottom row) - always add bottom wall
-                    bottom_line += "-----";
-                }
+    out.resize(w.size());
+}
 
-                bottom_line += "+";
-            }
-            else
-            {
-                // Handle case where cell doesn't exist
-                top_line += "     |";
-                bottom_line += "-----+";
-            }
-        }
+/// @brief Append the lines of one row, drawn by the same writer as run
+/// @param links
+/// @param out
+void stringify::render_row(std::span<const std::uint8_t> links, std::string &out)
+{
+    text_writer w{out, out.size()};
 
-        result = string_utils::concat(result, top_line);
-        result = string_utils::concat(result, "\n");
-        result = string_utils::concat(result, bottom_line);
-        result = string_utils::concat(result, "\n");
-    }
+    const auto columns = static_cast<unsigned int>(links.size());
 
-    ops.set_str(result);
+    auto mask_of = [links](unsigned int c)
+    {
+        return links[c];
+    };
 
-    return true;
-} // run
+    write_blank_wall_line(w, columns, mask_of);
+    write_floor_line(w, columns, mask_of);
+
+    out.resize(w.size());
+}
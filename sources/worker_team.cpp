@@ -0,0 +1,147 @@
+#include <MazeBuilder/worker_team.h>
+
+#include <algorithm>
+#include <system_error>
+#include <utility>
+
+using namespace mazes;
+
+/// @brief Start the threads of the team
+/// @param threads
+worker_team::worker_team(unsigned int threads)
+    : m_workers{}, m_task{nullptr}, m_count{0}, m_next{0}, m_generation{0}, m_busy{0}, m_exit{false}, m_error{}
+{
+    const auto count = (threads == 0) ? std::max(1u, std::thread::hardware_concurrency()) : threads;
+
+    m_workers.reserve(count - 1);
+
+    for (auto t{1u}; t < count; ++t)
+    {
+        try
+        {
+            m_workers.emplace_back([this]()
+                                   { work(); });
+        }
+        catch (const std::system_error &)
+        {
+            break;
+        }
+    }
+}
+
+/// @brief Stop and join the threads
+worker_team::~worker_team()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+
+        m_exit = true;
+    }
+
+    m_start.notify_all();
+
+    for (auto &t : m_workers)
+    {
+        t.join();
+    }
+}
+
+/// @brief Run task(i) for every i below count, and wait for all of them
+/// @param count
+/// @param task
+void worker_team::for_each(std::size_t count, const std::function<void(std::size_t)> &task)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock(m_run_mtx);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+
+        m_task = &task;
+        m_count = count;
+        m_next.store(0, std::memory_order_relaxed);
+        m_error = nullptr;
+
+        // A single item is not worth waking the team for
+        m_busy = (count > 1) ? m_workers.size() : 0;
+
+        if (m_busy > 0)
+        {
+            ++m_generation;
+        }
+    }
+
+    m_start.notify_all();
+
+    take_items();
+
+    std::unique_lock<std::mutex> lock(m_mtx);
+
+    // Every thread leaves the round before the next one starts, so none of them can miss a round
+    m_done.wait(lock, [this]
+                { return m_busy == 0; });
+
+    m_task = nullptr;
+
+    if (m_error)
+    {
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+    }
+}
+
+/// @brief Wait for a round, take items until there are none left, then report back
+void worker_team::work() noexcept
+{
+    std::size_t seen = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mtx);
+
+            m_start.wait(lock, [this, seen]
+                         { return m_exit || m_generation != seen; });
+
+            if (m_exit)
+            {
+                return;
+            }
+
+            seen = m_generation;
+        }
+
+        take_items();
+
+        std::lock_guard<std::mutex> lock(m_mtx);
+
+        if (--m_busy == 0)
+        {
+            m_done.notify_all();
+        }
+    }
+}
+
+/// @brief Run items of the current round until the counter passes the last one
+void worker_team::take_items() noexcept
+{
+    for (auto i = m_next.fetch_add(1, std::memory_order_relaxed); i < m_count; i = m_next.fetch_add(1, std::memory_order_relaxed))
+    {
+        try
+        {
+            (*m_task)(i);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_mtx);
+
+            if (!m_error)
+            {
+                m_error = std::current_exception();
+            }
+        }
+    }
+}
@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <MazeBuilder/configurator.h>
+#include <MazeBuilder/create.h>
+#include <MazeBuilder/enums.h>
+
+#include <nlohmann/json.hpp>
+
+#include "cli.h"
+
+using namespace std;
+
+TEST_CASE("CLI output only depends on the seed and settings", "[cli]")
+{
+    cli my_cli;
+
+    for (const auto algo : {"binary_tree", "dfs", "ellers", "sidewinder"})
+    {
+        const vector<string> args{"-r", "12", "-c", "17", "-a", algo, "-s", "42"};
+
+        const auto first = my_cli.convert(args);
+        const auto second = my_cli.convert(args);
+
+        REQUIRE_FALSE(first.empty());
+        REQUIRE(first == second);
+
+        const vector<string> other_seed{"-r", "12", "-c", "17", "-a", algo, "-s", "43"};
+
+        REQUIRE(my_cli.convert(other_seed) != first);
+    }
+}
+
+TEST_CASE("CLI writes files as they are encoded", "[cli]")
+{
+    cli my_cli;
+
+    for (const auto filename : {"cli_stream.txt", "cli_stream.png", "cli_stream.jpg", "cli_stream.obj", "cli_stream.glb", "cli_stream.ply"})
+    {
+        const vector<string> args{"-r", "9", "-c", "11", "-a", "sidewinder", "-s", "5", "-o", filename};
+
+        const auto expected = my_cli.convert(args);
+
+        REQUIRE_FALSE(expected.empty());
+
+        // Nothing reaches the terminal stream when the arguments name a file
+        ostringstream terminal;
+
+        REQUIRE(my_cli.convert_to(args, terminal));
+        REQUIRE(terminal.str().empty());
+
+        ifstream written(filename, ios::binary);
+        REQUIRE(written.is_open());
+
+        const string contents{istreambuf_iterator<char>(written), istreambuf_iterator<char>()};
+        written.close();
+        std::remove(filename);
+
+        REQUIRE(contents == expected);
+    }
+
+    SECTION("Without a file name the output goes to the stream")
+    {
+        const vector<string> args{"-r", "4", "-c", "5", "-s", "5"};
+
+        ostringstream terminal;
+
+        REQUIRE(my_cli.convert_to(args, terminal));
+        REQUIRE(terminal.str() == my_cli.convert(args) + "\n");
+    }
+}
+
+TEST_CASE("CLI threads and size options reach the configuration", "[cli]")
+{
+    cli my_cli;
+
+    SECTION("Parallel rows do not change the output")
+    {
+        for (const auto format : {"txt", "obj", "png"})
+        {
+            const vector<string> serial{"-r", "40", "-c", "30", "-a", "dfs", "-s", "7", "-o", format};
+
+            auto parallel = serial;
+            parallel.push_back("--parallel=3");
+
+            const auto expected = my_cli.convert(serial);
+
+            REQUIRE_FALSE(expected.empty());
+            REQUIRE(my_cli.get_config()->parallel_rows() == nullopt);
+
+            REQUIRE(my_cli.convert(parallel) == expected);
+            REQUIRE(my_cli.get_config()->parallel_rows() == 3u);
+        }
+    }
+
+    SECTION("Large mazes are not clamped")
+    {
+        const auto rows = to_string(mazes::configurator::MAX_ROWS + 1);
+
+        REQUIRE_FALSE(my_cli.convert({"-r", rows, "-c", "2", "-a", "dfs", "--large"}).empty());
+        REQUIRE(my_cli.get_config()->large_maze());
+        REQUIRE(my_cli.get_config()->rows() == mazes::configurator::MAX_ROWS + 1);
+    }
+
+    REQUIRE(my_cli.convert({"-r", "4", "-c", "4", "--parallel"}).empty());
+}
+
+TEST_CASE("CLI builds the mazes that create and seed search build", "[cli][seed_search]")
+{
+    cli my_cli;
+
+    for (const auto algo : {mazes::algo::BINARY_TREE, mazes::algo::DFS, mazes::algo::ELLERS, mazes::algo::SIDEWINDER})
+    {
+        const string name{mazes::to_sv_from_algo(algo)};
+
+        const auto config = mazes::configurator().rows(9).columns(14).algo_id(algo).seed(42);
+
+        REQUIRE(my_cli.convert({"-r", "9", "-c", "14", "-a", name, "-s", "42"}) == mazes::create(config));
+    }
+
+    // A seed the search reports is replayed by passing it back
+    const auto found = nlohmann::json::parse(my_cli.convert({"-r", "8", "-c", "8", "-a", "dfs", "--search=0:50", "--min-length=20", "--matches=3"}));
+
+    REQUIRE_FALSE(found.empty());
+
+    for (const auto &m : found)
+    {
+        const auto seed = m["seed"].get<unsigned int>();
+
+        const auto replayed = my_cli.convert({"-r", "8", "-c", "8", "-a", "dfs", "-s", to_string(seed)});
+
+        REQUIRE(replayed == mazes::create(mazes::configurator().rows(8).columns(8).algo_id(mazes::algo::DFS).seed(seed)));
+    }
+}
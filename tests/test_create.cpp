@@ -2,13 +2,33 @@
 
 #include <catch2/benchmark/catch_benchmark.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+#if defined(MAZE_BENCHMARK) && defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+#include <MazeBuilder/binary_tree.h>
 #include <MazeBuilder/configurator.h>
 #include <MazeBuilder/create.h>
 #include <MazeBuilder/create2.h>
+#include <MazeBuilder/dfs.h>
+#include <MazeBuilder/distance_grid.h>
+#include <MazeBuilder/distances.h>
+#include <MazeBuilder/flat_grid.h>
+#include <MazeBuilder/progress.h>
+#include <MazeBuilder/randomizer.h>
+#include <MazeBuilder/seed_search.h>
+#include <MazeBuilder/stringify.h>
+#include <MazeBuilder/worker_team.h>
 
 TEST_CASE("Create with single configurator", "[create_single]")
 {
@@ -81,9 +101,6 @@ TEST_CASE("Create with two configurators", "[create_two]")
     REQUIRE_FALSE(results[1].empty());
 }
 
-// Randomizer performs different on different OS's
-#if defined(__UNIX__)
-
 TEST_CASE("Create reproducible with same seed", "[create_reproducible]")
 {
     // Create the same configuration twice with same seed
@@ -101,9 +118,11 @@ TEST_CASE("Create reproducible with same seed", "[create_reproducible]")
     REQUIRE(results2.size() == 2);
     REQUIRE(results1[0] == results2[0]);
     REQUIRE(results1[1] == results2[1]);
-}
 
-#endif // UNIX
+    // The single-config path reuses a thread_local randomizer, reseeding must reset it
+    REQUIRE(mazes::create(mazes::configurator().rows(5).columns(5).algo_id(mazes::algo::DFS).seed(42)) == results1[0]);
+    REQUIRE(mazes::create(mazes::configurator().rows(5).columns(5).algo_id(mazes::algo::DFS).seed(42)) == results1[0]);
+}
 
 TEST_CASE("Create with reference wrapper support", "[create_reference_wrapper]")
 {
@@ -124,6 +143,220 @@ TEST_CASE("Create with reference wrapper support", "[create_reference_wrapper]")
     REQUIRE_FALSE(results[1].empty());
 }
 
+TEST_CASE("Create2 returns mazes in the order of the configurators", "[create2]")
+{
+    // One large maze ahead of many small ones, so the small ones are stolen around it
+    std::vector<mazes::configurator> configs;
+    configs.emplace_back(mazes::configurator().rows(120).columns(120).algo_id(mazes::algo::DFS).seed(7));
+
+    for (auto i{0u}; i < 23u; ++i)
+    {
+        configs.emplace_back(mazes::configurator().rows(3 + i % 5).columns(4 + i % 7).algo_id((i % 2) ? mazes::algo::BINARY_TREE : mazes::algo::DFS).seed(100 + i));
+    }
+
+    for (const auto threads : {1u, 3u, 0u})
+    {
+        auto results = mazes::create2(configs, threads);
+
+        REQUIRE(results.size() == configs.size());
+
+        for (size_t i = 0; i < configs.size(); ++i)
+        {
+            REQUIRE(results[i] == mazes::create(configs[i]));
+        }
+    }
+
+    REQUIRE(mazes::create2({}).empty());
+}
+
+TEST_CASE("Work-stealing executor runs every task of back-to-back batches once", "[create2]")
+{
+    mazes::detail::work_stealing_executor executor{4};
+
+    REQUIRE(executor.size() == 4);
+
+    // Workers still finishing one batch must not take tasks of the next
+    for (auto batch{0u}; batch < 500u; ++batch)
+    {
+        const auto count = 1 + batch % 37;
+
+        std::vector<std::atomic<unsigned int>> runs(count);
+
+        executor.run(count, [&runs](std::size_t i)
+                     { runs[i].fetch_add(1); });
+
+        REQUIRE(std::all_of(runs.cbegin(), runs.cend(), [](const auto &r)
+                            { return r.load() == 1u; }));
+    }
+
+    REQUIRE_THROWS_AS(executor.run(9, [](std::size_t i)
+                                   { if (i == 5) throw std::runtime_error("task failed"); }),
+                      std::runtime_error);
+
+    // A failed batch leaves the executor usable
+    std::atomic<std::size_t> sum{0};
+
+    executor.run(10, [&sum](std::size_t i)
+                 { sum += i; });
+
+    REQUIRE(sum == 45);
+}
+
+TEST_CASE("Worker team runs every item of back-to-back rounds once", "[worker_team]")
+{
+    mazes::worker_team team{4};
+
+    REQUIRE(team.size() == 4);
+
+    for (auto round{0u}; round < 500u; ++round)
+    {
+        const auto count = round % 23;
+
+        std::vector<std::atomic<unsigned int>> runs(count);
+
+        team.for_each(count, [&runs](std::size_t i)
+                      { runs[i].fetch_add(1); });
+
+        REQUIRE(std::all_of(runs.cbegin(), runs.cend(), [](const auto &r)
+                            { return r.load() == 1u; }));
+    }
+
+    // Every item still runs when one of them throws
+    std::atomic<std::size_t> ran{0};
+
+    REQUIRE_THROWS_AS(team.for_each(9, [&ran](std::size_t i)
+                                    { ++ran; if (i == 5) throw std::runtime_error("item failed"); }),
+                      std::runtime_error);
+
+    REQUIRE(ran == 9);
+
+    std::atomic<std::size_t> sum{0};
+
+    team.for_each(10, [&sum](std::size_t i)
+                  { sum += i; });
+
+    REQUIRE(sum == 45);
+}
+
+TEST_CASE("Create large mazes past the default limits", "[create_large]")
+{
+    static constexpr auto ROWS = mazes::configurator::MAX_ROWS + 50u;
+
+    SECTION("Dimensions are clamped unless large-maze mode is on")
+    {
+        mazes::configurator config;
+        config.rows(ROWS).columns(ROWS).levels(mazes::configurator::MAX_LEVELS + 1);
+
+        REQUIRE(config.rows() == mazes::configurator::MAX_ROWS);
+        REQUIRE(config.columns() == mazes::configurator::MAX_COLUMNS);
+        REQUIRE(config.levels() == mazes::configurator::MAX_LEVELS);
+        REQUIRE(config.is_valid());
+
+        config.large_maze(true);
+
+        REQUIRE(config.rows() == ROWS);
+        REQUIRE(config.columns() == ROWS);
+        REQUIRE(config.levels() == mazes::configurator::MAX_LEVELS + 1);
+        REQUIRE(config.is_valid());
+
+        // Cell indices are 32-bit
+        config.rows(1u << 16).columns(1u << 16);
+        REQUIRE_FALSE(config.is_valid());
+    }
+
+    SECTION("Large mazes render every row")
+    {
+        static constexpr auto COLUMNS = 130u;
+
+        auto result = mazes::create(mazes::configurator().large_maze(true).rows(ROWS).columns(COLUMNS).algo_id(mazes::algo::DFS));
+
+        REQUIRE(static_cast<unsigned int>(std::count(result.cbegin(), result.cend(), '\n')) == 2 * ROWS + 1);
+        REQUIRE(result.find('\n') == 6 * COLUMNS + 1);
+    }
+}
+
+TEST_CASE("Seed search finds the mazes create makes", "[seed_search]")
+{
+    static constexpr auto T_ROWS = 12u, T_COLUMNS = 14u;
+    static constexpr auto CELLS = static_cast<int>(T_ROWS * T_COLUMNS);
+    static constexpr auto SEEDS = 120u;
+    static constexpr std::size_t MATCHES = 5;
+
+    const auto config = mazes::configurator().rows(T_ROWS).columns(T_COLUMNS).algo_id(mazes::algo::DFS);
+
+    mazes::seed_search::targets goals;
+    goals.min_solution_length = 60;
+    goals.max_dead_end_ratio = 0.2;
+
+    // Generate every seed in turn, the way create does
+    auto generate = [](unsigned int seed, mazes::flat_grid &g, mazes::randomizer &rng)
+    {
+        g.operations().get_link_masks().clear();
+        rng.seed(seed);
+        return mazes::dfs{}.run(&g, rng);
+    };
+
+    std::vector<unsigned int> expected;
+    {
+        mazes::flat_grid g{T_ROWS, T_COLUMNS, 1};
+        mazes::randomizer rng;
+
+        for (auto seed = 0u; seed < SEEDS && expected.size() < MATCHES; ++seed)
+        {
+            REQUIRE(generate(seed, g, rng));
+
+            const auto &bytes = g.operations().get_link_masks().data();
+            const auto dead_ends = std::count_if(bytes.cbegin(), bytes.cend(), [](auto mask)
+                                                 { return std::popcount(static_cast<unsigned int>(mask)) == 1; });
+            const auto length = mazes::distances::field(g.operations(), 0)[CELLS - 1];
+
+            if (length >= goals.min_solution_length && static_cast<double>(dead_ends) / CELLS <= goals.max_dead_end_ratio)
+            {
+                expected.push_back(seed);
+            }
+        }
+    }
+    REQUIRE(expected.size() == MATCHES);
+
+    for (auto threads : {1u, 4u})
+    {
+        const auto matches = mazes::seed_search{config, threads}.run(0, SEEDS, goals, MATCHES);
+        REQUIRE(matches.size() == MATCHES);
+
+        std::vector<unsigned int> seeds;
+        for (const auto &m : matches)
+        {
+            seeds.push_back(m.seed);
+            REQUIRE(m.solution_length >= goals.min_solution_length);
+            REQUIRE(m.dead_end_ratio <= goals.max_dead_end_ratio);
+        }
+        std::sort(seeds.begin(), seeds.end());
+        REQUIRE(seeds == expected);
+
+        REQUIRE(std::is_sorted(matches.cbegin(), matches.cend(), [](const auto &a, const auto &b)
+                               { return a.score > b.score; }));
+    }
+
+    const auto best = mazes::seed_search{config, 2}.run(0, SEEDS, goals, MATCHES).front();
+
+    // The best seed gives the same maze through create
+    mazes::flat_grid g{T_ROWS, T_COLUMNS, 1};
+    mazes::randomizer rng;
+    REQUIRE(generate(best.seed, g, rng));
+    REQUIRE(mazes::stringify{}.run(&g, rng));
+
+    auto seeded = config;
+    REQUIRE(mazes::create(seeded.seed(best.seed)) == g.operations().get_str());
+
+    REQUIRE(mazes::seed_search::to_json({best}).find("\"seed\": " + std::to_string(best.seed)) != std::string::npos);
+    REQUIRE(mazes::seed_search{config, 2}.run(5, 5, goals, MATCHES).empty());
+
+    // No algorithm is an error, not a search without matches
+    auto no_algo = config;
+    const mazes::seed_search unsearchable{no_algo.algo_id(mazes::algo::TOTAL), 2};
+    REQUIRE_THROWS_AS(unsearchable.run(0, SEEDS, goals, MATCHES), std::invalid_argument);
+}
+
 #if defined(MAZE_BENCHMARK)
 
 TEST_CASE("Create mazes and benchmark", "[create workflow]")
@@ -158,4 +391,71 @@ TEST_CASE("Create mazes and benchmark", "[create workflow]")
     };
 }
 
+/// @brief Report cells per second and peak bytes per cell for large mazes
+/// @details Hidden by default, run with: mazebuildertests "[large_maze]"
+/// @details Sizes run smallest first, so the process peak is set by the current size
+TEST_CASE("Benchmark large-maze mode at 1M, 16M, and 100M cells", "[.][large_maze][benchmark]")
+{
+    using namespace mazes;
+
+    static constexpr unsigned int SIDES[] = {1'000u, 4'000u, 10'000u};
+
+    auto peak_bytes = []() -> double
+    {
+#if defined(__linux__)
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<double>(usage.ru_maxrss) * 1024.0;
+#else
+        return 0.0;
+#endif
+    };
+
+    for (auto side : SIDES)
+    {
+        const double cells = static_cast<double>(side) * side;
+        // Millions of cells per second
+        auto per_second = [cells](auto micros)
+        { return cells / static_cast<double>(micros.count()); };
+
+        randomizer rng;
+        rng.seed(42);
+
+        {
+            flat_grid g{side, side, 1};
+            auto generate = progress<>::duration([&g, &rng]()
+                                                 { return binary_tree{}.run(&g, rng); });
+            auto render = progress<>::duration([&g, &rng]()
+                                               { return stringify{}.run(&g, rng); });
+
+            std::cout << std::fixed << std::setprecision(1) << side << "x" << side << " binary_tree: " << per_second(generate) << "M cells/s, stringify: "
+                      << per_second(render) << "M cells/s, " << g.operations().get_str().size() / cells << " output bytes/cell, peak " << peak_bytes() / cells << " bytes/cell\n";
+        }
+
+        {
+            distance_grid g{side, side, 1};
+            auto generate = progress<>::duration([&g, &rng]()
+                                                 { return dfs{}.run(&g, rng); });
+            auto measure = progress<>::duration([&g]()
+                                                { g.calculate_distances(0, -1); return g.get_distances() != nullptr; });
+
+            std::cout << std::fixed << std::setprecision(1) << side << "x" << side << " dfs: " << per_second(generate) << "M cells/s, distances: "
+                      << per_second(measure) << "M cells/s, peak " << peak_bytes() / cells << " bytes/cell\n";
+        }
+    }
+}
+
+TEST_CASE("Benchmark seed search", "[seed_search][benchmark]")
+{
+    const auto config = mazes::configurator().rows(50).columns(50).algo_id(mazes::algo::DFS);
+
+    mazes::seed_search::targets goals;
+    goals.min_solution_length = 2'000;
+
+    BENCHMARK("Search 1000 seeds of 50x50 dfs mazes")
+    {
+        return mazes::seed_search{config}.run(0, 1'000, goals, 1'000).size();
+    };
+}
+
 #endif // MAZE_BENCHMARK
@@ -1,11 +1,20 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 #include <MazeBuilder/maze_builder.h>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <queue>
+#include <string>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 using namespace mazes;
 using namespace std;
@@ -32,6 +41,21 @@ TEST_CASE("Distances initialization and basic operations", "[distances]")
         REQUIRE(dist.contains(2));
         REQUIRE_FALSE(dist.contains(3));
     }
+
+    SECTION("Negative indices stay outside of the field")
+    {
+        const auto cells = dist.values().size();
+
+        REQUIRE(dist[-1] == -1);
+
+        dist[-7] = 3;
+        dist.set(-7, 3);
+
+        REQUIRE(dist[-7] == -1);
+        REQUIRE_FALSE(dist.contains(-7));
+        REQUIRE(dist.values().size() == cells);
+        REQUIRE(std::as_const(dist)[-7] == -1);
+    }
 }
 
 TEST_CASE("Finds the shortest path", "[shortest paths]")
@@ -67,3 +91,661 @@ TEST_CASE("Distances collect keys", "[distances]")
     REQUIRE(std::find(keys.begin(), keys.end(), 1) != keys.end());
     REQUIRE(std::find(keys.begin(), keys.end(), 2) != keys.end());
 }
+
+TEST_CASE("One breadth-first search colors every cell by distance", "[distances][heatmap]")
+{
+    static constexpr auto T_ROWS = 12u, T_COLUMNS = 9u, T_LEVELS = 2u;
+
+    randomizer rng;
+
+    SECTION(" The field matches distance_grid ")
+    {
+        distance_grid reference{T_ROWS, T_COLUMNS, 1};
+        REQUIRE(dfs{}.run(&reference, rng));
+        reference.calculate_distances(0, -1);
+
+        const auto field = distances::field(reference.operations(), 0);
+        REQUIRE(field.size() == T_ROWS * T_COLUMNS);
+
+        const auto &dists = *reference.get_distances();
+        for (auto i = 0; i < static_cast<int>(field.size()); ++i)
+        {
+            REQUIRE(field[static_cast<size_t>(i)] == dists[i]);
+        }
+    }
+
+    SECTION(" Passages between levels are followed ")
+    {
+        flat_grid g{T_ROWS, T_COLUMNS, T_LEVELS};
+
+        // Comb on every level: each row runs east from the first column, which runs south, one stair joins the levels
+        static constexpr auto PLANE = static_cast<int>(T_ROWS * T_COLUMNS);
+        auto &masks = g.operations().get_link_masks();
+        for (auto i = 0; i < PLANE * static_cast<int>(T_LEVELS); ++i)
+        {
+            masks.link(i, Direction::EAST, true);
+            if (i % static_cast<int>(T_COLUMNS) == 0)
+            {
+                masks.link(i, Direction::SOUTH, true);
+            }
+        }
+        for (auto level = 0; level < static_cast<int>(T_LEVELS) - 1; ++level)
+        {
+            REQUIRE(masks.link(level * PLANE, Direction::UP, true));
+        }
+
+        const auto field = distances::field(g.operations(), 0);
+        REQUIRE(field[PLANE] == 1);
+        REQUIRE(field[PLANE * 2 - 1] == 1 + static_cast<int>(T_ROWS + T_COLUMNS) - 2);
+        REQUIRE(std::none_of(field.cbegin(), field.cend(), [](auto d)
+                             { return d < 0; }));
+    }
+
+    SECTION(" Unreachable cells and a bad root ")
+    {
+        flat_grid g{T_ROWS, T_COLUMNS, 1};
+
+        const auto field = distances::field(g.operations(), 4);
+        REQUIRE(field[4] == 0);
+        REQUIRE(std::count(field.cbegin(), field.cend(), -1) == static_cast<std::ptrdiff_t>(field.size() - 1));
+
+        const auto none = distances::field(g.operations(), -1);
+        REQUIRE(std::all_of(none.cbegin(), none.cend(), [](auto d)
+                            { return d == -1; }));
+    }
+
+    SECTION(" colored_grid shows distances as text and colors in pixels ")
+    {
+        colored_grid g{T_ROWS, T_COLUMNS, 1};
+        REQUIRE(sidewinder{}.run(&g, rng));
+        REQUIRE_FALSE(g.has_background_colors());
+        REQUIRE_FALSE(g.has_contents());
+
+        g.calculate_distances(0);
+        REQUIRE(g.has_background_colors());
+        REQUIRE(g.contents_at(0) == "0");
+
+        const auto &field = g.get_distances();
+        const auto farthest = static_cast<int>(std::max_element(field.cbegin(), field.cend()) - field.cbegin());
+
+        REQUIRE(g.background_color_at(0) == distances::ramp_color(0, field[static_cast<size_t>(farthest)]));
+        REQUIRE(g.background_color_at(0) == 0xFFFFFF);
+        REQUIRE(g.background_color_at(farthest) == 0x008000);
+
+        REQUIRE(stringify{}.run(&g, rng));
+        REQUIRE(g.operations().get_str().find("    0 ") != std::string::npos);
+
+        static constexpr auto CELL = 3u, WALL = 1u;
+        const pixels p{CELL, WALL};
+        const auto width = p.width(T_COLUMNS);
+
+        vector<uint8_t> rgba;
+        REQUIRE(p.run(&g, rgba));
+
+        for (auto r = 0u; r < T_ROWS; ++r)
+        {
+            for (auto c = 0u; c < T_COLUMNS; ++c)
+            {
+                const auto color = g.background_color_at(static_cast<int>(r * T_COLUMNS + c));
+                const auto x = c * (CELL + WALL) + WALL, y = r * (CELL + WALL) + WALL;
+                const auto *px = rgba.data() + (y * width + x) * pixels::CHANNELS;
+
+                REQUIRE(px[0] == ((color >> 16) & 0xFF));
+                REQUIRE(px[1] == ((color >> 8) & 0xFF));
+                REQUIRE(px[2] == (color & 0xFF));
+                REQUIRE(px[3] == 255);
+            }
+        }
+    }
+}
+
+TEST_CASE("distance_grid keeps a dense field of distances", "[distances]")
+{
+    static constexpr auto T_ROWS = 15u, T_COLUMNS = 11u;
+    static constexpr auto LAST = static_cast<int>(T_ROWS * T_COLUMNS) - 1;
+
+    randomizer rng;
+    unique_ptr<grid_interface> owner = std::make_unique<distance_grid>(T_ROWS, T_COLUMNS, 1);
+    auto &g = static_cast<distance_grid &>(*owner);
+    REQUIRE(dfs{}.run(&g, rng));
+
+    SECTION(" Every cell of a perfect maze has a distance ")
+    {
+        g.calculate_distances(0, -1);
+
+        const auto &dists = *g.get_distances();
+        REQUIRE(dists.values().size() == T_ROWS * T_COLUMNS);
+        REQUIRE(std::all_of(dists.values().begin(), dists.values().end(), [](auto d)
+                            { return d >= 0; }));
+
+        const auto [farthest, longest] = dists.max();
+        REQUIRE(dists[farthest] == longest);
+        REQUIRE(*std::max_element(dists.values().begin(), dists.values().end()) == longest);
+
+        vector<int32_t> keys;
+        dists.collect_keys(keys);
+        REQUIRE(keys.size() == T_ROWS * T_COLUMNS);
+        REQUIRE(std::is_sorted(keys.cbegin(), keys.cend()));
+    }
+
+    SECTION(" The end index bounds the search ")
+    {
+        static constexpr auto END = 5;
+        g.calculate_distances(0, END);
+
+        const auto &dists = *g.get_distances();
+        REQUIRE(dists.max().second <= END);
+        REQUIRE(std::all_of(dists.values().begin(), dists.values().end(), [](auto d)
+                            { return d <= END; }));
+
+        const auto full = distances::field(g.operations(), 0);
+        for (auto i = 0; i <= LAST; ++i)
+        {
+            const auto d = full[static_cast<size_t>(i)];
+            REQUIRE(dists.contains(i) == (d <= END));
+        }
+    }
+
+    SECTION(" The path to a goal steps one link at a time ")
+    {
+        g.calculate_distances(0, -1);
+
+        const auto path = g.get_distances()->path_to(owner, LAST);
+        const auto &dists = *g.get_distances();
+
+        vector<int32_t> steps;
+        path->collect_keys(steps);
+        REQUIRE(static_cast<int>(steps.size()) == dists[LAST] + 1);
+
+        // Order the path by distance, each step is linked to the one before it
+        std::sort(steps.begin(), steps.end(), [&path](auto a, auto b)
+                  { return (*path)[a] < (*path)[b]; });
+        REQUIRE(steps.front() == 0);
+        REQUIRE(steps.back() == LAST);
+
+        const auto &masks = g.operations().get_link_masks();
+        for (size_t i = 1; i < steps.size(); ++i)
+        {
+            REQUIRE((*path)[steps[i]] == dists[steps[i]]);
+
+            bool linked = false;
+            for (auto d = 0; d < static_cast<int>(Direction::COUNT); ++d)
+            {
+                linked = linked || (masks.is_linked(steps[i], static_cast<Direction>(d)) && masks.neighbor_index(steps[i], static_cast<Direction>(d)) == steps[i - 1]);
+            }
+            REQUIRE(linked);
+        }
+    }
+}
+
+TEST_CASE("Parallel breadth-first search matches the serial field", "[distances][parallel bfs]")
+{
+    static constexpr auto T_ROWS = 40u, T_COLUMNS = 50u;
+
+    // Expand top-down levels in parallel from a handful of frontier cells
+    static constexpr std::size_t SMALL_GRAIN = 8;
+
+    randomizer rng;
+
+    SECTION(" Mazes of every shape ")
+    {
+        std::vector<std::pair<std::string, std::unique_ptr<algo_interface>>> algos;
+        algos.emplace_back("dfs", std::make_unique<dfs>());
+        algos.emplace_back("binary_tree", std::make_unique<binary_tree>());
+        algos.emplace_back("sidewinder", std::make_unique<sidewinder>());
+
+        for (const auto &[name, algo] : algos)
+        {
+            flat_grid g{T_ROWS, T_COLUMNS, 1};
+            REQUIRE(algo->run(&g, rng));
+
+            const auto serial = distances::field(g.operations(), 7);
+
+            for (auto threads : {1u, 2u, 4u})
+            {
+                INFO(name << " on " << threads << " threads");
+
+                parallel_bfs bfs{threads, SMALL_GRAIN};
+                REQUIRE(bfs.run(g.operations(), 7) == serial);
+                REQUIRE(bfs.run(g.operations(), 7, 9) == distances::field(g.operations(), 7, 9));
+            }
+        }
+    }
+
+    SECTION(" Wide frontiers are expanded bottom-up ")
+    {
+        static constexpr auto SIDE = 16u;
+
+        // Every cell is linked to each of its neighbors
+        flat_grid g{SIDE, SIDE, SIDE};
+        auto &masks = g.operations().get_link_masks();
+        for (auto i = 0; i < masks.size(); ++i)
+        {
+            for (auto d : {Direction::SOUTH, Direction::EAST, Direction::UP})
+            {
+                masks.link(i, d, true);
+            }
+        }
+
+        const auto serial = distances::field(g.operations(), 0);
+        REQUIRE(serial.back() == 3 * static_cast<int>(SIDE - 1));
+
+        for (auto threads : {1u, 3u})
+        {
+            parallel_bfs bfs{threads, SMALL_GRAIN};
+            REQUIRE(bfs.run(g.operations(), 0) == serial);
+            REQUIRE(bfs.bottom_up_levels() > 0);
+        }
+
+        REQUIRE(parallel_bfs{2}.run(g.operations(), -1) == distances::field(g.operations(), -1));
+    }
+
+    SECTION(" distance_grid calculates distances on several threads ")
+    {
+        distance_grid serial{T_ROWS, T_COLUMNS, 1}, parallel{T_ROWS, T_COLUMNS, 1};
+        REQUIRE(sidewinder{}.run(&serial, rng));
+        parallel.operations().get_link_masks() = serial.operations().get_link_masks();
+
+        REQUIRE(parallel.get_distance_threads() == 1);
+        parallel.set_distance_threads(4);
+
+        serial.calculate_distances(3, -1);
+        parallel.calculate_distances(3, -1);
+
+        const auto expected = serial.get_distances()->values();
+        const auto found = parallel.get_distances()->values();
+        REQUIRE(std::equal(expected.begin(), expected.end(), found.begin(), found.end()));
+        REQUIRE(parallel.get_distances()->max() == serial.get_distances()->max());
+    }
+}
+
+TEST_CASE("A path index answers queries between any two cells", "[distances][path index]")
+{
+    static constexpr auto T_ROWS = 23u, T_COLUMNS = 31u;
+    static constexpr auto CELLS = static_cast<int>(T_ROWS * T_COLUMNS);
+    static constexpr auto QUERIES = 300;
+
+    randomizer rng;
+
+    std::vector<std::pair<std::string, std::unique_ptr<algo_interface>>> algos;
+    algos.emplace_back("dfs", std::make_unique<dfs>());
+    algos.emplace_back("binary_tree", std::make_unique<binary_tree>());
+    algos.emplace_back("sidewinder", std::make_unique<sidewinder>());
+
+    for (const auto &[name, algo] : algos)
+    {
+        INFO(name);
+
+        flat_grid g{T_ROWS, T_COLUMNS, 1};
+        REQUIRE(algo->run(&g, rng));
+
+        const path_index index{g.operations(), rng(0, CELLS - 1)};
+        REQUIRE(index.size() == static_cast<std::size_t>(CELLS));
+
+        const auto &masks = g.operations().get_link_masks();
+        vector<int32_t> cells;
+
+        for (auto q = 0; q < QUERIES; ++q)
+        {
+            const auto a = rng(0, CELLS - 1), b = rng(0, CELLS - 1);
+
+            // Distances in a perfect maze are the same from any root
+            const auto expected = distances::field(g.operations(), a)[static_cast<size_t>(b)];
+            REQUIRE(index.distance(a, b) == expected);
+            REQUIRE(index.distance(b, a) == expected);
+
+            REQUIRE(index.path(a, b, cells));
+            REQUIRE(static_cast<int>(cells.size()) == expected + 1);
+            REQUIRE(cells.front() == a);
+            REQUIRE(cells.back() == b);
+
+            for (size_t i = 1; i < cells.size(); ++i)
+            {
+                const auto d = masks.direction_between(cells[i - 1], cells[i]);
+                REQUIRE(d.has_value());
+                REQUIRE(masks.is_linked(cells[i - 1], *d));
+            }
+        }
+    }
+
+    SECTION(" Cells apart from the root are left out ")
+    {
+        flat_grid g{T_ROWS, T_COLUMNS, 1};
+
+        auto &masks = g.operations().get_link_masks();
+        REQUIRE(masks.link(0, Direction::EAST, true));
+        REQUIRE(masks.link(1, Direction::SOUTH, true));
+
+        const path_index index{g.operations(), 0};
+        REQUIRE(index.size() == 3);
+        REQUIRE(index.distance(0, static_cast<int>(T_COLUMNS) + 1) == 2);
+        REQUIRE(index.lowest_common_ancestor(static_cast<int>(T_COLUMNS) + 1, 1) == 1);
+        REQUIRE(index.distance(0, 2) == -1);
+        REQUIRE(index.distance(0, CELLS) == -1);
+
+        vector<int32_t> cells{42};
+        REQUIRE_FALSE(index.path(0, 2, cells));
+        REQUIRE(cells.empty());
+
+        REQUIRE(path_index{g.operations(), -1}.size() == 0);
+    }
+}
+
+TEST_CASE("A solver finds shortest paths with reused buffers", "[distances][solver]")
+{
+    static constexpr auto T_ROWS = 27u, T_COLUMNS = 19u;
+    static constexpr auto CELLS = static_cast<int>(T_ROWS * T_COLUMNS);
+    static constexpr auto QUERIES = 200;
+
+    randomizer rng;
+    flat_grid g{T_ROWS, T_COLUMNS, 1};
+    REQUIRE(dfs{}.run(&g, rng));
+
+    const auto &masks = g.operations().get_link_masks();
+
+    solver s;
+
+    SECTION(" Paths are shortest and follow the links ")
+    {
+        const auto first = s.solve(g.operations(), 0, CELLS - 1);
+        const auto *buffer = first.data();
+
+        for (auto q = 0; q < QUERIES; ++q)
+        {
+            const auto a = rng(0, CELLS - 1), b = rng(0, CELLS - 1);
+
+            const auto cells = s.solve(g.operations(), a, b);
+            REQUIRE(static_cast<int>(cells.size()) == distances::field(g.operations(), a)[static_cast<size_t>(b)] + 1);
+            REQUIRE(cells.front() == a);
+            REQUIRE(cells.back() == b);
+            REQUIRE(s.visited() <= static_cast<size_t>(CELLS));
+
+            for (size_t i = 1; i < cells.size(); ++i)
+            {
+                const auto d = masks.direction_between(cells[i - 1], cells[i]);
+                REQUIRE(d.has_value());
+                REQUIRE(masks.is_linked(cells[i - 1], *d));
+            }
+
+            // Nothing was reallocated
+            REQUIRE(cells.data() == buffer);
+        }
+    }
+
+    SECTION(" Loops, walls, and bad cells ")
+    {
+        // Open every passage, the shortest path is the Manhattan distance
+        flat_grid open{T_ROWS, T_COLUMNS, 1};
+        auto &open_masks = open.operations().get_link_masks();
+        for (auto i = 0; i < CELLS; ++i)
+        {
+            open_masks.link(i, Direction::EAST, true);
+            open_masks.link(i, Direction::SOUTH, true);
+        }
+
+        REQUIRE(s.solve(open.operations(), 0, CELLS - 1).size() == T_ROWS + T_COLUMNS - 1);
+        REQUIRE(s.solve(open.operations(), 5, 5).size() == 1);
+
+        flat_grid walls{T_ROWS, T_COLUMNS, 1};
+        REQUIRE(s.solve(walls.operations(), 0, 1).empty());
+        REQUIRE(s.solve(g.operations(), 0, CELLS).empty());
+        REQUIRE(s.solve(g.operations(), -1, 0).empty());
+    }
+}
+
+TEST_CASE("Analytics summarize a maze", "[distances][analytics]")
+{
+    SECTION(" A straight corridor ")
+    {
+        flat_grid g{1, 5, 1};
+        auto &masks = g.operations().get_link_masks();
+        for (auto i = 0; i < 4; ++i)
+        {
+            REQUIRE(masks.link(i, Direction::EAST, true));
+        }
+
+        const auto stats = analytics::from(g.operations());
+        REQUIRE(stats.cells == 5);
+        REQUIRE(stats.passages == 4);
+        REQUIRE(stats.degree_histogram == std::array<std::size_t, 7>{0, 2, 3, 0, 0, 0, 0});
+        REQUIRE(stats.dead_ends == 2);
+        REQUIRE(stats.corridors == 3);
+        REQUIRE(stats.straight_corridors == 3);
+        REQUIRE(stats.junctions == 0);
+        REQUIRE(stats.river_factor == 0.6);
+        REQUIRE(stats.straight_runs == 1);
+        REQUIRE(stats.longest_straight_run == 4);
+        REQUIRE(stats.mean_straight_run == 4.0);
+        REQUIRE(stats.reachable == 5);
+        REQUIRE(stats.diameter == 4);
+        REQUIRE(stats.diameter_start == 4);
+        REQUIRE(stats.diameter_end == 0);
+        REQUIRE(stats.mean_path_length == 2.0);
+
+        const auto json = stats.to_json();
+        REQUIRE(json.find("\"diameter\": 4") != std::string::npos);
+        REQUIRE(json.find("\"degree_histogram\"") != std::string::npos);
+    }
+
+    SECTION(" A corridor past the range of a 64-bit sum of pair distances ")
+    {
+        // The pair distances of a line of n cells add up to (n^3 - n) / 6, about 2.1e19 here
+        static constexpr auto LENGTH = 5'000'000u;
+
+        flat_grid g{1, LENGTH, 1};
+        auto &masks = g.operations().get_link_masks();
+        for (auto i = 0; i + 1 < static_cast<int>(LENGTH); ++i)
+        {
+            masks.link(i, Direction::EAST, true);
+        }
+
+        const auto stats = analytics::from(g.operations());
+        REQUIRE(stats.reachable == LENGTH);
+        REQUIRE(stats.diameter == static_cast<int>(LENGTH) - 1);
+
+        // The mean over every pair is (n + 1) / 3
+        const auto expected = (static_cast<double>(LENGTH) + 1.0) / 3.0;
+        REQUIRE(std::abs(stats.mean_path_length - expected) < expected * 1e-9);
+    }
+
+    SECTION(" Generated mazes match a brute force count ")
+    {
+        static constexpr auto T_ROWS = 9u, T_COLUMNS = 13u;
+        static constexpr auto CELLS = static_cast<int>(T_ROWS * T_COLUMNS);
+
+        randomizer rng;
+
+        std::vector<std::unique_ptr<algo_interface>> algos;
+        algos.emplace_back(std::make_unique<dfs>());
+        algos.emplace_back(std::make_unique<binary_tree>());
+        algos.emplace_back(std::make_unique<sidewinder>());
+
+        for (const auto &algo : algos)
+        {
+            flat_grid g{T_ROWS, T_COLUMNS, 1};
+            REQUIRE(algo->run(&g, rng));
+
+            const auto stats = analytics::from(g.operations());
+            const auto &masks = g.operations().get_link_masks();
+
+            std::array<std::size_t, 7> histogram{};
+            for (auto i = 0; i < CELLS; ++i)
+            {
+                ++histogram[static_cast<size_t>(std::popcount(static_cast<unsigned int>(masks.get(i))))];
+            }
+            REQUIRE(stats.degree_histogram == histogram);
+
+            // A perfect maze is a spanning tree
+            REQUIRE(stats.passages == static_cast<size_t>(CELLS - 1));
+            REQUIRE(stats.reachable == static_cast<size_t>(CELLS));
+            REQUIRE(stats.dead_ends + stats.corridors + stats.junctions == static_cast<size_t>(CELLS));
+
+            int diameter = 0;
+            std::int64_t total = 0;
+            for (auto i = 0; i < CELLS; ++i)
+            {
+                for (const auto d : distances::field(g.operations(), i))
+                {
+                    diameter = std::max(diameter, d);
+                    total += d;
+                }
+            }
+
+            REQUIRE(stats.diameter == diameter);
+            REQUIRE(distances::field(g.operations(), stats.diameter_start)[static_cast<size_t>(stats.diameter_end)] == diameter);
+            REQUIRE(std::abs(stats.mean_path_length - static_cast<double>(total) / (CELLS * (CELLS - 1.0))) < 1e-9);
+        }
+    }
+}
+
+#if defined(MAZE_BENCHMARK)
+
+TEST_CASE("Benchmark a distance heatmap of a million cells", "[heatmap][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 1'000u, BENCH_COLUMNS = 1'000u;
+
+    randomizer rng;
+    colored_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+    REQUIRE(binary_tree{}.run(&g, rng));
+
+    BENCHMARK("Distance field of 1000x1000")
+    {
+        g.calculate_distances(0);
+        return g.get_distances().size();
+    };
+
+    const pixels p{1, 1};
+    vector<uint8_t> rgba;
+
+    BENCHMARK("Rasterize 1000x1000 heatmap")
+    {
+        return p.run(&g, rgba);
+    };
+}
+
+TEST_CASE("Benchmark distance_grid on a million cells", "[distances][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 1'000u, BENCH_COLUMNS = 1'000u;
+
+    randomizer rng;
+    distance_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+    REQUIRE(dfs{}.run(&g, rng));
+
+    BENCHMARK("calculate_distances of 1000x1000")
+    {
+        g.calculate_distances(0, -1);
+        return g.get_distances()->max();
+    };
+}
+
+TEST_CASE("Benchmark parallel breadth-first search scaling", "[parallel bfs][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 1'000u, BENCH_COLUMNS = 1'000u;
+
+    randomizer rng;
+
+    // Binary trees have wide frontiers, dfs carves one long corridor
+    flat_grid wide{BENCH_ROWS, BENCH_COLUMNS, 1}, deep{BENCH_ROWS, BENCH_COLUMNS, 1};
+    REQUIRE(binary_tree{}.run(&wide, rng));
+    REQUIRE(dfs{}.run(&deep, rng));
+
+    BENCHMARK("Serial field of a 1000x1000 binary tree")
+    {
+        return distances::field(wide.operations(), 0).size();
+    };
+
+    for (auto threads : {1u, 2u, 4u, 8u})
+    {
+        parallel_bfs bfs{threads};
+
+        BENCHMARK("Parallel field of a 1000x1000 binary tree on " + std::to_string(threads) + " threads")
+        {
+            return bfs.run(wide.operations(), 0).size();
+        };
+
+        BENCHMARK("Parallel field of a 1000x1000 dfs maze on " + std::to_string(threads) + " threads")
+        {
+            return bfs.run(deep.operations(), 0).size();
+        };
+    }
+}
+
+TEST_CASE("Benchmark path index queries", "[path index][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 1'000u, BENCH_COLUMNS = 1'000u;
+    static constexpr auto CELLS = static_cast<int>(BENCH_ROWS * BENCH_COLUMNS);
+    static constexpr auto QUERIES = 10'000;
+
+    randomizer rng;
+    flat_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+    REQUIRE(dfs{}.run(&g, rng));
+
+    vector<std::pair<int32_t, int32_t>> queries;
+    for (auto q = 0; q < QUERIES; ++q)
+    {
+        queries.emplace_back(rng(0, CELLS - 1), rng(0, CELLS - 1));
+    }
+
+    BENCHMARK("Build the path index of 1000x1000")
+    {
+        return path_index{g.operations(), 0}.size();
+    };
+
+    const path_index index{g.operations(), 0};
+
+    BENCHMARK("10000 distance queries on 1000x1000")
+    {
+        int64_t total = 0;
+        for (const auto &[a, b] : queries)
+        {
+            total += index.distance(a, b);
+        }
+        return total;
+    };
+
+    BENCHMARK("One breadth-first search on 1000x1000")
+    {
+        return distances::field(g.operations(), queries.front().first)[static_cast<size_t>(queries.front().second)];
+    };
+}
+
+TEST_CASE("Benchmark solver queries", "[solver][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 1'000u, BENCH_COLUMNS = 1'000u;
+    static constexpr auto CELLS = static_cast<int>(BENCH_ROWS * BENCH_COLUMNS);
+
+    randomizer rng;
+    unique_ptr<grid_interface> g = std::make_unique<flat_grid>(BENCH_ROWS, BENCH_COLUMNS, 1);
+    REQUIRE(dfs{}.run(g.get(), rng));
+
+    solver s;
+    const auto a = rng(0, CELLS - 1), b = rng(0, CELLS - 1);
+
+    BENCHMARK("Bidirectional search on 1000x1000")
+    {
+        return s.solve(g->operations(), a, b).size();
+    };
+
+    const distances from{a};
+
+    BENCHMARK("distances::path_to on 1000x1000")
+    {
+        return from.path_to(g, b)->max();
+    };
+}
+
+TEST_CASE("Benchmark analytics of a million cells", "[analytics][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 1'000u, BENCH_COLUMNS = 1'000u;
+
+    randomizer rng;
+    flat_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+    REQUIRE(dfs{}.run(&g, rng));
+
+    BENCHMARK("Analytics of 1000x1000")
+    {
+        return analytics::from(g.operations()).diameter;
+    };
+}
+
+#endif // MAZE_BENCHMARK
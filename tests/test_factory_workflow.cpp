@@ -11,11 +11,16 @@
 #include <MazeBuilder/maze_factory.h>
 #include <MazeBuilder/randomizer.h>
 #include <MazeBuilder/string_utils.h>
+#include <MazeBuilder/xoshiro256ss.h>
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <span>
 #include <vector>
 
 using namespace mazes;
@@ -139,6 +144,71 @@ TEST_CASE("randomizer generates a number of integers", "[randomizer ints]")
     }
 }
 
+TEST_CASE("randomizer engines draw, fill, jump, and split", "[randomizer engines]")
+{
+    SECTION("xoshiro256** matches the reference outputs")
+    {
+        xoshiro256ss engine{std::array<std::uint64_t, 4>{1, 2, 3, 4}};
+
+        REQUIRE(engine() == 11520u);
+        REQUIRE(engine() == 0u);
+        REQUIRE(engine() == 1509978240u);
+        REQUIRE(engine() == 1215971899390074240u);
+
+        xoshiro256ss jumped{std::array<std::uint64_t, 4>{1, 2, 3, 4}};
+        jumped.jump();
+        REQUIRE(jumped() == 0xBBD2F312298443D8u);
+    }
+
+    for (auto engine : {rng_engine::XOSHIRO256SS, rng_engine::MT19937})
+    {
+        DYNAMIC_SECTION("Engine " << to_sv_from_rng_engine(engine))
+        {
+            randomizer rng{engine};
+            REQUIRE(rng.engine() == engine);
+            REQUIRE(to_rng_engine_from_sv(to_sv_from_rng_engine(engine)) == engine);
+
+            randomizer same_rng{rng};
+
+            // Bulk draws match single draws
+            array<int, 257> values{};
+            rng.fill(span<int>{values}, -3, 11);
+            for (auto v : values)
+            {
+                REQUIRE(v == same_rng(-3, 11));
+                REQUIRE((v >= -3 && v <= 11));
+            }
+
+            array<std::uint64_t, 64> bits{}, same_bits{};
+            rng.fill(span<std::uint64_t>{bits});
+            same_rng.fill(span<std::uint64_t>{same_bits});
+            REQUIRE(bits == same_bits);
+
+            // Full range and a single value
+            REQUIRE(rng(5, 5) == 5);
+            REQUIRE_NOTHROW(rng(std::numeric_limits<int>::min(), std::numeric_limits<int>::max()));
+
+            // Jumped and split streams are reproducible and differ from the original
+            randomizer jumped{rng}, same_jumped{rng};
+            jumped.jump();
+            same_jumped.jump();
+            REQUIRE(jumped(0, 1'000'000) == same_jumped(0, 1'000'000));
+
+            randomizer copy{rng};
+            auto child = rng.split();
+            auto same_child = copy.split();
+            REQUIRE(child.engine() == engine);
+
+            array<int, 16> from_child{}, from_same_child{}, from_parent{};
+            child.fill(span<int>{from_child}, 0, 1'000'000);
+            same_child.fill(span<int>{from_same_child}, 0, 1'000'000);
+            rng.fill(span<int>{from_parent}, 0, 1'000'000);
+            REQUIRE(from_child == from_same_child);
+            REQUIRE(from_child != from_parent);
+        }
+    }
+}
+
 TEST_CASE("Grid grid_factory registration", "[grid_factory registration]")
 {
 
@@ -249,3 +319,35 @@ TEST_CASE("Grid grid_factory registration", "[grid_factory registration]")
     }
 }
 
+
+#if defined(MAZE_BENCHMARK)
+
+TEST_CASE("Benchmark randomizer engines", "[randomizer engines][benchmark]")
+{
+    static constexpr auto DRAWS = 1'000'000;
+
+    vector<int> values(DRAWS);
+
+    for (auto engine : {rng_engine::MT19937, rng_engine::XOSHIRO256SS})
+    {
+        randomizer rng{engine};
+
+        BENCHMARK("1M draws one at a time with " + std::string{to_sv_from_rng_engine(engine)})
+        {
+            int sum{0};
+            for (auto i{0}; i < DRAWS; ++i)
+            {
+                sum += rng(0, 3);
+            }
+            return sum;
+        };
+
+        BENCHMARK("1M draws in bulk with " + std::string{to_sv_from_rng_engine(engine)})
+        {
+            rng.fill(span<int>{values}, 0, 3);
+            return values.back();
+        };
+    }
+}
+
+#endif // MAZE_BENCHMARK
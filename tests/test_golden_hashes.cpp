@@ -0,0 +1,212 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <MazeBuilder/binary_tree.h>
+#include <MazeBuilder/configurator.h>
+#include <MazeBuilder/create.h>
+#include <MazeBuilder/enums.h>
+#include <MazeBuilder/flat_grid.h>
+#include <MazeBuilder/randomizer.h>
+#include <MazeBuilder/sidewinder.h>
+
+using namespace mazes;
+using namespace std;
+
+// Pinned outputs for seeded generation, a change here changes every cached or shared maze
+// Regenerate them only when an algorithm is meant to change, and say so in the commit
+
+static constexpr auto GOLDEN_SEED = 42u;
+
+// FNV-1a over bytes, ints are fed little-endian so the hash is the same on every platform
+class fnv1a
+{
+public:
+    void add(std::uint8_t byte) noexcept
+    {
+        m_hash = (m_hash ^ byte) * 0x100000001B3ull;
+    }
+
+    void add(int value) noexcept
+    {
+        const auto bits = static_cast<std::uint32_t>(value);
+
+        for (auto shift : {0u, 8u, 16u, 24u})
+        {
+            add(static_cast<std::uint8_t>(bits >> shift));
+        }
+    }
+
+    std::uint64_t value() const noexcept { return m_hash; }
+
+private:
+    std::uint64_t m_hash{0xCBF29CE484222325ull};
+};
+
+struct golden
+{
+    algo algorithm;
+    unsigned int rows, columns, levels;
+    std::uint64_t hash;
+};
+
+static std::uint64_t hash_links(const flat_grid &g)
+{
+    fnv1a h;
+
+    for (auto mask : g.get_link_masks().data())
+    {
+        h.add(mask);
+    }
+
+    return h.value();
+}
+
+TEST_CASE("Seeded algorithms match their golden hashes", "[golden]")
+{
+    static const std::vector<golden> expected{
+        golden{algo::BINARY_TREE, 1u, 1u, 1u, 0xAF63BD4C8601B7DFull},
+        golden{algo::BINARY_TREE, 10u, 10u, 1u, 0x0986406E315B5106ull},
+        golden{algo::BINARY_TREE, 37u, 23u, 1u, 0xE12B42FD0D356852ull},
+        golden{algo::BINARY_TREE, 100u, 100u, 1u, 0x6454619613FBFD2Bull},
+        golden{algo::BINARY_TREE, 6u, 5u, 3u, 0x7BA4A57D333DEE66ull},
+        golden{algo::SIDEWINDER, 1u, 1u, 1u, 0xAF63BD4C8601B7DFull},
+        golden{algo::SIDEWINDER, 10u, 10u, 1u, 0xE52D000BC89A69CCull},
+        golden{algo::SIDEWINDER, 37u, 23u, 1u, 0xF6BBC1AF90CA391Eull},
+        golden{algo::SIDEWINDER, 100u, 100u, 1u, 0x4B6CD2468796042Cull},
+        golden{algo::SIDEWINDER, 6u, 5u, 3u, 0x1A5C43E2194DEB73ull},
+        golden{algo::DFS, 1u, 1u, 1u, 0xAF63BD4C8601B7DFull},
+        golden{algo::DFS, 10u, 10u, 1u, 0x745FFA1A19563A4Bull},
+        golden{algo::DFS, 37u, 23u, 1u, 0x1263B14F2EBB95BFull},
+        golden{algo::DFS, 100u, 100u, 1u, 0xC4C0246ABE3DBC6Eull},
+        golden{algo::DFS, 6u, 5u, 3u, 0x229CFD009AB6F864ull},
+        golden{algo::ELLERS, 1u, 1u, 1u, 0xAF63BD4C8601B7DFull},
+        golden{algo::ELLERS, 10u, 10u, 1u, 0x6CF2AD8E2137EA77ull},
+        golden{algo::ELLERS, 37u, 23u, 1u, 0x683B7A9CD26A134Full},
+        golden{algo::ELLERS, 100u, 100u, 1u, 0x7154098BCBED74D3ull},
+        golden{algo::ELLERS, 6u, 5u, 3u, 0x6D1D1E91E26A6BBBull},
+    };
+
+    for (const auto &[algorithm, rows, columns, levels, hash] : expected)
+    {
+        DYNAMIC_SECTION(to_sv_from_algo(algorithm) << " " << rows << "x" << columns << "x" << levels)
+        {
+            configurator config;
+            config.rows(rows).columns(columns).levels(levels).algo_id(algorithm);
+
+            auto runner = configurator::make_algo_from_config(config);
+            REQUIRE(runner.has_value());
+
+            flat_grid g{rows, columns, levels};
+            randomizer rng;
+            rng.seed(GOLDEN_SEED);
+
+            REQUIRE(runner.value()->run(&g, rng));
+            REQUIRE(hash_links(g) == hash);
+        }
+    }
+}
+
+TEST_CASE("Seeded row-parallel algorithms match their golden hashes", "[golden]")
+{
+    static const std::vector<golden> expected{
+        golden{algo::BINARY_TREE, 1u, 1u, 1u, 0xAF63BD4C8601B7DFull},
+        golden{algo::BINARY_TREE, 10u, 10u, 1u, 0xB3E6C50C36B2B43Eull},
+        golden{algo::BINARY_TREE, 37u, 23u, 1u, 0x605C055051093500ull},
+        golden{algo::BINARY_TREE, 100u, 100u, 1u, 0xEBEB2ED73647A0CFull},
+        golden{algo::BINARY_TREE, 6u, 5u, 3u, 0x672D4001DEBF118Dull},
+        golden{algo::SIDEWINDER, 1u, 1u, 1u, 0xAF63BD4C8601B7DFull},
+        golden{algo::SIDEWINDER, 10u, 10u, 1u, 0xEF4B892440D7393Bull},
+        golden{algo::SIDEWINDER, 37u, 23u, 1u, 0xB71FC766A4C18030ull},
+        golden{algo::SIDEWINDER, 100u, 100u, 1u, 0x5554952E1044F495ull},
+        golden{algo::SIDEWINDER, 6u, 5u, 3u, 0x92C68C6F1B09E20Full},
+    };
+
+    for (const auto &[algorithm, rows, columns, levels, hash] : expected)
+    {
+        DYNAMIC_SECTION("parallel " << to_sv_from_algo(algorithm) << " " << rows << "x" << columns << "x" << levels)
+        {
+            flat_grid g{rows, columns, levels};
+            randomizer rng;
+            rng.seed(GOLDEN_SEED);
+
+            if (algorithm == algo::BINARY_TREE)
+            {
+                REQUIRE(binary_tree{3}.run(&g, rng));
+            }
+            else
+            {
+                REQUIRE(sidewinder{3}.run(&g, rng));
+            }
+
+            REQUIRE(hash_links(g) == hash);
+        }
+    }
+}
+
+TEST_CASE("Seeded create output matches its golden hashes", "[golden]")
+{
+    static constexpr std::array<std::tuple<algo, std::uint64_t>, 4> expected{{
+        {algo::BINARY_TREE, 0x3F073DD42BA99403ull},
+        {algo::SIDEWINDER, 0xE21EB717CA18AD1Cull},
+        {algo::DFS, 0xD1EE77C53CCF29B4ull},
+        {algo::ELLERS, 0x23D4FDC60ACEA34Bull},
+    }};
+
+    for (const auto &[algorithm, hash] : expected)
+    {
+        DYNAMIC_SECTION("create " << to_sv_from_algo(algorithm))
+        {
+            const auto s = create(configurator().rows(10).columns(12).algo_id(algorithm).seed(7));
+
+            fnv1a h;
+            for (auto c : s)
+            {
+                h.add(static_cast<std::uint8_t>(c));
+            }
+
+            REQUIRE(h.value() == hash);
+        }
+    }
+}
+
+TEST_CASE("Seeded randomizer engines match their golden hashes", "[golden]")
+{
+    static constexpr std::array<std::tuple<rng_engine, std::uint64_t, std::uint64_t>, 2> expected{{
+        {rng_engine::XOSHIRO256SS, 0x1E60198AD0F54818ull, 0x89BB22704ACC9CF8ull},
+        {rng_engine::MT19937, 0xB70B3502F608F71Bull, 0x93A9BF2DE90CBD24ull},
+    }};
+
+    for (const auto &[engine, fill_hash, shuffle_hash] : expected)
+    {
+        DYNAMIC_SECTION("engine " << to_sv_from_rng_engine(engine))
+        {
+            randomizer rng{engine};
+            rng.seed(GOLDEN_SEED);
+
+            array<int, 1000> values{};
+            rng.fill(span<int>{values}, 0, 999);
+
+            fnv1a fill_h;
+            for (auto v : values)
+            {
+                fill_h.add(v);
+            }
+
+            fnv1a shuffle_h;
+            for (auto v : rng.get_vector_ints(0, 99, 100))
+            {
+                shuffle_h.add(v);
+            }
+
+            REQUIRE(fill_h.value() == fill_hash);
+            REQUIRE(shuffle_h.value() == shuffle_hash);
+        }
+    }
+}
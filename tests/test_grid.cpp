@@ -2,22 +2,34 @@
 #include <catch2/benchmark/catch_benchmark.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <functional>
 #include <memory>
 #include <numeric>
 #include <random>
+#include <span>
 #include <sstream>
+#include <stack>
+#include <stdexcept>
+#include <tuple>
 #include <unordered_set>
 #include <vector>
 
+#include <MazeBuilder/binary_tree.h>
 #include <MazeBuilder/cell.h>
 #include <MazeBuilder/colored_grid.h>
+#include <MazeBuilder/dfs.h>
 #include <MazeBuilder/distance_grid.h>
+#include <MazeBuilder/ellers.h>
+#include <MazeBuilder/flat_grid.h>
 #include <MazeBuilder/grid.h>
 #include <MazeBuilder/lab.h>
 #include <MazeBuilder/randomizer.h>
+#include <MazeBuilder/row_streams.h>
+#include <MazeBuilder/sidewinder.h>
+#include <MazeBuilder/stringify.h>
 
 using namespace mazes;
 using namespace std;
@@ -35,6 +47,57 @@ bool find_cell_in_links(const std::vector<std::pair<std::shared_ptr<cell>, bool>
                        { return link.first == target; });
 }
 
+// Reference depth-first search through the shared_ptr API, kept to check the index-based dfs against
+static bool reference_dfs(grid_interface *g, randomizer &rng)
+{
+    const auto &grid_ops = g->operations();
+
+    auto [rows, columns, levels] = grid_ops.get_dimensions();
+    int total_possible_cells = static_cast<int>(rows * columns * levels);
+
+    auto start = grid_ops.search(rng(0, total_possible_cells - 1));
+
+    if (!start)
+    {
+        return false;
+    }
+
+    stack<shared_ptr<cell>> stack_of_cells;
+    unordered_set<shared_ptr<cell>> visited_cells;
+
+    stack_of_cells.push(start);
+    visited_cells.insert(start);
+
+    while (!stack_of_cells.empty())
+    {
+        auto current_cell = stack_of_cells.top();
+
+        auto current_neighbors = grid_ops.get_neighbors(current_cell);
+
+        vector<shared_ptr<cell>> unvisited_neighbors;
+
+        copy_if(current_neighbors.begin(), current_neighbors.end(),
+                back_inserter(unvisited_neighbors), [&visited_cells](const auto &n)
+                { return n && visited_cells.find(n) == visited_cells.end(); });
+
+        if (unvisited_neighbors.empty())
+        {
+            stack_of_cells.pop();
+        }
+        else
+        {
+            const auto &neighbor = unvisited_neighbors.at(rng(0, static_cast<int>(unvisited_neighbors.size()) - 1));
+
+            lab::link(current_cell, neighbor, true);
+
+            visited_cells.insert(neighbor);
+            stack_of_cells.push(neighbor);
+        }
+    }
+
+    return true;
+}
+
 TEST_CASE("Static Assert grid", "[grid static asserts]")
 {
     STATIC_REQUIRE(std::is_default_constructible<mazes::grid>::value);
@@ -44,6 +107,13 @@ TEST_CASE("Static Assert grid", "[grid static asserts]")
     STATIC_REQUIRE(std::is_move_constructible<mazes::grid>::value);
     STATIC_REQUIRE(std::is_move_assignable<mazes::grid>::value);
 
+    STATIC_REQUIRE(std::is_default_constructible<mazes::flat_grid>::value);
+    STATIC_REQUIRE(std::is_destructible<mazes::flat_grid>::value);
+    STATIC_REQUIRE(std::is_copy_constructible<mazes::flat_grid>::value);
+    STATIC_REQUIRE(std::is_copy_assignable<mazes::flat_grid>::value);
+    STATIC_REQUIRE(std::is_move_constructible<mazes::flat_grid>::value);
+    STATIC_REQUIRE(std::is_move_assignable<mazes::flat_grid>::value);
+
     STATIC_REQUIRE(std::is_default_constructible<mazes::cell>::value);
     STATIC_REQUIRE(std::is_destructible<mazes::cell>::value);
     STATIC_REQUIRE(std::is_copy_constructible<mazes::cell>::value);
@@ -83,3 +153,655 @@ TEST_CASE("Test grid dimensions", "[grid dimensions]")
     }
 }
 
+TEST_CASE("Flat grid matches grid topology", "[flat grid]")
+{
+    static constexpr auto FLAT_ROWS = 4, FLAT_COLUMNS = 3, FLAT_LEVELS = 2;
+
+    grid map_backed{FLAT_ROWS, FLAT_COLUMNS, FLAT_LEVELS};
+    flat_grid flat{FLAT_ROWS, FLAT_COLUMNS, FLAT_LEVELS};
+
+    REQUIRE(flat.num_cells() == map_backed.num_cells());
+    REQUIRE(flat.get_dimensions() == map_backed.get_dimensions());
+
+    SECTION(" Search is index addressed ")
+    {
+        for (auto i{0}; i < flat.num_cells(); ++i)
+        {
+            auto c = flat.search(i);
+            REQUIRE(c);
+            REQUIRE(c->get_index() == i);
+            // Same cell every time, not a copy
+            REQUIRE(c.get() == flat.search(i).get());
+        }
+
+        REQUIRE_FALSE(flat.search(-1));
+        REQUIRE_FALSE(flat.search(flat.num_cells()));
+    }
+
+    SECTION(" Neighbors agree with the map-backed grid ")
+    {
+        for (auto i{0}; i < flat.num_cells(); ++i)
+        {
+            for (auto dir : {Direction::NORTH, Direction::SOUTH, Direction::EAST, Direction::WEST})
+            {
+                auto expected = map_backed.get_neighbor(map_backed.search(i), dir);
+                auto actual = flat.get_neighbor(flat.search(i), dir);
+
+                REQUIRE(static_cast<bool>(expected) == static_cast<bool>(actual));
+                if (expected)
+                {
+                    REQUIRE(expected->get_index() == actual->get_index());
+                }
+            }
+        }
+    }
+
+    SECTION(" Links between cells in the block ")
+    {
+        auto c0 = flat.search(0);
+        auto c1 = flat.get_east(c0);
+        auto c3 = flat.get_south(c0);
+
+        lab::link(c0, c1);
+
+        REQUIRE(c0->is_linked(c1));
+        REQUIRE(c1->is_linked(c0));
+        REQUIRE_FALSE(c0->is_linked(c3));
+        REQUIRE(find_cell_in_links(c0->get_links(), c1));
+        REQUIRE_FALSE(find_cell_in_links(c0->get_links(), c3));
+    }
+
+    SECTION(" Cells outlive the grid that handed them out ")
+    {
+        std::shared_ptr<cell> kept;
+        {
+            flat_grid scoped{2, 2, 1};
+            kept = scoped.search(3);
+        }
+        REQUIRE(kept->get_index() == 3);
+    }
+}
+
+TEST_CASE("Algorithms run on a flat grid", "[flat grid]")
+{
+    auto g = make_unique<flat_grid>(ROWS, COLUMNS, 1);
+    randomizer rng;
+
+    dfs d;
+    REQUIRE(d.run(g.get(), rng));
+
+    // A perfect maze on n cells has n - 1 passages
+    size_t link_count{0};
+    for (auto i{0}; i < g->num_cells(); ++i)
+    {
+        link_count += g->search(i)->get_links().size();
+    }
+    REQUIRE(link_count / 2 == static_cast<size_t>(g->num_cells() - 1));
+}
+
+TEST_CASE("Index API agrees with the shared_ptr API", "[grid index api]")
+{
+    grid g{ROWS, COLUMNS, 2};
+    flat_grid flat{ROWS, COLUMNS, 2};
+    randomizer rng;
+
+    dfs d;
+    REQUIRE(d.run(&g, rng));
+    REQUIRE(d.run(&flat, rng));
+
+    for (grid_operations *ops : {static_cast<grid_operations *>(&g), static_cast<grid_operations *>(&flat)})
+    {
+        for (auto i{0}; i < ops->num_cells(); ++i)
+        {
+            const auto c = ops->search(i);
+            const auto indices = ops->get_neighbor_indices(i);
+
+            for (auto d{0}; d < static_cast<int>(Direction::COUNT); ++d)
+            {
+                const auto dir = static_cast<Direction>(d);
+                const auto n = ops->get_neighbor(c, dir);
+
+                REQUIRE(indices[static_cast<size_t>(d)] == ops->get_neighbor_index(i, dir));
+                REQUIRE(indices[static_cast<size_t>(d)] == (n ? n->get_index() : -1));
+                REQUIRE(ops->is_linked(i, dir) == (n && c->is_linked(n)));
+            }
+        }
+
+        REQUIRE(ops->get_neighbor_index(-1, Direction::NORTH) == -1);
+        REQUIRE(ops->get_neighbor_index(ops->num_cells(), Direction::SOUTH) == -1);
+        REQUIRE_FALSE(ops->is_linked(ops->num_cells(), Direction::EAST));
+    }
+}
+
+TEST_CASE("Built-in algorithms carve perfect mazes by index", "[grid index api]")
+{
+    auto count_passages = [](const grid_operations &ops)
+    {
+        size_t passages{0};
+        for (auto i{0}; i < ops.num_cells(); ++i)
+        {
+            for (auto dir : {Direction::SOUTH, Direction::EAST})
+            {
+                passages += ops.is_linked(i, dir) ? 1 : 0;
+            }
+        }
+        return passages;
+    };
+
+    randomizer rng;
+
+    SECTION(" Binary tree ")
+    {
+        grid g{ROWS, COLUMNS, 1};
+        binary_tree bt;
+        REQUIRE(bt.run(&g, rng));
+        REQUIRE(count_passages(g) == static_cast<size_t>(g.num_cells() - 1));
+    }
+
+    SECTION(" Sidewinder ")
+    {
+        flat_grid g{ROWS, COLUMNS, 1};
+        sidewinder sw;
+        REQUIRE(sw.run(&g, rng));
+        REQUIRE(count_passages(g) == static_cast<size_t>(g.num_cells() - 1));
+    }
+
+    SECTION(" Depth-first search ")
+    {
+        grid g{ROWS, COLUMNS, 1};
+        dfs d;
+        REQUIRE(d.run(&g, rng));
+        REQUIRE(count_passages(g) == static_cast<size_t>(g.num_cells() - 1));
+    }
+}
+
+TEST_CASE("DFS matches the shared_ptr reference", "[dfs]")
+{
+    for (auto [rows, columns, levels] : {std::tuple{1u, 1u, 1u}, std::tuple{1u, 17u, 1u}, std::tuple{13u, 7u, 1u}, std::tuple{31u, 29u, 1u}, std::tuple{6u, 5u, 3u}})
+    {
+        grid expected{rows, columns, levels};
+        flat_grid actual{rows, columns, levels};
+
+        randomizer rng;
+        randomizer same_rng{rng};
+
+        REQUIRE(reference_dfs(&expected, rng));
+        REQUIRE(dfs{}.run(&actual, same_rng));
+
+        REQUIRE(expected.get_link_masks().data() == actual.get_link_masks().data());
+
+        // Both consumed the same random numbers
+        REQUIRE(rng(0, 1'000'000) == same_rng(0, 1'000'000));
+    }
+}
+
+TEST_CASE("Row-parallel algorithms do not depend on the thread count", "[parallel rows]")
+{
+    static constexpr auto P_ROWS = 37u, P_COLUMNS = 23u, P_LEVELS = 2u;
+
+    auto count_passages = [](const grid_operations &ops)
+    {
+        size_t passages{0};
+        for (auto i{0}; i < ops.num_cells(); ++i)
+        {
+            for (auto dir : {Direction::SOUTH, Direction::EAST, Direction::DOWN})
+            {
+                passages += ops.is_linked(i, dir) ? 1 : 0;
+            }
+        }
+        return passages;
+    };
+
+    randomizer rng;
+
+    SECTION(" Binary tree ")
+    {
+        flat_grid expected{P_ROWS, P_COLUMNS, P_LEVELS};
+        randomizer same_rng{rng};
+        REQUIRE(binary_tree{1}.run(&expected, same_rng));
+
+        // Every level is its own tree
+        REQUIRE(count_passages(expected) == static_cast<size_t>(expected.num_cells()) - P_LEVELS);
+
+        for (auto threads : {2u, 3u, 7u, 0u})
+        {
+            flat_grid actual{P_ROWS, P_COLUMNS, P_LEVELS};
+            randomizer thread_rng{rng};
+            REQUIRE(binary_tree{threads}.run(&actual, thread_rng));
+            REQUIRE(expected.get_link_masks().data() == actual.get_link_masks().data());
+        }
+    }
+
+    SECTION(" Sidewinder ")
+    {
+        flat_grid expected{P_ROWS, P_COLUMNS, 1};
+        randomizer same_rng{rng};
+        REQUIRE(sidewinder{1}.run(&expected, same_rng));
+        REQUIRE(count_passages(expected) == static_cast<size_t>(expected.num_cells()) - 1);
+
+        for (auto threads : {2u, 3u, 7u, 0u})
+        {
+            flat_grid actual{P_ROWS, P_COLUMNS, 1};
+            randomizer thread_rng{rng};
+            REQUIRE(sidewinder{threads}.run(&actual, thread_rng));
+            REQUIRE(expected.get_link_masks().data() == actual.get_link_masks().data());
+        }
+    }
+
+    SECTION(" More threads than rows ")
+    {
+        flat_grid g{2, P_COLUMNS, 1};
+        REQUIRE(binary_tree{16}.run(&g, rng));
+        REQUIRE(count_passages(g) == static_cast<size_t>(g.num_cells()) - 1);
+    }
+
+    SECTION(" Row streams are reproducible and bounded ")
+    {
+        row_stream a{42, 1, 7}, b{42, 1, 7}, other_row{42, 1, 8};
+
+        bool differs{false};
+        for (auto i{0}; i < 1'000; ++i)
+        {
+            const auto value = a(-3, 5);
+            REQUIRE(value == b(-3, 5));
+            REQUIRE((value >= -3 && value <= 5));
+            const auto next = a.next();
+            REQUIRE(next == b.next());
+            differs = differs || next != other_row.next();
+        }
+        REQUIRE(differs);
+    }
+
+    SECTION(" A band that throws is rethrown after every band is done ")
+    {
+        for (auto thrower : {0u, 2u})
+        {
+            std::atomic<unsigned int> carved{0};
+
+            REQUIRE_THROWS_AS(for_each_row_band(P_ROWS, 4u, [&carved, thrower](unsigned int first, unsigned int last)
+                                                {
+                carved += last - first;
+                if (first == P_ROWS * thrower / 4u)
+                {
+                    throw std::runtime_error("band failed");
+                } }),
+                              std::runtime_error);
+
+            REQUIRE(carved == P_ROWS);
+        }
+    }
+}
+
+TEST_CASE("Eller's algorithm streams the maze it carves into a grid", "[ellers]")
+{
+    // A perfect maze is connected with one passage less than its cells
+    auto is_perfect_level = [](const grid_operations &ops, int first, int cells)
+    {
+        vector<bool> seen(static_cast<size_t>(cells), false);
+        vector<int> frontier{first};
+        seen[0] = true;
+        int reached{1}, passages{0};
+
+        while (!frontier.empty())
+        {
+            const auto index = frontier.back();
+            frontier.pop_back();
+
+            for (auto dir : {Direction::NORTH, Direction::SOUTH, Direction::EAST, Direction::WEST})
+            {
+                if (!ops.is_linked(index, dir))
+                {
+                    continue;
+                }
+
+                passages += (dir == Direction::SOUTH || dir == Direction::EAST) ? 1 : 0;
+
+                const auto n = ops.get_neighbor_index(index, dir);
+                if (!seen[static_cast<size_t>(n - first)])
+                {
+                    seen[static_cast<size_t>(n - first)] = true;
+                    ++reached;
+                    frontier.push_back(n);
+                }
+            }
+        }
+
+        return reached == cells && passages == cells - 1;
+    };
+
+    REQUIRE(to_algo_from_sv(to_sv_from_algo(algo::ELLERS)) == algo::ELLERS);
+
+    SECTION(" Every level is a perfect maze ")
+    {
+        for (auto [rows, columns, levels] : {std::tuple{1u, 1u, 1u}, std::tuple{1u, 17u, 1u}, std::tuple{23u, 1u, 1u}, std::tuple{31u, 29u, 1u}, std::tuple{6u, 5u, 3u}})
+        {
+            flat_grid g{rows, columns, levels};
+            randomizer rng;
+            REQUIRE(ellers{}.run(&g, rng));
+
+            const auto cells = static_cast<int>(rows * columns);
+            for (auto level{0u}; level < levels; ++level)
+            {
+                REQUIRE(is_perfect_level(g, static_cast<int>(level) * cells, cells));
+            }
+        }
+    }
+
+    SECTION(" Streamed rows render the same text as the grid ")
+    {
+        static constexpr auto S_ROWS = 41u, S_COLUMNS = 19u;
+
+        randomizer rng;
+        randomizer same_rng{rng};
+
+        flat_grid g{S_ROWS, S_COLUMNS, 1};
+        REQUIRE(ellers{}.run(&g, rng));
+        REQUIRE(stringify{}.run(&g, rng));
+
+        std::string streamed;
+        stringify::render_top_border(S_COLUMNS, streamed);
+        unsigned int expected_row{0};
+
+        REQUIRE(ellers{}.run(S_ROWS, S_COLUMNS, same_rng, [&streamed, &expected_row](unsigned int row, span<const uint8_t> links)
+                             {
+            REQUIRE(row == expected_row++);
+            REQUIRE(links.size() == S_COLUMNS);
+            stringify::render_row(links, streamed);
+            return true; }));
+
+        REQUIRE(streamed == g.get_str());
+    }
+
+    SECTION(" Tall mazes only hold one row ")
+    {
+        static constexpr auto TALL_ROWS = 200'000u, TALL_COLUMNS = 8u;
+
+        randomizer rng;
+        unsigned int rows_seen{0};
+        size_t passages{0};
+
+        REQUIRE(ellers{}.run(TALL_ROWS, TALL_COLUMNS, rng, [&rows_seen, &passages](unsigned int, span<const uint8_t> links)
+                             {
+            ++rows_seen;
+            for (auto mask : links)
+            {
+                passages += (mask & to_link_bit_from_direction(Direction::SOUTH)) ? 1 : 0;
+                passages += (mask & to_link_bit_from_direction(Direction::EAST)) ? 1 : 0;
+            }
+            return true; }));
+
+        REQUIRE(rows_seen == TALL_ROWS);
+        REQUIRE(passages == static_cast<size_t>(TALL_ROWS) * TALL_COLUMNS - 1);
+    }
+
+    SECTION(" The sink can stop generation ")
+    {
+        randomizer rng;
+        unsigned int rows_seen{0};
+
+        REQUIRE_FALSE(ellers{}.run(10, 10, rng, [&rows_seen](unsigned int row, span<const uint8_t>)
+                                   {
+            ++rows_seen;
+            return row < 3; }));
+        REQUIRE(rows_seen == 4);
+
+        REQUIRE_FALSE(ellers{}.run(0, 10, rng, [](unsigned int, span<const uint8_t>)
+                                   { return true; }));
+    }
+}
+
+// A flat grid whose first cell holds more than a cell's width of text
+class wide_contents_grid : public flat_grid
+{
+public:
+    using flat_grid::flat_grid;
+
+    std::string contents_at(int index) const noexcept override
+    {
+        return index == 0 ? "1234567" : flat_grid::contents_at(index);
+    }
+
+    bool has_contents() const noexcept override
+    {
+        return true;
+    }
+};
+
+TEST_CASE("Stringify writes and streams the same exact-size text", "[stringify]")
+{
+    static constexpr auto T_ROWS = 17u, T_COLUMNS = 13u;
+
+    // Top border plus two lines per row, each a corner or wall, 6 characters per cell, and a newline
+    static constexpr auto EXACT_SIZE = (T_COLUMNS * 6 + 2) * (2 * T_ROWS + 1);
+
+    randomizer rng;
+
+    SECTION(" Empty cells ")
+    {
+        flat_grid g{T_ROWS, T_COLUMNS, 2};
+        REQUIRE(dfs{}.run(&g, rng));
+        REQUIRE(stringify{}.run(&g, rng));
+        REQUIRE(g.get_str().size() == EXACT_SIZE);
+
+        ostringstream oss;
+        REQUIRE(stringify{}.run(&g, oss));
+        REQUIRE(oss.str() == g.get_str());
+    }
+
+    SECTION(" Distances in cells ")
+    {
+        distance_grid g{T_ROWS, T_COLUMNS, 1};
+        REQUIRE(binary_tree{}.run(&g, rng));
+        g.calculate_distances(0, -1);
+        REQUIRE(stringify{}.run(&g, rng));
+        REQUIRE(g.operations().get_str().size() == EXACT_SIZE);
+        REQUIRE(g.operations().get_str().find("    0 ") != std::string::npos);
+
+        ostringstream oss;
+        REQUIRE(stringify{}.run(&g, oss));
+        REQUIRE(oss.str() == g.operations().get_str());
+    }
+
+    SECTION(" Contents wider than a cell push the line over ")
+    {
+        wide_contents_grid g{T_ROWS, T_COLUMNS, 1};
+        REQUIRE(sidewinder{}.run(&g, rng));
+        REQUIRE(stringify{}.run(&g, rng));
+        REQUIRE(g.get_str().size() == EXACT_SIZE + 2);
+        REQUIRE(g.get_str().find("\n|1234567") != std::string::npos);
+
+        ostringstream oss;
+        REQUIRE(stringify{}.run(&g, oss));
+        REQUIRE(oss.str() == g.get_str());
+    }
+
+    SECTION(" Missing grid ")
+    {
+        ostringstream oss;
+        REQUIRE_FALSE(stringify{}.run(nullptr, rng));
+        REQUIRE_FALSE(stringify{}.run(nullptr, oss));
+    }
+}
+
+TEST_CASE("Banded stringify writes the same text as serial stringify", "[stringify][parallel rows]")
+{
+    static constexpr auto T_ROWS = 23u, T_COLUMNS = 11u;
+
+    randomizer rng;
+
+    auto require_same_text = [&rng](grid_interface &g)
+    {
+        REQUIRE(stringify{}.run(&g, rng));
+        const auto serial = g.operations().get_str();
+
+        for (auto threads : {0u, 1u, 2u, 3u, 7u, 64u})
+        {
+            REQUIRE(stringify{threads}.run(&g, rng));
+            REQUIRE(g.operations().get_str() == serial);
+        }
+    };
+
+    SECTION(" Empty cells ")
+    {
+        flat_grid g{T_ROWS, T_COLUMNS, 1};
+        REQUIRE(dfs{}.run(&g, rng));
+        require_same_text(g);
+    }
+
+    SECTION(" Distances in cells ")
+    {
+        distance_grid g{T_ROWS, T_COLUMNS, 1};
+        REQUIRE(sidewinder{}.run(&g, rng));
+        g.calculate_distances(0, -1);
+        require_same_text(g);
+    }
+
+    SECTION(" Contents wider than a cell fall back to serial rendering ")
+    {
+        wide_contents_grid g{T_ROWS, T_COLUMNS, 1};
+        REQUIRE(binary_tree{}.run(&g, rng));
+        require_same_text(g);
+        REQUIRE(g.get_str().find("\n|1234567") != std::string::npos);
+    }
+
+    SECTION(" A single row ")
+    {
+        flat_grid g{1, T_COLUMNS, 1};
+        REQUIRE(binary_tree{}.run(&g, rng));
+        require_same_text(g);
+    }
+}
+
+#if defined(MAZE_BENCHMARK)
+
+TEST_CASE("Benchmark map-backed grid against flat grid", "[flat grid][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 100, BENCH_COLUMNS = 100;
+
+    BENCHMARK("Construct map-backed grid")
+    {
+        return grid{BENCH_ROWS, BENCH_COLUMNS, 1}.num_cells();
+    };
+
+    BENCHMARK("Construct flat grid")
+    {
+        return flat_grid{BENCH_ROWS, BENCH_COLUMNS, 1}.num_cells();
+    };
+
+    grid map_backed{BENCH_ROWS, BENCH_COLUMNS, 1};
+    flat_grid flat{BENCH_ROWS, BENCH_COLUMNS, 1};
+
+    BENCHMARK("Search and walk east on map-backed grid")
+    {
+        int found{0};
+        for (auto i{0}; i < map_backed.num_cells(); ++i)
+        {
+            found += map_backed.get_east(map_backed.search(i)) ? 1 : 0;
+        }
+        return found;
+    };
+
+    BENCHMARK("Search and walk east on flat grid")
+    {
+        int found{0};
+        for (auto i{0}; i < flat.num_cells(); ++i)
+        {
+            found += flat.get_east(flat.search(i)) ? 1 : 0;
+        }
+        return found;
+    };
+
+    BENCHMARK("DFS on map-backed grid")
+    {
+        grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+        randomizer rng;
+        return dfs{}.run(&g, rng);
+    };
+
+    BENCHMARK("DFS on flat grid")
+    {
+        flat_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+        randomizer rng;
+        return dfs{}.run(&g, rng);
+    };
+}
+
+TEST_CASE("Benchmark DFS against the shared_ptr reference", "[dfs][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 1'000u, BENCH_COLUMNS = 1'000u;
+
+    randomizer rng;
+
+    BENCHMARK("Reference DFS on map-backed grid 1000x1000")
+    {
+        grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+        return reference_dfs(&g, rng);
+    };
+
+    BENCHMARK("DFS on flat grid 1000x1000")
+    {
+        flat_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+        return dfs{}.run(&g, rng);
+    };
+}
+
+TEST_CASE("Benchmark row-parallel binary tree", "[parallel rows][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 1'000u, BENCH_COLUMNS = 1'000u;
+
+    randomizer rng;
+
+    BENCHMARK("Serial binary tree 1000x1000")
+    {
+        flat_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+        return binary_tree{}.run(&g, rng);
+    };
+
+    BENCHMARK("Row-parallel binary tree 1000x1000")
+    {
+        flat_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+        return binary_tree{0}.run(&g, rng);
+    };
+
+    BENCHMARK("Row-parallel sidewinder 1000x1000")
+    {
+        flat_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+        return sidewinder{0}.run(&g, rng);
+    };
+}
+
+TEST_CASE("Benchmark stringify against a memset of its output", "[stringify][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 1'000u, BENCH_COLUMNS = 1'000u;
+
+    randomizer rng;
+    flat_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+    REQUIRE(binary_tree{}.run(&g, rng));
+    REQUIRE(stringify{}.run(&g, rng));
+
+    const auto output_size = g.get_str().size();
+
+    BENCHMARK("memset of 1000x1000 output")
+    {
+        std::string s(output_size, ' ');
+        return s.size();
+    };
+
+    BENCHMARK("Stringify 1000x1000")
+    {
+        return stringify{}.run(&g, rng);
+    };
+
+    BENCHMARK("Banded stringify 1000x1000")
+    {
+        return stringify{0}.run(&g, rng);
+    };
+
+    BENCHMARK("Stream stringify 1000x1000")
+    {
+        ostringstream oss;
+        return stringify{}.run(&g, oss);
+    };
+}
+
+#endif // MAZE_BENCHMARK
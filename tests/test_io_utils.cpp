@@ -1,15 +1,42 @@
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include <string>
+#include <limits>
 #include <memory>
+#include <set>
+#include <span>
+#include <tuple>
+#include <utility>
 #include <iosfwd>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
+#include <MazeBuilder/binary_tree.h>
 #include <MazeBuilder/enums.h>
+#include <MazeBuilder/flat_grid.h>
+#include <MazeBuilder/glb_writer.h>
+#include <MazeBuilder/grid_operations.h>
 #include <MazeBuilder/io_utils.h>
+#include <MazeBuilder/obj_writer.h>
+#include <MazeBuilder/objectify.h>
+#include <MazeBuilder/pixels.h>
+#include <MazeBuilder/ply_writer.h>
+#include <MazeBuilder/png_writer.h>
+#include <MazeBuilder/randomizer.h>
+#include <MazeBuilder/sidewinder.h>
+#include <MazeBuilder/stringify.h>
+#include <MazeBuilder/wavefront_object_helper.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
 
 using namespace std;
 using namespace mazes;
@@ -74,3 +101,624 @@ TEST_CASE("io_utils writes data to stdout successfully", "[io_utils to stdout]")
 
     REQUIRE(oss.str() == data + "\n");
 }
+
+TEST_CASE("pixels rasterizes walls from links and encodes images", "[pixels]")
+{
+    static constexpr auto T_ROWS = 9u, T_COLUMNS = 7u, CELL = 5u, WALL = 2u;
+
+    randomizer rng;
+    flat_grid g{T_ROWS, T_COLUMNS, 1};
+    REQUIRE(sidewinder{}.run(&g, rng));
+
+    pixels p{CELL, WALL};
+
+    const auto w = p.width(T_COLUMNS), h = p.height(T_ROWS);
+    REQUIRE(w == T_COLUMNS * (CELL + WALL) + WALL);
+    REQUIRE(h == T_ROWS * (CELL + WALL) + WALL);
+
+    vector<uint8_t> rgba;
+    REQUIRE(p.run(&g, rgba));
+    REQUIRE(rgba.size() == w * h * pixels::CHANNELS);
+
+    auto is_wall = [&rgba, w](uint64_t x, uint64_t y)
+    {
+        return 0 == memcmp(rgba.data() + (y * w + x) * pixels::CHANNELS, pixels::WALL_COLOR.data(), pixels::CHANNELS);
+    };
+
+    // Every pixel is a wall exactly where the links say so
+    const auto &masks = g.operations().get_link_masks();
+    for (auto r = 0u; r < T_ROWS; ++r)
+    {
+        for (auto c = 0u; c < T_COLUMNS; ++c)
+        {
+            const auto index = static_cast<int>(r * T_COLUMNS + c);
+            const auto x = c * (CELL + WALL) + WALL, y = r * (CELL + WALL) + WALL;
+
+            REQUIRE_FALSE(is_wall(x, y));
+            REQUIRE_FALSE(is_wall(x + CELL - 1, y + CELL - 1));
+            REQUIRE(is_wall(x + CELL, y) == !masks.is_linked(index, Direction::EAST));
+            REQUIRE(is_wall(x, y + CELL + WALL - 1) == !masks.is_linked(index, Direction::SOUTH));
+            REQUIRE(is_wall(x - 1, y - 1));
+            REQUIRE(is_wall(x + CELL, y + CELL));
+        }
+    }
+
+    SECTION(" Scanlines and the grid string hold the same pixels ")
+    {
+        vector<uint8_t> streamed;
+        REQUIRE(p.run(&g, [&streamed](span<const uint8_t> scanline)
+                      {
+            streamed.insert(streamed.end(), scanline.begin(), scanline.end());
+            return true; }));
+        REQUIRE(streamed == rgba);
+
+        REQUIRE(p.run(&g, rng));
+        const auto str = g.get_str();
+        REQUIRE(str.size() == rgba.size());
+        REQUIRE(0 == memcmp(str.data(), rgba.data(), rgba.size()));
+
+        auto lines = 0u;
+        REQUIRE_FALSE(p.run(&g, [&lines](span<const uint8_t>)
+                            { return ++lines < 3; }));
+        REQUIRE(lines == 3);
+    }
+
+    SECTION(" PNG and JPEG files are written byte for byte ")
+    {
+        io_utils writer;
+
+        const auto png = writer.encode_png(rgba, static_cast<unsigned int>(w), static_cast<unsigned int>(h), pixels::CHANNELS);
+        REQUIRE(png.compare(0, 8, "\x89PNG\r\n\x1a\n") == 0);
+
+        const auto jpeg = writer.encode_jpeg(rgba, static_cast<unsigned int>(w), static_cast<unsigned int>(h), pixels::CHANNELS);
+        REQUIRE(jpeg.compare(0, 2, "\xff\xd8") == 0);
+
+        const string filename = "test_pixels.png";
+        REQUIRE(writer.write_file(filename, png, true));
+
+        ifstream f{filename, ios::binary};
+        REQUIRE(f.is_open());
+        const string contents((istreambuf_iterator<char>(f)), istreambuf_iterator<char>());
+        REQUIRE(contents == png);
+
+        f.close();
+        remove(filename.c_str());
+    }
+
+    SECTION(" Missing grid ")
+    {
+        REQUIRE_FALSE(p.run(nullptr, rng));
+        REQUIRE_FALSE(p.run(nullptr, rgba));
+    }
+}
+
+TEST_CASE("png_writer streams bands that decode to the same pixels", "[png writer]")
+{
+    static constexpr auto T_ROWS = 13u, T_COLUMNS = 11u;
+
+    randomizer rng;
+    flat_grid g{T_ROWS, T_COLUMNS, 1};
+    REQUIRE(sidewinder{}.run(&g, rng));
+
+    const pixels p{4, 1};
+    const auto w = static_cast<unsigned int>(p.width(T_COLUMNS)), h = static_cast<unsigned int>(p.height(T_ROWS));
+
+    vector<uint8_t> rgba;
+    REQUIRE(p.run(&g, rgba));
+
+    auto decode = [](const string &png)
+    {
+        int dw = 0, dh = 0, channels = 0;
+        auto *decoded = stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(png.data()), static_cast<int>(png.size()), &dw, &dh, &channels, 4);
+        REQUIRE(decoded != nullptr);
+        vector<uint8_t> pixels_out(decoded, decoded + static_cast<size_t>(dw) * dh * 4);
+        stbi_image_free(decoded);
+        return pixels_out;
+    };
+
+    // Thread counts and band heights change how the stream is split, never the image
+    for (auto [threads, band_rows] : {pair{1u, 0u}, pair{2u, 1u}, pair{3u, 7u}, pair{4u, 1000u}, pair{0u, 2u}})
+    {
+        ostringstream oss;
+        png_writer writer{oss, w, h, pixels::CHANNELS, threads, band_rows};
+        REQUIRE(writer.good());
+        REQUIRE(p.run(&g, [&writer](span<const uint8_t> scanline)
+                      { return writer.write_row(scanline); }));
+        REQUIRE(writer.finish());
+        REQUIRE(decode(oss.str()) == rgba);
+    }
+
+    SECTION(" Rows written together ")
+    {
+        ostringstream oss;
+        png_writer writer{oss, w, h, pixels::CHANNELS, 2, 3};
+        const auto half = (h / 2) * w * pixels::CHANNELS;
+        REQUIRE(writer.write_rows(span<const uint8_t>{rgba}.first(half)));
+        REQUIRE(writer.write_rows(span<const uint8_t>{rgba}.subspan(half)));
+        REQUIRE(writer.finish());
+        REQUIRE(decode(oss.str()) == rgba);
+    }
+
+    SECTION(" Misuse fails instead of writing a broken image ")
+    {
+        ostringstream missing_rows;
+        png_writer short_writer{missing_rows, w, h};
+        REQUIRE(short_writer.write_row(span<const uint8_t>{rgba}.first(w * pixels::CHANNELS)));
+        REQUIRE_FALSE(short_writer.finish());
+
+        ostringstream wrong_size;
+        png_writer narrow_writer{wrong_size, w, h};
+        REQUIRE_FALSE(narrow_writer.write_row(span<const uint8_t>{rgba}.first(w)));
+        REQUIRE_FALSE(narrow_writer.good());
+
+        ostringstream too_many;
+        png_writer one_row{too_many, w, 1};
+        REQUIRE_FALSE(one_row.write_rows(span<const uint8_t>{rgba}.first(2 * w * pixels::CHANNELS)));
+
+        ostringstream empty;
+        REQUIRE_FALSE(png_writer{empty, 0, h}.good());
+        REQUIRE_FALSE(png_writer{empty, w, h, 5}.good());
+    }
+}
+
+TEST_CASE("objectify builds a merged wall mesh from links", "[objectify]")
+{
+    static constexpr auto T_ROWS = 9u, T_COLUMNS = 7u;
+
+    randomizer rng;
+    flat_grid g{T_ROWS, T_COLUMNS, 2};
+    REQUIRE(sidewinder{}.run(&g, rng));
+
+    // Both levels get the same walls, so their stack is one block as tall as the levels
+    auto &masks = g.operations().get_link_masks();
+    for (auto i = 0; i < static_cast<int>(T_ROWS * T_COLUMNS); ++i)
+    {
+        masks.set(i + static_cast<int>(T_ROWS * T_COLUMNS), masks.get(i));
+    }
+
+    // The walls of level 0 as unit blocks on the text lattice
+    REQUIRE(stringify{}.run(&g, rng));
+    vector<string> lines;
+    istringstream text{g.operations().get_str()};
+    for (string line; getline(text, line);)
+    {
+        lines.push_back(line);
+    }
+
+    auto is_wall = [&lines](int x, int y)
+    {
+        if (x < 0 || y < 0 || x >= static_cast<int>(lines.size()) || y >= static_cast<int>(lines[static_cast<size_t>(x)].size()))
+        {
+            return false;
+        }
+
+        const auto ch = lines[static_cast<size_t>(x)][static_cast<size_t>(y)];
+        return ch == static_cast<char>(barriers::CORNER) || ch == static_cast<char>(barriers::HORIZONTAL) || ch == static_cast<char>(barriers::VERTICAL);
+    };
+
+    int64_t walls{0}, exposed{0};
+    for (auto x = 0; x < static_cast<int>(lines.size()); ++x)
+    {
+        for (auto y = 0; y < static_cast<int>(lines[static_cast<size_t>(x)].size()); ++y)
+        {
+            if (is_wall(x, y))
+            {
+                ++walls;
+                exposed += !is_wall(x - 1, y) + !is_wall(x + 1, y) + !is_wall(x, y - 1) + !is_wall(x, y + 1);
+            }
+        }
+    }
+
+    REQUIRE(objectify{}.run(&g, rng));
+
+    const auto &m = g.operations().get_mesh();
+    const auto positions = m.positions();
+    const auto indices = m.indices();
+    REQUIRE_FALSE(m.empty());
+    REQUIRE(positions.size() == m.vertex_count() * 3);
+    REQUIRE(indices.size() == m.triangle_count() * 3);
+
+    // Each lattice point appears once
+    set<tuple<int32_t, int32_t, int32_t>> points;
+    for (size_t i = 0; i < positions.size(); i += 3)
+    {
+        points.emplace(positions[i], positions[i + 1], positions[i + 2]);
+    }
+    REQUIRE(points.size() == m.vertex_count());
+
+    // Twice the enclosed volume and twice the surface area, faces wind outward
+    int64_t volume6{0}, area2{0};
+    for (size_t t = 0; t < indices.size(); t += 3)
+    {
+        array<array<int64_t, 3>, 3> p{};
+        for (auto k = 0u; k < 3; ++k)
+        {
+            const auto v = indices[t + k];
+            REQUIRE(v < m.vertex_count());
+
+            p[k] = {positions[v * 3], positions[v * 3 + 1], positions[v * 3 + 2]};
+        }
+
+        auto cross = [](const array<int64_t, 3> &a, const array<int64_t, 3> &b)
+        {
+            return array<int64_t, 3>{a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+        };
+
+        const auto n = cross(p[1], p[2]);
+        volume6 += p[0][0] * n[0] + p[0][1] * n[1] + p[0][2] * n[2];
+
+        const auto e = cross({p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]}, {p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2]});
+        area2 += std::abs(e[0]) + std::abs(e[1]) + std::abs(e[2]);
+    }
+
+    static constexpr int64_t LEVELS = 2;
+    REQUIRE(volume6 == 6 * walls * LEVELS);
+    REQUIRE(area2 == 2 * (exposed * LEVELS + 2 * walls));
+
+    // A cube per wall block had 8 vertices and 12 triangles
+    REQUIRE(m.vertex_count() * 10 < static_cast<size_t>(walls * LEVELS * 8));
+    REQUIRE(m.triangle_count() * 10 < static_cast<size_t>(walls * LEVELS * 12));
+
+    SECTION(" The mesh is written as OBJ and can be moved out ")
+    {
+        const auto vertex_count = m.vertex_count(), triangle_count = m.triangle_count();
+
+        REQUIRE(wavefront_object_helper{}.run(&g, rng));
+        const auto obj = g.operations().get_str();
+
+        istringstream lines{obj};
+        size_t v_lines{0}, f_lines{0};
+        for (string line; getline(lines, line);)
+        {
+            v_lines += line.starts_with("v ");
+            f_lines += line.starts_with("f ");
+        }
+        REQUIRE(v_lines == vertex_count);
+        REQUIRE(f_lines == triangle_count);
+        REQUIRE(obj.find(" 0 ", obj.find("\nf ")) == string::npos);
+
+        auto taken = std::move(g.operations().get_mesh());
+        REQUIRE(taken.vertex_count() == vertex_count);
+        REQUIRE(g.operations().get_mesh().empty());
+
+        const auto released = taken.release_indices();
+        REQUIRE(released.size() == triangle_count * 3);
+        REQUIRE(taken.empty());
+    }
+
+    SECTION(" Missing grid ")
+    {
+        REQUIRE_FALSE(objectify{}.run(nullptr, rng));
+    }
+}
+
+TEST_CASE("obj_writer writes chunks formatted in parallel in order", "[obj writer]")
+{
+    static constexpr auto T_ROWS = 20u, T_COLUMNS = 15u;
+
+    randomizer rng;
+    flat_grid g{T_ROWS, T_COLUMNS, 1};
+    REQUIRE(sidewinder{}.run(&g, rng));
+    REQUIRE(objectify{}.run(&g, rng));
+
+    const auto &m = g.operations().get_mesh();
+
+    ostringstream serial;
+    REQUIRE(obj_writer{serial}.write(m));
+
+    // Every line reads back as the mesh, indices start at 1
+    istringstream lines{serial.str()};
+    vector<int32_t> positions;
+    vector<uint32_t> indices;
+    for (string line; getline(lines, line);)
+    {
+        istringstream fields{line.substr(1)};
+
+        if (line.starts_with("v "))
+        {
+            int32_t x{}, y{}, z{};
+            REQUIRE(fields >> x >> y >> z);
+            positions.insert(positions.end(), {x, y, z});
+        }
+        else if (line.starts_with("f "))
+        {
+            uint32_t a{}, b{}, c{};
+            REQUIRE(fields >> a >> b >> c);
+            indices.insert(indices.end(), {a - 1, b - 1, c - 1});
+        }
+        else
+        {
+            REQUIRE(line.starts_with("#"));
+        }
+    }
+    REQUIRE(std::equal(positions.cbegin(), positions.cend(), m.positions().begin(), m.positions().end()));
+    REQUIRE(std::equal(indices.cbegin(), indices.cend(), m.indices().begin(), m.indices().end()));
+
+    SECTION(" Any thread count and chunk size writes the same text ")
+    {
+        for (auto [threads, chunk] : {pair{3u, size_t{7}}, pair{0u, size_t{1}}, pair{2u, size_t{100000}}})
+        {
+            ostringstream banded;
+            REQUIRE(obj_writer{banded, threads, chunk}.write(m));
+            REQUIRE(banded.str() == serial.str());
+        }
+
+        REQUIRE(wavefront_object_helper{}.run(&g, rng));
+        REQUIRE(g.operations().get_str() == serial.str());
+    }
+
+    SECTION(" Extreme values are written exactly ")
+    {
+        mesh extremes;
+        extremes.add_vertex(numeric_limits<int32_t>::min(), numeric_limits<int32_t>::max(), 0);
+        extremes.add_triangle(0, 0, numeric_limits<uint32_t>::max() - 1);
+
+        ostringstream out;
+        REQUIRE(obj_writer{out}.write(extremes));
+        REQUIRE(out.str().find("\nv -2147483648 2147483647 0\nf 1 1 4294967295\n") != string::npos);
+    }
+}
+
+TEST_CASE("Binary mesh writers lay out the mesh buffers", "[mesh formats]")
+{
+    static constexpr auto T_ROWS = 11u, T_COLUMNS = 8u;
+
+    randomizer rng;
+    flat_grid g{T_ROWS, T_COLUMNS, 2};
+    REQUIRE(sidewinder{}.run(&g, rng));
+    REQUIRE(objectify{}.run(&g, rng));
+
+    const auto &m = g.operations().get_mesh();
+    const auto positions = m.positions();
+    const auto indices = m.indices();
+
+    auto u32_at = [](const string &bytes, size_t offset)
+    {
+        uint32_t value{};
+        for (auto k = 0u; k < 4; ++k)
+        {
+            value |= static_cast<uint32_t>(static_cast<uint8_t>(bytes[offset + k])) << (8 * k);
+        }
+        return value;
+    };
+
+    REQUIRE(to_output_format_from_sv("glb") == output_format::GLB);
+    REQUIRE(to_output_format_from_sv("ply") == output_format::PLY);
+    REQUIRE(to_sv_from_output_format(output_format::GLB) == "glb");
+    REQUIRE(to_sv_from_output_format(output_format::PLY) == "ply");
+
+    SECTION(" GLB holds a JSON chunk, then float positions and the indices ")
+    {
+        ostringstream out;
+        REQUIRE(glb_writer{out}.write(m));
+        const auto glb = out.str();
+
+        REQUIRE(u32_at(glb, 0) == 0x46546C67u);
+        REQUIRE(u32_at(glb, 4) == 2u);
+        REQUIRE(u32_at(glb, 8) == glb.size());
+
+        const auto json_length = u32_at(glb, 12);
+        REQUIRE(json_length % 4 == 0);
+        REQUIRE(u32_at(glb, 16) == 0x4E4F534Au);
+
+        const auto json = glb.substr(20, json_length);
+        REQUIRE(json.find("\"count\":" + to_string(m.vertex_count()) + ",\"type\":\"VEC3\"") != string::npos);
+        REQUIRE(json.find("\"count\":" + to_string(indices.size()) + ",\"type\":\"SCALAR\"") != string::npos);
+        REQUIRE(json.find("\"min\":[0,0,0]") != string::npos);
+        REQUIRE(json.find("\"max\":[" + to_string(T_COLUMNS * 6 + 1) + ",2," + to_string(T_ROWS * 2 + 1) + "]") != string::npos);
+
+        const auto bin = 20 + json_length;
+        REQUIRE(u32_at(glb, bin) == (positions.size() + indices.size()) * 4);
+        REQUIRE(u32_at(glb, bin + 4) == 0x004E4942u);
+        REQUIRE(bin % 4 == 0);
+
+        // Columns, levels, rows
+        for (size_t v = 0; v < m.vertex_count(); ++v)
+        {
+            for (auto k = 0u; k < 3; ++k)
+            {
+                float f{};
+                const auto word = u32_at(glb, bin + 8 + (v * 3 + k) * 4);
+                memcpy(&f, &word, sizeof(f));
+                REQUIRE(f == static_cast<float>(positions[v * 3 + (k + 1) % 3]));
+            }
+        }
+
+        const auto first_index = bin + 8 + positions.size() * 4;
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            REQUIRE(u32_at(glb, first_index + i * 4) == indices[i]);
+        }
+        REQUIRE(first_index + indices.size() * 4 == glb.size());
+
+        ostringstream empty;
+        REQUIRE(glb_writer{empty}.write(mesh{}));
+        REQUIRE(u32_at(empty.str(), 8) == empty.str().size());
+    }
+
+    SECTION(" PLY holds int vertices and uchar-counted faces ")
+    {
+        ostringstream out;
+        REQUIRE(ply_writer{out}.write(m));
+        const auto ply = out.str();
+
+        const string end_header{"end_header\n"};
+        const auto body = ply.find(end_header) + end_header.size();
+        REQUIRE(ply.starts_with("ply\nformat binary_little_endian 1.0\n"));
+        REQUIRE(ply.find("element vertex " + to_string(m.vertex_count()) + "\n") < body);
+        REQUIRE(ply.find("element face " + to_string(m.triangle_count()) + "\n") < body);
+
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            REQUIRE(static_cast<int32_t>(u32_at(ply, body + i * 4)) == positions[i]);
+        }
+
+        const auto faces = body + positions.size() * 4;
+        for (size_t t = 0; t < m.triangle_count(); ++t)
+        {
+            const auto record = faces + t * 13;
+            REQUIRE(ply[record] == 3);
+            for (auto k = 0u; k < 3; ++k)
+            {
+                REQUIRE(u32_at(ply, record + 1 + k * 4) == indices[t * 3 + k]);
+            }
+        }
+        REQUIRE(faces + m.triangle_count() * 13 == ply.size());
+    }
+}
+
+#if defined(MAZE_BENCHMARK)
+
+TEST_CASE("Benchmark pixels thumbnails", "[pixels][benchmark]")
+{
+    static constexpr auto THUMB_ROWS = 32u, THUMB_COLUMNS = 32u;
+
+    randomizer rng;
+    flat_grid g{THUMB_ROWS, THUMB_COLUMNS, 1};
+    REQUIRE(binary_tree{}.run(&g, rng));
+
+    pixels p{3, 1};
+    io_utils writer;
+    vector<uint8_t> rgba;
+
+    BENCHMARK("Rasterize 32x32 thumbnail")
+    {
+        return p.run(&g, rgba);
+    };
+
+    BENCHMARK("Rasterize and encode 32x32 thumbnail as PNG")
+    {
+        p.run(&g, rgba);
+        return writer.encode_png(rgba, static_cast<unsigned int>(p.width(THUMB_COLUMNS)), static_cast<unsigned int>(p.height(THUMB_ROWS)), pixels::CHANNELS).size();
+    };
+
+    BENCHMARK("Stream 32x32 thumbnail through png_writer")
+    {
+        ostringstream oss;
+        png_writer streamed{oss, static_cast<unsigned int>(p.width(THUMB_COLUMNS)), static_cast<unsigned int>(p.height(THUMB_ROWS))};
+        p.run(&g, [&streamed](span<const uint8_t> scanline)
+              { return streamed.write_row(scanline); });
+        return streamed.finish();
+    };
+}
+
+TEST_CASE("Benchmark streaming PNG against a whole-image encode", "[png writer][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 200u, BENCH_COLUMNS = 200u;
+
+    randomizer rng;
+    flat_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+    REQUIRE(binary_tree{}.run(&g, rng));
+
+    const pixels p{6, 2};
+    const auto w = static_cast<unsigned int>(p.width(BENCH_COLUMNS)), h = static_cast<unsigned int>(p.height(BENCH_ROWS));
+
+    BENCHMARK("Rasterize and encode 200x200 maze with stb")
+    {
+        vector<uint8_t> rgba;
+        p.run(&g, rgba);
+        return io_utils{}.encode_png(rgba, w, h, pixels::CHANNELS).size();
+    };
+
+    BENCHMARK("Rasterize and stream 200x200 maze with png_writer")
+    {
+        ostringstream oss;
+        png_writer writer{oss, w, h, pixels::CHANNELS, 0};
+        p.run(&g, [&writer](span<const uint8_t> scanline)
+              { return writer.write_row(scanline); });
+        return writer.finish();
+    };
+}
+
+TEST_CASE("Benchmark objectify on a large maze", "[objectify][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 300u, BENCH_COLUMNS = 300u;
+
+    randomizer rng;
+    flat_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+    REQUIRE(sidewinder{}.run(&g, rng));
+
+    BENCHMARK("objectify 300x300")
+    {
+        return objectify{}.run(&g, rng);
+    };
+
+    WARN("Vertices: " << g.operations().get_mesh().vertex_count() << ", triangles: " << g.operations().get_mesh().triangle_count());
+}
+
+TEST_CASE("Benchmark obj_writer against stream formatting", "[obj writer][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 300u, BENCH_COLUMNS = 300u;
+
+    randomizer rng;
+    flat_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+    REQUIRE(sidewinder{}.run(&g, rng));
+    REQUIRE(objectify{}.run(&g, rng));
+
+    const auto &m = g.operations().get_mesh();
+
+    BENCHMARK("ostringstream v and f lines")
+    {
+        ostringstream out;
+        const auto positions = m.positions();
+        const auto indices = m.indices();
+        for (size_t i = 0; i < positions.size(); i += 3)
+        {
+            out << "v " << static_cast<float>(positions[i]) << " " << static_cast<float>(positions[i + 1]) << " " << static_cast<float>(positions[i + 2]) << "\n";
+        }
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            out << "f " << indices[i] + 1 << " " << indices[i + 1] + 1 << " " << indices[i + 2] + 1 << "\n";
+        }
+        return out.tellp();
+    };
+
+    BENCHMARK("obj_writer, 1 thread")
+    {
+        ostringstream out;
+        obj_writer{out}.write(m);
+        return out.tellp();
+    };
+
+    BENCHMARK("obj_writer, all threads")
+    {
+        ostringstream out;
+        obj_writer{out, 0}.write(m);
+        return out.tellp();
+    };
+}
+
+TEST_CASE("Benchmark binary mesh writers", "[mesh formats][benchmark]")
+{
+    static constexpr auto BENCH_ROWS = 300u, BENCH_COLUMNS = 300u;
+
+    randomizer rng;
+    flat_grid g{BENCH_ROWS, BENCH_COLUMNS, 1};
+    REQUIRE(sidewinder{}.run(&g, rng));
+    REQUIRE(objectify{}.run(&g, rng));
+
+    const auto &m = g.operations().get_mesh();
+
+    BENCHMARK("obj_writer 300x300 mesh")
+    {
+        ostringstream out;
+        obj_writer{out}.write(m);
+        return out.tellp();
+    };
+
+    BENCHMARK("glb_writer 300x300 mesh")
+    {
+        ostringstream out;
+        glb_writer{out}.write(m);
+        return out.tellp();
+    };
+
+    BENCHMARK("ply_writer 300x300 mesh")
+    {
+        ostringstream out;
+        ply_writer{out}.write(m);
+        return out.tellp();
+    };
+}
+
+#endif // MAZE_BENCHMARK
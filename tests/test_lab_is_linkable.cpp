@@ -1,6 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <MazeBuilder/cell.h>
+#include <MazeBuilder/grid.h>
 #include <MazeBuilder/lab.h>
 
 using namespace mazes;
@@ -147,3 +148,61 @@ TEST_CASE("Lab can link/unlink cells", "[links]")
         REQUIRE_FALSE(cell2->is_linked(cell1));
     }
 }
+
+TEST_CASE("Lab can link/unlink cells by index", "[links]")
+{
+    grid g{3, 3, 2};
+
+    SECTION("Index links are stored in the grid's masks")
+    {
+        REQUIRE(lab::link(g, 0, Direction::EAST));
+
+        REQUIRE(lab::is_linked(g, 0, Direction::EAST));
+        REQUIRE(lab::is_linked(g, 1, Direction::WEST));
+        REQUIRE(g.get_link_masks().get(0) == to_link_bit_from_direction(Direction::EAST));
+        REQUIRE(g.search(0)->is_linked(g.search(1)));
+        REQUIRE(g.search(1)->is_linked(g.search(0)));
+
+        REQUIRE(lab::unlink(g, 1, Direction::WEST));
+        REQUIRE_FALSE(lab::is_linked(g, 0, Direction::EAST));
+        REQUIRE_FALSE(g.search(0)->is_linked(g.search(1)));
+    }
+
+    SECTION("Cell links are visible by index")
+    {
+        lab::link(g.search(4), g.search(7), false);
+
+        REQUIRE(lab::is_linked(g, 4, Direction::SOUTH));
+        REQUIRE_FALSE(lab::is_linked(g, 7, Direction::NORTH));
+    }
+
+    SECTION("Levels link up and down")
+    {
+        REQUIRE(lab::link(g, 4, Direction::UP));
+
+        REQUIRE(lab::is_linked(g, 13, Direction::DOWN));
+        REQUIRE(g.get_neighbor(g.search(4), Direction::UP)->get_index() == 13);
+        REQUIRE(g.search(13)->is_linked(g.search(4)));
+    }
+
+    SECTION("Links off the edge of the grid are rejected")
+    {
+        REQUIRE_FALSE(lab::link(g, 0, Direction::NORTH));
+        REQUIRE_FALSE(lab::link(g, 0, Direction::DOWN));
+        REQUIRE_FALSE(lab::link(g, -1, Direction::EAST));
+        REQUIRE_FALSE(lab::link(g, g.num_cells(), Direction::EAST));
+        REQUIRE(g.get_link_masks().get(0) == 0);
+    }
+
+    SECTION("Copies own their links")
+    {
+        lab::link(g, 0, Direction::SOUTH);
+
+        grid copy{g};
+        lab::link(copy, 0, Direction::EAST);
+
+        REQUIRE(copy.search(0)->is_linked(copy.search(3)));
+        REQUIRE(copy.search(0)->is_linked(copy.search(1)));
+        REQUIRE_FALSE(g.search(0)->is_linked(g.search(1)));
+    }
+}